@@ -12,6 +12,8 @@
 #include "app/flight_mode.h"
 #include "services/sensor_profile.h"
 #include "drivers/buzzer.h"
+#include "services/loop_watchdog.h"
+#include "services/hil_link.h"
 
 // === Offset persistente ===
 #include "config/device_config.h"
@@ -47,6 +49,9 @@ static DisplayMgr         gDisp;
 static BleManager         gBle;
 static SensorProfile      gProf;
 static Buzzer             gBuzz;
+static LoopWatchdog       gLwd;
+static HilLink            gHil;     // muestras inyectadas por USB-CDC
+RTC_NOINIT_ATTR static LoopWatchdog::Ring gLwdRing;   // post-mortem (sobrevive a reset)
 
 // === Config + marco de presentación con offset ===
 static DeviceConfig       gCfg;
@@ -161,6 +166,7 @@ static void handleButton(BtnEvent ev, uint32_t now) {
 
 // Decide si usar light sleep (para el *sleep de bucle*, no para esperas cortas del sensor)
 static inline bool canSleepLight() {
+  if (gHil.active()) return false; // HIL: no perder bytes del USB-CDC
 #ifdef ENABLE_DISPLAY
   if (gDisp.isOn()) return false; // pantalla encendida ⇒ no dormir
 #endif
@@ -173,6 +179,7 @@ static inline bool canSleepLight() {
 void setup() {
   Serial.begin(115200);
   delay(300);
+  gLwd.begin(&gLwdRing);
 
   Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL, I2C_HZ);
 
@@ -242,17 +249,33 @@ void setup() {
 
 void loop() {
   const uint32_t now = millis();
+  gLwd.setMode(gMode);
+  gLwd.loopBegin();
 
-  // 1) Botón en activo
-  if (BtnEvent ev = gBtn.poll(now); ev != BtnEvent::None) handleButton(ev, now);
+  // 1) Botón en activo (los pitidos del Buzzer usan delay())
+  if (BtnEvent ev = gBtn.poll(now); ev != BtnEvent::None) {
+    LoopWatchdog::Section sec(gLwd, "button");
+    handleButton(ev, now);
+  }
 
-  // 2) Lectura baro
+  // 2) Lectura baro (o muestra HIL del host)
   float p=NAN, t=NAN;
-  if (gNormalStreaming) {
+  bool hilIdle = false;
+  if (gHil.active()) {
+    float refPa;
+    if (gHil.takeReference(refPa)) {
+      gAlt.setSeaLevelPressure(refPa);
+      gAgz.begin(refPa);
+      gFsm.begin(0.0f);
+    }
+    hilIdle = !gHil.takeSample(p, t);   // sin muestra nueva: no es fallo
+  } else if (gNormalStreaming) {
     gBmp.read(p, t);
   } else {
     gBmp.triggerForcedMeasurement();
+    gLwd.loopPause();                 // espera de conversión: dormido, no bloqueo
     sleep_ms_lp(FORCED_WAIT_MS, /*force=*/true);
+    gLwd.loopResume();
     gBmp.read(p, t);
   }
 
@@ -293,6 +316,7 @@ void loop() {
     gDisp.setBleIndicator(gBle.active());
 
     if (gDisp.isOn()) {
+      LoopWatchdog::Section sec(gLwd, "display");
       // Display espera METROS; él convierte a ft internamente
       gDisp.showAltitude(indicated_m,
         (gMode==FlightMode::FREEFALL?"FREEFALL": gMode==FlightMode::CLIMB?"CLIMB":
@@ -300,13 +324,15 @@ void loop() {
     }
 #endif
 
-    // Serial: indicado + raw en ft para depurar
+    // Serial: indicado + raw en ft para depurar (USB-CDC puede bloquear)
+    LoopWatchdog::Section sec(gLwd, "serial");
     Serial.printf("%d | %.1f | %.1f | %.2f | %.2f\n",
       (int)gMode,
       indicated_ft,
       agl_raw_m * M2FT,
       p, t);
-  } else {
+    gHil.onFrameSent();   // HIL: muestra ya presentada (pantalla o Serial)
+  } else if (!hilIdle) {
     Serial.printf("Read FAIL (err=%d)\n", gBmp.lastError());
 #ifdef ENABLE_DISPLAY
     if (gDisp.isOn()) gDisp.showStatus("SENSOR","READ FAIL");
@@ -318,13 +344,30 @@ void loop() {
   gDisp.tick(now);
 #endif
   gBle.tick(now, /*must_off*/ gMode != FlightMode::GROUND);
+  gHil.tick(now);
+
+  // Tramas HIL + watchdog: 'w' volcar ring, 'W' borrar
+  while (Serial.available() > 0) {
+    const int c = Serial.read();
+    if (c < 0) break;
+    if (gHil.feed((uint8_t)c)) continue;
+    if (c == 'w') gLwd.dump();
+    else if (c == 'W') gLwd.clear();
+  }
 
   // 4) Espera del bucle (sin delay)
-  Serial.flush();
+  {
+    LoopWatchdog::Section sec(gLwd, "flush");
+    Serial.flush();
+  }
+  gLwd.loopEnd();
   if (canSleepLight()) {
     // Espera de bucle + wake por botón (no bloqueante)
     BtnEvent wakeEv = gBtn.lightSleepWaitAndClassify((uint64_t)gLoopPeriodMs * 1000ULL);
-    if (wakeEv != BtnEvent::None) handleButton(wakeEv, millis());
+    if (wakeEv != BtnEvent::None) {
+      LoopWatchdog::Section sec(gLwd, "button");
+      handleButton(wakeEv, millis());
+    }
   } else {
     // Sin dormir: seguimos inmediatamente
   }
@@ -0,0 +1,152 @@
+#include "services/hil_link.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <string.h>
+
+namespace {
+constexpr uint8_t SYNC0 = 0xA5;
+constexpr uint8_t SYNC1 = 0x5A;
+constexpr uint8_t T_ENTER = 0x01, T_EXIT = 0x02, T_SAMPLE = 0x03, T_PING = 0x04;
+constexpr uint8_t T_ACK = 0x81, T_LAT = 0x83, T_PONG = 0x84;
+
+uint16_t crc16(const uint8_t* d, size_t n, uint16_t crc = 0xFFFF) {
+  while (n--) {
+    crc ^= (uint16_t)(*d++) << 8;
+    for (uint8_t i = 0; i < 8; ++i) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+} // namespace
+
+void HilLink::sendFrame_(uint8_t type, const void* payload, uint8_t len) {
+  uint8_t buf[4 + MAX_PAYLOAD + 2];
+  buf[0] = SYNC0; buf[1] = SYNC1; buf[2] = type; buf[3] = len;
+  if (len) memcpy(&buf[4], payload, len);
+  const uint16_t crc = crc16(&buf[2], (size_t)len + 2);
+  buf[4 + len] = (uint8_t)(crc & 0xFF);
+  buf[5 + len] = (uint8_t)(crc >> 8);
+  Serial.write(buf, (size_t)len + 6);
+}
+
+void HilLink::enter_() {
+  _active = true; _fresh = false; _latPending = false;
+  _superseded = 0; _underrun = 0;
+  Serial.println("[HIL] ON");
+}
+
+void HilLink::exit_(const char* why) {
+  _active = false; _fresh = false; _latPending = false; _refPending = false;
+  Serial.printf("[HIL] OFF (%s)\n", why);
+}
+
+void HilLink::handleFrame_() {
+  _lastRxMs = millis();
+  uint8_t ack[2] = { _type, 0 };
+
+  switch (_type) {
+    case T_ENTER:
+      if (_len >= 4) { memcpy(&_refPa, &_payload[0], 4); _refPending = true; }
+      enter_();
+      sendFrame_(T_ACK, ack, sizeof(ack));
+      break;
+
+    case T_EXIT:
+      exit_("host");
+      sendFrame_(T_ACK, ack, sizeof(ack));
+      break;
+
+    case T_SAMPLE:
+      if (!_active || _len < 14) { ack[1] = 1; sendFrame_(T_ACK, ack, sizeof(ack)); break; }
+      if (_fresh) _superseded++;
+      memcpy(&_seq,    &_payload[0],  2);
+      memcpy(&_presPa, &_payload[6],  4);
+      memcpy(&_tempC,  &_payload[10], 4);
+      _rxUs  = esp_timer_get_time();
+      _fresh = true;
+      break;
+
+    case T_PING: {
+      uint8_t p[8] {};
+      if (_len >= 4) memcpy(&p[0], &_payload[0], 4);
+      const uint32_t devUs = (uint32_t)esp_timer_get_time();
+      memcpy(&p[4], &devUs, 4);
+      sendFrame_(T_PONG, p, sizeof(p));
+      break;
+    }
+
+    default:
+      ack[1] = 2;
+      sendFrame_(T_ACK, ack, sizeof(ack));
+      break;
+  }
+}
+
+bool HilLink::feed(uint8_t b) {
+  switch (_ps) {
+    case Ps::Sync0:
+      if (b != SYNC0) return false;
+      _ps = Ps::Sync1; return true;
+    case Ps::Sync1:
+      if (b != SYNC1) { _ps = Ps::Sync0; return false; }
+      _ps = Ps::Type; return true;
+    case Ps::Type:
+      _type = b; _ps = Ps::Len; return true;
+    case Ps::Len:
+      if (b > MAX_PAYLOAD) { _ps = Ps::Sync0; return true; }
+      _len = b; _pos = 0;
+      _ps = _len ? Ps::Payload : Ps::Crc0;
+      return true;
+    case Ps::Payload:
+      _payload[_pos++] = b;
+      if (_pos >= _len) _ps = Ps::Crc0;
+      return true;
+    case Ps::Crc0:
+      _crcRx = b; _ps = Ps::Crc1; return true;
+    case Ps::Crc1: {
+      _crcRx |= (uint16_t)b << 8;
+      _ps = Ps::Sync0;
+      const uint8_t hdr[2] = { _type, _len };
+      if (crc16(_payload, _len, crc16(hdr, 2)) == _crcRx) handleFrame_();
+      return true;
+    }
+  }
+  _ps = Ps::Sync0;
+  return false;
+}
+
+void HilLink::tick(uint32_t now_ms, uint32_t timeout_ms) {
+  if (_active && (now_ms - _lastRxMs) >= timeout_ms) exit_("timeout");
+}
+
+bool HilLink::takeSample(float& pressurePa, float& tempC) {
+  if (!_active) return false;
+  if (!_fresh) { _underrun++; return false; }
+  pressurePa = _presPa;
+  tempC      = _tempC;
+  _fresh     = false;
+  _latPending = true;
+  _latSeq     = _seq;
+  _latRxUs    = _rxUs;
+  _latUseUs   = (uint32_t)(esp_timer_get_time() - _rxUs);
+  return true;
+}
+
+bool HilLink::takeReference(float& refPa) {
+  if (!_refPending) return false;
+  _refPending = false;
+  refPa = _refPa;
+  return true;
+}
+
+void HilLink::onFrameSent() {
+  if (!_active || !_latPending) return;
+  _latPending = false;
+  const uint32_t frameUs = (uint32_t)(esp_timer_get_time() - _latRxUs);
+  uint8_t p[14];
+  memcpy(&p[0],  &_latSeq,     2);
+  memcpy(&p[2],  &_latUseUs,   4);
+  memcpy(&p[6],  &frameUs,     4);
+  memcpy(&p[10], &_superseded, 2);
+  memcpy(&p[12], &_underrun,   2);
+  sendFrame_(T_LAT, p, sizeof(p));
+}
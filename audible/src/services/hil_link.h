@@ -0,0 +1,62 @@
+#pragma once
+#include <stdint.h>
+
+// HIL: muestras de presión/temperatura inyectadas por USB-CDC en lugar de
+// BMP390Bosch::read(). Mismo protocolo que s3-tiny/c3 (ver s3-tiny/src/hil_link.h):
+//   A5 5A | tipo | len | payload | crc16-ccitt
+//   host->equipo: 0x01 ENTER [ref_pa f32], 0x02 EXIT,
+//                 0x03 SAMPLE seq u16, host_us u32, pres_pa f32, temp_c f32,
+//                 0x04 PING host_us u32
+//   equipo->host: 0x81 ACK, 0x83 LAT (seq, rx->uso us, rx->pantalla us,
+//                 pisadas u16, sin-muestra u16), 0x84 PONG
+class HilLink {
+public:
+  // true si el byte pertenece a una trama HIL
+  bool feed(uint8_t b);
+
+  // Sale solo si el host deja de hablar
+  void tick(uint32_t now_ms, uint32_t timeout_ms = 3000);
+
+  bool active() const { return _active; }
+
+  // Consumidor del sensor: false si no hay muestra nueva
+  bool takeSample(float& pressurePa, float& tempC);
+
+  // Presión de referencia pedida en ENTER (una vez por sesión)
+  bool takeReference(float& refPa);
+
+  // Tras refrescar la pantalla (o el Serial si no hay display)
+  void onFrameSent();
+
+private:
+  static constexpr uint8_t MAX_PAYLOAD = 32;
+  enum class Ps : uint8_t { Sync0, Sync1, Type, Len, Payload, Crc0, Crc1 };
+
+  void handleFrame_();
+  void sendFrame_(uint8_t type, const void* payload, uint8_t len);
+  void enter_();
+  void exit_(const char* why);
+
+  Ps       _ps = Ps::Sync0;
+  uint8_t  _type = 0, _len = 0, _pos = 0;
+  uint8_t  _payload[MAX_PAYLOAD] {};
+  uint16_t _crcRx = 0;
+
+  bool     _active = false;
+  uint32_t _lastRxMs = 0;
+  bool     _refPending = false;
+  float    _refPa = 0.f;
+
+  bool     _fresh = false;
+  uint16_t _seq = 0;
+  float    _presPa = 0.f, _tempC = 0.f;
+  int64_t  _rxUs = 0;
+
+  bool     _latPending = false;
+  uint16_t _latSeq = 0;
+  int64_t  _latRxUs = 0;
+  uint32_t _latUseUs = 0;
+
+  uint16_t _superseded = 0;
+  uint16_t _underrun = 0;
+};
@@ -0,0 +1,121 @@
+#pragma once
+#include <Arduino.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include <string.h>
+#include "app/flight_mode.h"
+
+// Watchdog de latencia del loop: registra en un ring post-mortem (RTC, sobrevive
+// a resets por pánico/WDT) cualquier sección nombrada o iteración que supere el
+// presupuesto del modo de vuelo actual. No imprime al detectar: dump() bajo demanda.
+struct LoopWatchdogBudget {
+  uint32_t ground_us   = 200000;  // 200 ms (loop de 2 s con light sleep)
+  uint32_t climb_us    =  50000;  // 50 ms
+  uint32_t freefall_us =   5000;  // 5 ms
+  uint32_t canopy_us   =  20000;  // 20 ms
+};
+
+class LoopWatchdog {
+public:
+  static constexpr uint8_t RING = 16;
+
+  struct Event {
+    uint32_t t_ms;
+    uint32_t dur_us;
+    uint32_t budget_us;
+    uint8_t  mode;
+    char     name[11];
+  };
+
+  struct Ring {
+    uint32_t magic;
+    uint16_t head;
+    uint16_t count;
+    uint32_t total;
+    Event    ev[RING];
+  };
+
+  // RAII: mide una sección y la reporta al salir del ámbito
+  class Section {
+  public:
+    Section(LoopWatchdog& wd, const char* name)
+      : _wd(wd), _name(name), _t0(esp_timer_get_time()) {}
+    ~Section() { _wd.report(_name, (uint32_t)(esp_timer_get_time() - _t0)); }
+  private:
+    LoopWatchdog& _wd;
+    const char*   _name;
+    int64_t       _t0;
+  };
+
+  void begin(Ring* ring, const LoopWatchdogBudget& b = LoopWatchdogBudget()) {
+    _r = ring; _b = b;
+    if (_r->magic != MAGIC || _r->count > RING || _r->head >= RING) clear();
+    if (_r->count) {
+      Serial.printf("[LWD] post-mortem: %u eventos (total=%lu)\n",
+                    (unsigned)_r->count, (unsigned long)_r->total);
+    }
+  }
+
+  void setMode(FlightMode m) { _mode = m; }
+
+  void loopBegin()  { _loopT0 = esp_timer_get_time(); _paused = 0; }
+  void loopPause()  { _pauseT0 = esp_timer_get_time(); }
+  void loopResume() { _paused += esp_timer_get_time() - _pauseT0; }
+  void loopEnd() {
+    const int64_t busy = (esp_timer_get_time() - _loopT0) - _paused;
+    if (busy > 0) report("loop", (uint32_t)busy);
+  }
+
+  uint32_t budgetUs() const {
+    switch (_mode) {
+      case FlightMode::FREEFALL: return _b.freefall_us;
+      case FlightMode::CANOPY:   return _b.canopy_us;
+      case FlightMode::CLIMB:    return _b.climb_us;
+      case FlightMode::GROUND:
+      default:                   return _b.ground_us;
+    }
+  }
+
+  void report(const char* name, uint32_t durUs) {
+    if (!_r) return;
+    const uint32_t budget = budgetUs();
+    if (durUs <= budget) return;
+    Event& e   = _r->ev[_r->head];
+    e.t_ms      = millis();
+    e.dur_us    = durUs;
+    e.budget_us = budget;
+    e.mode      = (uint8_t)_mode;
+    strncpy(e.name, name ? name : "?", sizeof(e.name) - 1);
+    e.name[sizeof(e.name) - 1] = '\0';
+    _r->head = (uint16_t)((_r->head + 1) % RING);
+    if (_r->count < RING) _r->count++;
+    _r->total++;
+  }
+
+  void dump() const {
+    if (!_r) return;
+    Serial.printf("[LWD] eventos=%u total=%lu\n", (unsigned)_r->count, (unsigned long)_r->total);
+    const uint16_t first = (uint16_t)((_r->head + RING - _r->count) % RING);
+    for (uint16_t i = 0; i < _r->count; ++i) {
+      const Event& e = _r->ev[(first + i) % RING];
+      Serial.printf("[LWD] t=%lums %-10s %luus > %luus (mode=%u)\n",
+                    (unsigned long)e.t_ms, e.name, (unsigned long)e.dur_us,
+                    (unsigned long)e.budget_us, (unsigned)e.mode);
+    }
+  }
+
+  void clear() {
+    memset(_r, 0, sizeof(*_r));
+    _r->magic = MAGIC;
+  }
+
+private:
+  static constexpr uint32_t MAGIC = 0x4C574431; // "LWD1"
+
+  Ring*              _r = nullptr;
+  LoopWatchdogBudget _b;
+  FlightMode         _mode = FlightMode::GROUND;
+  int64_t            _loopT0 = 0;
+  int64_t            _paused = 0;
+  int64_t            _pauseT0 = 0;
+};
@@ -94,6 +94,8 @@ void batteryUpdate() {
   s_percent        = voltageToPercent(s_vbat);
 }
 
+uint32_t batteryNextDueMs() { return (uint32_t)(s_tLast + BATTERY_UPDATE_INTERVAL_MS); }
+
 float batteryGetVoltage() {
   return s_vbat;
 }
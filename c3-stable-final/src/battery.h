@@ -4,6 +4,7 @@
 // Inicialización / ciclo
 void  batteryInit();
 void  batteryUpdate();
+uint32_t batteryNextDueMs();   // millis() de la próxima medida (planificador)
 
 // Lecturas
 float batteryGetVoltage();   // Voltaje estimado de batería (V)
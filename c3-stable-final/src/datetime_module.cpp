@@ -159,6 +159,7 @@ void datetimeOnBeforeDeepSleep(uint64_t /*planned_sleep_us*/) {
 // ====== UI de configuración (SIEMPRE DD/MM/YY y HH:MM) ======
 #include <U8g2lib.h>
 #include "config.h"
+#include "oled_stream.h"
 
 // Idioma solo para textos (no afecta orden de fecha)
 extern int idioma;               // 0=ES, 1=EN
@@ -298,7 +299,7 @@ void datetimeMenuDrawAndHandle() {
     u8g2.drawStr(x_arrow, yAcciones, ">");
   }
 
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 
   // ----------------- Entradas NO BLOQUEANTES -----------------
 
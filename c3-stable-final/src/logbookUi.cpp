@@ -4,6 +4,7 @@
 #include "logbook.h"
 #include "logbookUi.h"
 #include "datetime_module.h"   // para formatear ts_local
+#include "oled_stream.h"
 
 //Aceleracion para logbook (variables globales originales, se mantienen aunque no se usen aquí)
 static uint16_t s_step = 1;           // tamaño de paso actual
@@ -114,7 +115,7 @@ static void drawEntry(U8G2 &u8g2, const JumpLog& jl, int idx, int total) {
   u8g2.setCursor(idX, 62);
   u8g2.print(idbuf);
 
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 }
 
 static void drawEmpty(U8G2 &u8g2) {
@@ -122,7 +123,7 @@ static void drawEmpty(U8G2 &u8g2) {
   u8g2.setFont(u8g2_font_ncenB08_tr);
   u8g2.setCursor(10, 28); u8g2.print(T("Sin registros", "No entries"));
   u8g2.setCursor(10, 46); u8g2.print(T("MENU para salir", "MENU to exit"));
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 }
 
 static void drawErasePrompt(U8G2 &u8g2, bool confirmStage) {
@@ -133,7 +134,7 @@ static void drawErasePrompt(U8G2 &u8g2, bool confirmStage) {
   u8g2.setCursor(0, 32); u8g2.print(T("Mantener ALT+OLED", "Hold ALT+OLED"));
   u8g2.setCursor(0, 44); u8g2.print(T("2s para CONFIRMAR", "2s to CONFIRM"));
   u8g2.setCursor(0, 60); u8g2.print(T("MENU para cancelar", "MENU to cancel"));
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 }
 
 // Reemplazo NO bloqueante del antiguo delay(900)
@@ -205,7 +206,7 @@ void logbookUiDrawAndHandle(U8G2 &u8g2) {
     int x = (128 - w) / 2; if (x < 0) x = 0;
     u8g2.setCursor(x, 36);
     u8g2.print(s_toastMsg);
-    u8g2.sendBuffer();
+    oledStreamSubmit();
 
     if ((int32_t)(millis() - s_toastUntilMs) >= 0) {
       s_toastActive = false;
@@ -0,0 +1,110 @@
+#include "loop_sched.h"
+#include <esp_timer.h>
+#include <string.h>
+#include "config.h"
+
+// ------------------------------
+// Estado
+// ------------------------------
+static TaskHandle_t s_task = nullptr;          // tarea del loop (Arduino)
+static uint32_t     s_due[SCHED_SLOT_COUNT];
+static bool         s_armed[SCHED_SLOT_COUNT];
+
+static const uint8_t kWakePins[] = { BUTTON_MENU, BUTTON_ALTITUDE, BUTTON_OLED };
+static const char* const kSlotNames[SCHED_SLOT_COUNT] = { "sensor", "ui", "bat", "dbg", "alarma" };
+
+struct SchedStats {
+  uint32_t waits;          // llamadas a schedWait
+  uint32_t slept;          // bloqueos reales
+  uint32_t byEvent;        // despertadas por ISR/notify
+  uint32_t overdue;        // plazo ya vencido: sin bloqueo
+  uint32_t subTick;        // plazo < 1 tick: sin bloqueo
+  uint64_t blockedUs;
+  uint32_t nearest[SCHED_SLOT_COUNT];   // quién fijó el plazo
+};
+static SchedStats s_st;
+static int64_t    s_statsT0 = 0;
+static volatile uint32_t s_isrWakes = 0;
+
+// ------------------------------
+// Eventos
+// ------------------------------
+void IRAM_ATTR schedWakeFromISR() {
+  if (!s_task) return;
+  BaseType_t hp = pdFALSE;
+  vTaskNotifyGiveFromISR(s_task, &hp);
+  s_isrWakes++;
+  if (hp) portYIELD_FROM_ISR();
+}
+
+void schedWake() {
+  if (s_task) xTaskNotifyGive(s_task);
+}
+
+// ------------------------------
+// API
+// ------------------------------
+void schedBegin() {
+  s_task = xTaskGetCurrentTaskHandle();
+  for (uint8_t i = 0; i < SCHED_SLOT_COUNT; ++i) s_armed[i] = false;
+  // Flancos de botones (activos-alto): cortan la espera al instante
+  for (uint8_t pin : kWakePins) attachInterrupt(digitalPinToInterrupt(pin), schedWakeFromISR, CHANGE);
+  schedReset();
+}
+
+void schedAt(SchedSlot slot, uint32_t dueMs) {
+  s_due[slot]   = dueMs;
+  s_armed[slot] = true;
+}
+
+void schedClear(SchedSlot slot) { s_armed[slot] = false; }
+
+uint32_t schedWait(uint32_t maxMs) {
+  s_st.waits++;
+  const uint32_t now = millis();
+
+  // Plazo más cercano; los vencidos se consumen (el dueño los re-anota)
+  uint32_t waitMs = maxMs;
+  int8_t   who    = -1;
+  bool     overdue = false;
+  for (uint8_t i = 0; i < SCHED_SLOT_COUNT; ++i) {
+    if (!s_armed[i]) continue;
+    const int32_t d = (int32_t)(s_due[i] - now);
+    if (d <= 0) { s_armed[i] = false; overdue = true; continue; }
+    if ((uint32_t)d < waitMs) { waitMs = (uint32_t)d; who = (int8_t)i; }
+  }
+  if (overdue) { s_st.overdue++; return 0; }
+
+  // Redondeo hacia abajo: despertar en el tick anterior, nunca después
+  const TickType_t ticks = waitMs / portTICK_PERIOD_MS;
+  if (!s_task || ticks == 0) { s_st.subTick++; return 0; }
+
+  const int64_t t0 = esp_timer_get_time();
+  const uint32_t got = ulTaskNotifyTake(pdTRUE, ticks);
+  const int64_t dt = esp_timer_get_time() - t0;
+
+  s_st.slept++;
+  s_st.blockedUs += (uint64_t)dt;
+  if (got) s_st.byEvent++;
+  else if (who >= 0) s_st.nearest[who]++;
+  return (uint32_t)(dt / 1000);
+}
+
+void schedDump() {
+  const double spanS = (esp_timer_get_time() - s_statsT0) * 1e-6;
+  const double pct   = spanS > 0 ? 100.0 * (s_st.blockedUs * 1e-6) / spanS : 0.0;
+  Serial.printf("[SCHED] esperas=%lu bloqueos=%lu (%.1f%% del tiempo) eventos=%lu isr=%lu vencidos=%lu <1tick=%lu\n",
+                (unsigned long)s_st.waits, (unsigned long)s_st.slept, pct,
+                (unsigned long)s_st.byEvent, (unsigned long)s_isrWakes,
+                (unsigned long)s_st.overdue, (unsigned long)s_st.subTick);
+  Serial.print("[SCHED] plazo por:");
+  for (uint8_t i = 0; i < SCHED_SLOT_COUNT; ++i)
+    Serial.printf(" %s=%lu", kSlotNames[i], (unsigned long)s_st.nearest[i]);
+  Serial.println();
+}
+
+void schedReset() {
+  memset(&s_st, 0, sizeof(s_st));
+  s_isrWakes = 0;
+  s_statsT0  = esp_timer_get_time();
+}
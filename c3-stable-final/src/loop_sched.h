@@ -0,0 +1,50 @@
+#ifndef LOOP_SCHED_H
+#define LOOP_SCHED_H
+
+// =====================================================
+// Planificador por plazos del loop (tickless)
+// -----------------------------------------------------
+// Cada subsistema anota cuándo vuelve a tener trabajo
+// (schedAt). Al final de la vuelta schedWait() bloquea la
+// tarea del loop hasta el plazo más cercano o hasta un
+// evento: flanco de botón (ISR) o schedWake().
+// Mientras el loop está bloqueado corre la tarea IDLE
+// (WAITI) en vez de girar sondeando millis().
+// Un frame del OLED a medio enviar (oled_stream) no espera:
+// una página por vuelta hasta terminarlo.
+// Los plazos vencidos no duermen: nunca se añade latencia a
+// una muestra (redondeo hacia abajo al tick de FreeRTOS).
+// 'd' por Serial: estadísticas de espera.
+// =====================================================
+
+#include <Arduino.h>
+
+enum SchedSlot : uint8_t {
+  SCHED_SENSOR = 0,   // próximo tick del BMP
+  SCHED_UI,           // próximo frame/sondeo de pantalla
+  SCHED_BATTERY,
+  SCHED_DEBUG,        // líneas [CHG]/[HZ] de 1 Hz
+  SCHED_ALARM,        // pulsos del vibrador en curso
+  SCHED_SLOT_COUNT
+};
+
+// Tope de espera sin plazos (sondeo de Serial, lock...)
+#ifndef SCHED_MAX_WAIT_MS
+  #define SCHED_MAX_WAIT_MS  1000UL
+#endif
+
+void schedBegin();                          // en setup(): tarea del loop + ISR de botones
+void schedAt(SchedSlot slot, uint32_t dueMs);   // millis() absoluto
+void schedClear(SchedSlot slot);            // sin trabajo pendiente
+
+// Bloquea hasta el plazo más cercano (como mucho maxMs) o un
+// evento. Devuelve los ms bloqueados.
+uint32_t schedWait(uint32_t maxMs = SCHED_MAX_WAIT_MS);
+
+void schedWake();                           // desde otra tarea
+void IRAM_ATTR schedWakeFromISR();
+
+void schedDump();
+void schedReset();
+
+#endif // LOOP_SCHED_H
@@ -14,6 +14,9 @@
 #include "esp_sleep.h"
 #include "driver/gpio.h"
 #include "alarm.h"
+#include "hil_link.h"
+#include "oled_stream.h"
+#include "loop_sched.h"
 
 
 // OLED global definida en ui_module.cpp
@@ -45,6 +48,21 @@ static void hzReportTick(int modo /* 0: Ahorro, 1: Ultra, 2: Freefall */) {
 #endif
 // ==========================
 
+// ==========================
+// HIL por USB-CDC (tramas binarias; ver hil_link.h)
+// ==========================
+static void serialHilTick() {
+  int avail = Serial.available();
+  while (avail-- > 0) {
+    const int c = Serial.read();
+    if (c < 0) break;
+    if (hilFeedByte((uint8_t)c)) continue;
+    if (c == 'o') oledStreamDump();
+    else if (c == 'd') schedDump();
+  }
+  hilTick();
+}
+
 // === Deep Sleep por aterrizaje (fijo 5 min) ===
 #ifndef LANDING_DS_ENABLE
 #define LANDING_DS_ENABLE   1
@@ -174,7 +192,7 @@ static void enterDeepSleepNow(const char* reason = "inactividad") {
   // Apagar OLED de forma segura
   u8g2.setPowerSave(true);
   u8g2.clearBuffer();
-  u8g2.sendBuffer();
+  oledStreamSendNow();
 
   setupWakeSourceGPIO();    // wake por botón (HIGH) + VBUS (HIGH)
   datetimeOnBeforeDeepSleep();
@@ -220,6 +238,12 @@ static inline void maybeEnterDeepSleep() {
 // ======================================================================
 // Estrangulador de lecturas del BMP sin tocar sensor_module
 // ======================================================================
+#ifndef SCHED_USB_POLL_MS
+#define SCHED_USB_POLL_MS           20  // con USB/HIL: comandos y tramas por CDC
+#endif
+#ifndef ALARM_POLL_MS
+#define ALARM_POLL_MS               10  // resolución de los pulsos del vibrador
+#endif
 #ifndef SENSOR_TICK_AHORRO_MS
 #define SENSOR_TICK_AHORRO_MS       150  // ~6.7 Hz en tierra (ahorro real de I2C/energía)
 #endif
@@ -240,10 +264,11 @@ static void tickSensor() {
   else if (m == SENSOR_MODE_FREEFALL) interval = SENSOR_TICK_FREEFALL_MS;
   // (cualquier otro modo cae en “Ahorro” por defecto)
 
-  if (now - lastTick < interval) return;
-  lastTick = now;
-
-  updateSensorData();   // << única llamada; fuera del throttle no se invoca
+  if (now - lastTick >= interval) {
+    lastTick = now;
+    updateSensorData();   // << única llamada; fuera del throttle no se invoca
+  }
+  schedAt(SCHED_SENSOR, lastTick + interval);   // loop_sched: próximo tick
 }
 unsigned long tTest = 0;
 bool testFired = false;
@@ -283,6 +308,9 @@ void setup() {
   // Iniciar temporizador de inactividad
   noteUserActivity();
 
+  // El loop espera plazos (loop_sched) en vez de girar
+  schedBegin();
+
   // Inicializa referencia de modo para el temporizador de aterrizaje
   s_prevMode = getSensorMode();
   s_landingArmed = false;
@@ -298,10 +326,13 @@ void loop() {
     testFired = true;
   }
   powerLockUpdate();
+  if (alarmReady()) schedClear(SCHED_ALARM);
+  else schedAt(SCHED_ALARM, millis() + ALARM_POLL_MS);   // pulso en curso
 
   // === Sensores / UI / Batería ===
   tickSensor();        // << en vez de updateSensorData() continuo
   batteryUpdate();
+  schedAt(SCHED_BATTERY, batteryNextDueMs());
 
   chargeDetectUpdate();
   static uint32_t lastDbg = 0;
@@ -312,7 +343,11 @@ void loop() {
                   chargeDebugRaw(), chargeDebugVadc(),
                   chargeDebugVbus(), isUsbPresent());
   }
+  schedAt(SCHED_DEBUG, lastDbg + 1000);
   updateUI();
+  oledStreamTick();    // una página del frame en curso por vuelta
+  // Frame a medio enviar: otra vuelta ya; si no, el próximo de la UI
+  schedAt(SCHED_UI, oledStreamBusy() ? millis() : uiNextDueMs());
 
   // === Actualiza ventana de gracia global por contexto de vuelo ===
   updateFlightGraceWindow();
@@ -341,7 +376,7 @@ void loop() {
   // === Calibración automática al inicio (una sola vez) ===
   if (!calibracionRealizada) {
     if (bmp.performReading()) {
-      altitudReferencia = bmp.readAltitude(1013.25);
+      altitudReferencia = sensorPressureToAltitude(bmp.pressure);
       Serial.println("Calibración inicial: altitud reiniciada a cero.");
 #if DEBUG_HZ
       onSampleAccepted();
@@ -396,7 +431,7 @@ void loop() {
     }
     if (altNow && !altDidAction && (millis() - altDownTs >= 1000UL)) {
       if (bmp.performReading()) {
-        altitudReferencia = bmp.readAltitude(1013.25);
+        altitudReferencia = sensorPressureToAltitude(bmp.pressure);
 
         // **Importante**: NO borrar el offset.
         // Así, tras el lock, la UI muestra 'alturaOffset' (p. ej. +200 m),
@@ -444,8 +479,13 @@ void loop() {
   }
 #endif
   
+  // Tramas HIL (muestras inyectadas por el host)
+  serialHilTick();
+
   // === Evaluar sueño (aterrizaje fijo primero, luego inactividad) ===
   maybeEnterDeepSleep();
 
-  // Sin delay bloqueante: la UI ya regula su ritmo de repintado por modo.
+  // Sin delay: bloquea hasta el próximo plazo o un botón (loop_sched).
+  // Con USB/HIL, tope corto para no atrasar bytes del CDC.
+  schedWait((isUsbPresent() || hilActive()) ? SCHED_USB_POLL_MS : SCHED_MAX_WAIT_MS);
 }
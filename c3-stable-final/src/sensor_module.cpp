@@ -8,6 +8,7 @@
 #include "logbook.h"             // Integración de bitácora
 #include "nvs.h"
 #include "nvs_flash.h"
+#include "hil_link.h"
 
 
 // ------------------------------
@@ -118,6 +119,11 @@ static inline float alphaFor(SensorMode m) {
   }
 }
 
+float sensorPressureToAltitude(double pressure_pa) {
+  const double atm_hpa = pressure_pa / 100.0;
+  return (float)(44330.0 * (1.0 - pow(atm_hpa / 1013.25, 0.1903)));
+}
+
 // ====================================================
 // Helpers: Vario y Freefall por VZ
 // ====================================================
@@ -188,7 +194,7 @@ void initSensor() {
 
   // Lectura inicial para fijar la altitud de referencia
   if (bmp.performReading()) {
-    altitudReferencia = bmp.readAltitude(1013.25);
+    altitudReferencia = sensorPressureToAltitude(bmp.pressure);
   }
 
   // (Opcional) Log informativo: total de saltos (lifetime) desde logbook
@@ -221,10 +227,22 @@ void updateSensorData() {
   bool sampleCounted = false;
 
   if (debeLeer) {
-    const bool sensorOk = bmp.performReading();
+    bool sensorOk;
+    if (hilActive()) {
+      // HIL: la muestra del host sustituye a la conversión I2C
+      float refPa;
+      if (hilTakeReference(refPa)) {
+        altitudReferencia = sensorPressureToAltitude(refPa);
+        agzBias = 0.0f;
+      }
+      sensorOk = hilTakeSample(bmp.pressure, bmp.temperature);
+      if (!sensorOk) return;        // sin muestra nueva: nada que procesar
+    } else {
+      sensorOk = bmp.performReading();
+    }
     if (sensorOk) {
       readFails = 0;
-      const float altActual = bmp.readAltitude(1013.25);
+      const float altActual = sensorPressureToAltitude(bmp.pressure);
       altitud       = altActual;                                       // absoluto (m)
       // ===== Integración AGZ: sumar sesgo al cálculo relativo =====
       altCalculada  = altActual - altitudReferencia + alturaOffset + agzBias;    // relativa (m)
@@ -29,4 +29,8 @@ extern bool     inJump;          // freefall confirmado (relleno)
 void initSensor();
 void updateSensorData();
 
+// Presión (Pa) -> altitud (m) con la misma fórmula que Adafruit (QNH 1013.25),
+// pero sin disparar otra conversión como hace bmp.readAltitude()
+float sensorPressureToAltitude(double pressure_pa);
+
 #endif // SENSOR_MODULE_H
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "config.h"
 #include "ui_module.h"
 #include "snake.h"          // usa Direction, Point y las #define
+#include "oled_stream.h"
 
 // Declarado en ui_module.cpp
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
@@ -73,7 +74,7 @@ static void drawSnakeGame() {
   u8g2.print("Score: ");
   u8g2.print(score);
 
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 }
 
 void playSnakeGame() {
@@ -148,7 +149,7 @@ void playSnakeGame() {
     u8g2.setCursor(0, 60);
     u8g2.print("Score: ");
     u8g2.print(score);
-    u8g2.sendBuffer();
+    oledStreamSubmit();
 
     if (now >= s_gameOverUntilMs || okRise) {
       initialized = false;
@@ -12,6 +12,9 @@
 #include "logbook.h"
 #include "charge_detect.h"
 #include "alarm.h"
+#include "hil_link.h"
+#include "alt_glyph_cache.h"
+#include "oled_stream.h"
 
 // ===== Defaults seguros (si no están ya en config.h) =====
 #ifndef ALTURA_OFFSET_MIN_M
@@ -32,6 +35,9 @@
 #ifndef OFFSET_ZERO_EPS_M
 #define OFFSET_ZERO_EPS_M   0.05f       // <5 cm se considera 0 al guardar
 #endif
+#ifndef UI_INTERACTIVE_POLL_MS
+#define UI_INTERACTIVE_POLL_MS 20UL     // menús/juego/cuenta atrás (loop_sched)
+#endif
 
 // ===== Idioma =====
 extern int idioma; // LANG_ES / LANG_EN
@@ -159,7 +165,9 @@ void initUI() {
   altFormat = normalizeAltFormat(altFormat);
 
   u8g2.begin();
+  oledStreamBegin(u8g2);
   enableOledUltra();
+  altGlyphCacheBuild(u8g2, u8g2_font_fub30_tr, 50);   // línea base del HUD
 
   u8g2.setPowerSave(false);
   u8g2.setContrast(brilloPantalla);
@@ -201,7 +209,7 @@ void mostrarCuentaRegresiva() {
   if (x < 0) x = 0;
   u8g2.setCursor(x, 60);
   u8g2.print(ini);
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 
   if (elapsed >= 3000) startupDone = true;
 }
@@ -308,7 +316,7 @@ void dibujarMenu() {
 
   u8g2.setCursor(100, 63);
   u8g2.print(String(paginaActual + 1) + "/" + String(totalPaginas));
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 }
 
 // ---------------------------------------------------------------------------
@@ -332,7 +340,7 @@ static void dibujarOffsetEdit() {
   u8g2.print(T("OK + / ALT - | MENU Guarda | ALT+MENU Cancela | OK+ALT = 0",
                "OK + / ALT - | MENU Save   | ALT+MENU Cancel  | OK+ALT = 0"));
 
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 }
 
 // ---------------------------------------------------------------------------
@@ -551,6 +559,16 @@ static inline void handleAhorroAutoDim() {
   }
 }
 
+// ---------------------------------------------------------------------------
+// Throttling del HUD por modo (ms entre repintados)
+static uint32_t s_uiLastMs = 0;
+static inline uint16_t hudIntervalMs() {
+  const SensorMode m = getSensorMode();
+  if (m == SENSOR_MODE_FREEFALL)      return 80;
+  if (m == SENSOR_MODE_ULTRA_PRECISO) return 100;
+  return 140;
+}
+
 // ---------------------------------------------------------------------------
 void updateUI() {
   if (!startupDone) { mostrarCuentaRegresiva(); return; }
@@ -567,14 +585,9 @@ void updateUI() {
 
   if (!menuActivo) {
     // Throttling de repintado por modo
-    static uint32_t t_last_ui = 0;
-    uint16_t ui_interval = 140;
-    SensorMode m = getSensorMode();
-    if (m == SENSOR_MODE_ULTRA_PRECISO) ui_interval = 100;
-    if (m == SENSOR_MODE_FREEFALL)     ui_interval = 80;
     uint32_t now_ui = millis();
-    if (now_ui - t_last_ui < ui_interval) return;
-    t_last_ui = now_ui;
+    if (now_ui - s_uiLastMs < hudIntervalMs()) return;
+    s_uiLastMs = now_ui;
 
     // -------- Pantalla principal / HUD --------
     u8g2.clearBuffer();
@@ -680,11 +693,16 @@ void updateUI() {
       altDisplay = String((long)altToShow);
     }
 
-    u8g2.setFont(u8g2_font_fub30_tr);
-    int xPosAlt = (128 - u8g2.getStrWidth(altDisplay.c_str())) / 2;
+    // Glifos cacheados (alt_glyph_cache); u8g2 si falta alguno
+    int wAlt = altGlyphStrWidth(altDisplay.c_str());
+    if (wAlt < 0) { u8g2.setFont(u8g2_font_fub30_tr); wAlt = u8g2.getStrWidth(altDisplay.c_str()); }
+    int xPosAlt = (128 - wAlt) / 2;
     if (xPosAlt < 0) xPosAlt = 0;
-    u8g2.setCursor(xPosAlt, 50);
-    u8g2.print(altDisplay);
+    if (!altGlyphDrawStr(u8g2, xPosAlt, 50, altDisplay.c_str())) {
+      u8g2.setFont(u8g2_font_fub30_tr);
+      u8g2.setCursor(xPosAlt, 50);
+      u8g2.print(altDisplay);
+    }
 
     // Bordes
     u8g2.drawHLine(0, 15, 128); 
@@ -719,7 +737,7 @@ void updateUI() {
       alarmOnLockAltitude();
     }
 
-    u8g2.sendBuffer();
+    oledStreamSubmit(hilOnFrameSent);   // HIL: cierra la medida muestra->pantalla al llegar al panel
 
   } else {
     // ======= Menú / Submenús =======
@@ -748,7 +766,7 @@ void updateUI() {
         u8g2.print(pct);
         u8g2.print("%");
 
-        u8g2.sendBuffer();
+        oledStreamSubmit();
 
         btnTick(BTN_OK);
         if (btnRise(BTN_OK)) {
@@ -767,3 +785,15 @@ void updateUI() {
     dibujarMenu();
   }
 }
+
+// Próximo instante en que updateUI() tiene trabajo (planificador del loop).
+// Menús, juego y cuenta atrás sondean botones/parpadeos: paso corto.
+uint32_t uiNextDueMs() {
+  const uint32_t now = millis();
+  if (!startupDone || menuActivo || gameSnakeRunning) return now + UI_INTERACTIVE_POLL_MS;
+  // Botón mantenido (pulsación larga del lock en main)
+  if (digitalRead(BUTTON_MENU) == HIGH || digitalRead(BUTTON_ALTITUDE) == HIGH ||
+      digitalRead(BUTTON_OLED) == HIGH) return now + UI_INTERACTIVE_POLL_MS;
+  if (!pantallaEncendida) return now + hudIntervalMs();
+  return s_uiLastMs + hudIntervalMs();
+}
@@ -18,6 +18,7 @@ void updateUI();                // Dibuja HUD/menús de forma no bloqueante
 void dibujarMenu();             // Render del menú principal
 void mostrarCuentaRegresiva();  // Splash de arranque (no bloqueante)
 void processMenu();             // Lógica de navegación del menú (no bloqueante)
+uint32_t uiNextDueMs();         // millis() del próximo trabajo de la UI (loop_sched)
 
 // (Opcional) Si algún módulo externo quisiera invocar la pantalla de edición:
 // void dibujarOffsetEdit();
@@ -8,6 +8,7 @@
 #include "buzzer_module.h"
 #include "power_lock.h"         // <<< Sleep-lock opción B (25 min fijos)
 #include "battery.h"            // <<< Nuevo: módulo de batería
+#include "oled_stream.h"
 
 // ==========================
 /* Instrumentación de Hz (Opción 1) */
@@ -94,7 +95,7 @@ static void enterDeepSleepNow(const char* reason = "inactividad") {
   stopBuzzer();             // silenciar
   u8g2.setPowerSave(true);  // apagar OLED
   u8g2.clearBuffer();
-  u8g2.sendBuffer();
+  oledStreamSendNow();
 
   setupWakeSourceGPIO();    // botón wake
 
@@ -185,6 +186,7 @@ void loop() {
 
   updateSensorData();
   updateUI();
+  oledStreamTick();    // una página del frame en curso por vuelta
   batteryUpdate();  // <<< Nuevo: actualizar lectura/porcentaje de batería
   
   // ----- Corte por batería baja, pero NUNCA durante el vuelo -----
@@ -318,7 +320,12 @@ void loop() {
   uint16_t baseDelay = 101;
   if (modo == SENSOR_MODE_ULTRA_PRECISO) baseDelay = 10;
   if (modo == SENSOR_MODE_FREEFALL)     baseDelay = 0;
-  delay(baseDelay);
+  // La espera vuelca las páginas pendientes: el frame llega al panel
+  // en esta misma vuelta en vez de una página cada baseDelay
+  const uint32_t tWait = millis();
+  while (oledStreamBusy() && (millis() - tWait) < baseDelay) oledStreamTick();
+  const uint32_t spent = millis() - tWait;
+  if (spent < baseDelay) delay(baseDelay - spent);
 
   // Evaluar sueño (aterrizaje fijo primero, luego inactividad)
   maybeEnterDeepSleep();
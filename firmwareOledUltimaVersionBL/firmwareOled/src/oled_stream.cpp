@@ -0,0 +1,107 @@
+#include "oled_stream.h"
+#include <esp_timer.h>
+#include <string.h>
+
+// ------------------------------
+// Estado (RAM fija: 3 x 1 KB)
+// ------------------------------
+static constexpr uint8_t  OLED_PAGES    = 8;
+static constexpr uint8_t  OLED_PAGE_LEN = 128;
+static constexpr uint16_t OLED_BUF_LEN  = OLED_PAGES * OLED_PAGE_LEN;
+
+static U8G2*    s_u8g2 = nullptr;
+static uint8_t  s_bufA[OLED_BUF_LEN];
+static uint8_t  s_bufB[OLED_BUF_LEN];
+static uint8_t  s_shadow[OLED_BUF_LEN];     // lo que muestra el panel
+static uint8_t* s_tx   = s_bufA;            // frame en vuelo (congelado)
+static uint8_t* s_next = s_bufB;            // siguiente frame entregado
+static bool     s_busy    = false;
+static bool     s_hasNext = false;
+static bool     s_valid   = false;          // s_shadow refleja el panel
+static uint8_t  s_page    = 0;              // próxima página a revisar
+static OledStreamStats s_st;
+
+static inline bool pageDirty(uint8_t p) {
+  const uint16_t off = (uint16_t)p * OLED_PAGE_LEN;
+  return !s_valid || memcmp(s_tx + off, s_shadow + off, OLED_PAGE_LEN) != 0;
+}
+
+// Envía la página p de s_tx: u8g2 lee del buffer que apunte tile_buf_ptr
+static void sendPage(uint8_t p) {
+  u8g2_t* g = s_u8g2->getU8g2();
+  uint8_t* drawBuf = g->tile_buf_ptr;
+  g->tile_buf_ptr = s_tx;
+  const int64_t t0 = esp_timer_get_time();
+  s_u8g2->updateDisplayArea(0, p, OLED_PAGE_LEN / 8, 1);
+  const uint32_t dt = (uint32_t)(esp_timer_get_time() - t0);
+  g->tile_buf_ptr = drawBuf;
+
+  memcpy(s_shadow + (uint16_t)p * OLED_PAGE_LEN, s_tx + (uint16_t)p * OLED_PAGE_LEN, OLED_PAGE_LEN);
+  s_st.pagesSent++;
+  s_st.lastPageUs = dt;
+  if (dt > s_st.maxPageUs) s_st.maxPageUs = dt;
+}
+
+static void startNext() {
+  uint8_t* t = s_tx; s_tx = s_next; s_next = t;
+  s_hasNext = false;
+  s_busy    = true;
+  s_page    = 0;
+}
+
+// ------------------------------
+// API
+// ------------------------------
+void oledStreamBegin(U8G2 &u8g2) {
+  s_u8g2 = &u8g2;
+  s_busy = s_hasNext = s_valid = false;
+  s_page = 0;
+  memset(&s_st, 0, sizeof(s_st));
+}
+
+void oledStreamSubmit() {
+  if (!s_u8g2) return;
+  if (s_hasNext) s_st.superseded++;
+  memcpy(s_next, s_u8g2->getBufferPtr(), OLED_BUF_LEN);
+  s_hasNext = true;
+  if (!s_busy) startNext();
+}
+
+bool oledStreamTick() {
+  if (!s_busy) return false;
+
+  // Salta páginas limpias hasta la primera sucia (sin tocar el bus)
+  while (s_page < OLED_PAGES && !pageDirty(s_page)) { s_page++; s_st.pagesSkipped++; }
+
+  bool sent = false;
+  if (s_page < OLED_PAGES) {
+    sendPage(s_page++);
+    sent = true;
+  }
+
+  if (s_page >= OLED_PAGES) {
+    s_valid = true;
+    s_busy  = false;
+    s_st.frames++;
+    if (s_hasNext) startNext();
+  }
+  return sent;
+}
+
+void oledStreamSendNow() {
+  oledStreamSubmit();
+  while (s_busy) oledStreamTick();
+}
+
+bool oledStreamBusy() { return s_busy || s_hasNext; }
+
+void oledStreamInvalidate() { s_valid = false; }
+
+OledStreamStats oledStreamStats() { return s_st; }
+
+void oledStreamDump() {
+  Serial.printf("[OLED] frames=%lu pisados=%lu paginas=%lu iguales=%lu bloqueo max=%luus ult=%luus\n",
+                (unsigned long)s_st.frames, (unsigned long)s_st.superseded,
+                (unsigned long)s_st.pagesSent, (unsigned long)s_st.pagesSkipped,
+                (unsigned long)s_st.maxPageUs, (unsigned long)s_st.lastPageUs);
+}
@@ -0,0 +1,44 @@
+#ifndef OLED_STREAM_H
+#define OLED_STREAM_H
+
+// =====================================================
+// Volcado del SSD1306 por páginas, repartido en el loop
+// -----------------------------------------------------
+// sendBuffer() bloquea ~25 ms (1 KB por I2C a 400 kHz) y
+// deja el bus ocupado para el BMP390. Aquí:
+// - oledStreamSubmit(): congela una copia del buffer de u8g2
+//   (frame listo). No envía nada.
+// - oledStreamTick(): envía como mucho UNA página (128 B,
+//   ~3 ms) por llamada; las páginas iguales a lo que ya
+//   muestra el panel se saltan.
+// Coherencia: el frame en vuelo no cambia. Si se entrega otro
+// mientras tanto queda como siguiente (gana el último) y se
+// empieza al terminar el actual: nunca se mezclan páginas de
+// dos frames distintos.
+// oledStreamSendNow(): entrega y completa en el acto (código
+// bloqueante, antes de dormir).
+// =====================================================
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+struct OledStreamStats {
+  uint32_t frames;        // frames completados
+  uint32_t superseded;    // frames pisados antes de empezar a enviarse
+  uint32_t pagesSent;
+  uint32_t pagesSkipped;  // iguales al panel
+  uint32_t maxPageUs;     // mayor bloqueo de una página
+  uint32_t lastPageUs;
+};
+
+void oledStreamBegin(U8G2 &u8g2);
+void oledStreamSubmit();
+bool oledStreamTick();          // true si envió una página
+void oledStreamSendNow();
+bool oledStreamBusy();
+void oledStreamInvalidate();    // el próximo frame se envía entero
+
+OledStreamStats oledStreamStats();
+void oledStreamDump();
+
+#endif // OLED_STREAM_H
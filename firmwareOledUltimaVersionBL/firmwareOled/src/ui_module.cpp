@@ -9,6 +9,8 @@
 #include "snake.h"
 #include "power_lock.h"
 #include "battery.h"     // <<< Nuevo: fuente única de voltaje/% batería
+#include "alt_glyph_cache.h"
+#include "oled_stream.h"
 
 // ===== Idioma =====
 extern int idioma; // LANG_ES / LANG_EN
@@ -98,6 +100,8 @@ void initUI() {
   altFormat = normalizeAltFormat(altFormat);
 
   u8g2.begin();
+  oledStreamBegin(u8g2);
+  altGlyphCacheBuild(u8g2, u8g2_font_fub30_tr, 50);   // línea base del HUD
   u8g2.setPowerSave(false);         // Mantener activo durante operación normal
   u8g2.setContrast(brilloPantalla);
   extern bool inversionActiva;
@@ -133,7 +137,7 @@ void mostrarCuentaRegresiva() {
   int x = (128 - w) / 2;
   u8g2.setCursor(x, 60);
   u8g2.print(ini);
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 
   if (elapsed >= 3000) startupDone = true;
 
@@ -229,7 +233,7 @@ void dibujarMenu() {
     u8g2.setCursor(120, 63);
     u8g2.print(">");
   }
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 }
 
 // ---------------------------------------------------------------------------
@@ -249,7 +253,7 @@ void dibujarOffsetEdit() {
     u8g2.print(offsetTemp * 3.281f, 0);
     u8g2.print(" ft");
   }
-  u8g2.sendBuffer();
+  oledStreamSubmit();
 }
 
 // ---------------------------------------------------------------------------
@@ -566,11 +570,16 @@ void updateUI() {
     }
 
     // Mostrar la altitud en grande, centrada
-    u8g2.setFont(u8g2_font_fub30_tr);
-    int xPosAlt = (128 - u8g2.getStrWidth(altDisplay.c_str())) / 2;
+    // Glifos cacheados (alt_glyph_cache); u8g2 si falta alguno
+    int wAlt = altGlyphStrWidth(altDisplay.c_str());
+    if (wAlt < 0) { u8g2.setFont(u8g2_font_fub30_tr); wAlt = u8g2.getStrWidth(altDisplay.c_str()); }
+    int xPosAlt = (128 - wAlt) / 2;
     if (xPosAlt < 0) xPosAlt = 0;
-    u8g2.setCursor(xPosAlt, 50);
-    u8g2.print(altDisplay);
+    if (!altGlyphDrawStr(u8g2, xPosAlt, 50, altDisplay.c_str())) {
+      u8g2.setFont(u8g2_font_fub30_tr);
+      u8g2.setCursor(xPosAlt, 50);
+      u8g2.print(altDisplay);
+    }
 
     // Dibujar bordes (opcional)
     u8g2.drawHLine(0, 15, 128);
@@ -606,7 +615,7 @@ void updateUI() {
       u8g2.drawGlyph(26, 63, 79);
     }
 
-    u8g2.sendBuffer();
+    oledStreamSubmit();
   } else {
     // Menú / Batería / Edición
     if (editingOffset) {
@@ -634,7 +643,7 @@ void updateUI() {
         u8g2.print(pct);
         u8g2.print("%");
 
-        u8g2.sendBuffer();
+        oledStreamSubmit();
 
         if (digitalRead(BUTTON_OLED) == LOW) {
           delay(50);
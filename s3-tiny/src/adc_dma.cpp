@@ -0,0 +1,390 @@
+#include "adc_dma.h"
+#include <esp_idf_version.h>
+#include <esp_timer.h>
+#include "config.h"
+#include "charge_detect.h"
+
+// IDF 5: esp_adc/adc_continuous. IDF 4.4 (core Arduino 2.x, el de
+// platformio.ini): adc_digi_* del S3, misma ráfaga y formato TYPE2.
+#if ESP_IDF_VERSION_MAJOR >= 5
+  #define ADC_DMA_DRIVER  5
+#elif ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 4, 0) && CONFIG_IDF_TARGET_ESP32S3
+  #define ADC_DMA_DRIVER  4
+#else
+  #define ADC_DMA_DRIVER  0
+#endif
+
+#if ADC_DMA_ENABLE && ADC_DMA_DRIVER
+#include "soc/soc_caps.h"
+#if ADC_DMA_DRIVER == 5
+  #include "esp_adc/adc_continuous.h"
+  #include "esp_adc/adc_cali.h"
+  #include "esp_adc/adc_cali_scheme.h"
+#else
+  #include "driver/adc.h"
+  #include "esp_adc_cal.h"
+#endif
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+  #define ADC_DMA_ATTEN  ADC_ATTEN_DB_12
+#else
+  #define ADC_DMA_ATTEN  ADC_ATTEN_DB_11
+#endif
+
+#ifndef SOC_ADC_DIGI_RESULT_BYTES
+  #define SOC_ADC_DIGI_RESULT_BYTES  4    // S3: resultado TYPE2 de 32 bits
+#endif
+
+static constexpr uint32_t FRAME_BYTES = ADC_DMA_FRAME_RESULTS * SOC_ADC_DIGI_RESULT_BYTES;
+
+// ------------------------------
+// Canales
+// ------------------------------
+struct DmaChan {
+  int            gpio;
+  uint8_t        unit;         // unidad del patrón (0 = ADC1), como en TYPE2
+  uint8_t        ch;
+  bool           dma;          // va en el patrón del DMA
+#if ADC_DMA_DRIVER == 5
+  adc_cali_handle_t cali;
+#else
+  bool           caliOk;
+  esp_adc_cal_characteristics_t cali;
+#endif
+  uint16_t       raw[ADC_DMA_FRAME_RESULTS];
+  uint16_t       n;
+};
+enum { CH_BAT = 0, CH_VBUS, CH_COUNT };
+static DmaChan s_ch[CH_COUNT] = {
+  { BATTERY_PIN,    0, 0, false },
+  { CHARGE_ADC_PIN, 0, 0, false },
+};
+
+static TaskHandle_t            s_task = nullptr;
+static uint8_t                 s_frame[FRAME_BYTES];
+
+static volatile bool s_hold = false;    // adcDmaPause(): no empezar ráfagas
+static volatile bool s_busy = false;    // ráfaga en curso
+
+// ------------------------------
+// Driver continuo
+// ------------------------------
+#if ADC_DMA_DRIVER == 5
+static adc_continuous_handle_t s_h = nullptr;
+
+static bool drvChanSetup(DmaChan& c) {
+  adc_unit_t unit;
+  adc_channel_t ch;
+  if (adc_continuous_io_to_channel(c.gpio, &unit, &ch) != ESP_OK) return false;
+#ifdef SOC_ADC_DIG_SUPPORTED_UNIT
+  if (!SOC_ADC_DIG_SUPPORTED_UNIT(unit)) return false;
+#endif
+  c.unit = (uint8_t)unit;
+  c.ch   = (uint8_t)ch;
+  c.cali = nullptr;
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+  adc_cali_curve_fitting_config_t cc = {};
+  cc.unit_id  = unit;
+  cc.atten    = ADC_DMA_ATTEN;
+  cc.bitwidth = ADC_BITWIDTH_DEFAULT;
+  if (adc_cali_create_scheme_curve_fitting(&cc, &c.cali) != ESP_OK) c.cali = nullptr;
+#endif
+  return true;
+}
+
+static bool drvOpen(adc_digi_pattern_config_t* pat, uint8_t n, bool unit1, bool unit2) {
+  adc_continuous_handle_cfg_t hc = {};
+  hc.max_store_buf_size = FRAME_BYTES * 2;
+  hc.conv_frame_size    = FRAME_BYTES;
+  if (adc_continuous_new_handle(&hc, &s_h) != ESP_OK) return false;
+
+  adc_continuous_config_t cfg = {};
+  cfg.pattern_num    = n;
+  cfg.adc_pattern    = pat;
+  cfg.sample_freq_hz = ADC_DMA_BURST_HZ;
+  cfg.conv_mode      = (unit1 && unit2) ? ADC_CONV_ALTER_UNIT
+                     : (unit1 ? ADC_CONV_SINGLE_UNIT_1 : ADC_CONV_SINGLE_UNIT_2);
+  cfg.format         = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+  if (adc_continuous_config(s_h, &cfg) != ESP_OK) {
+    adc_continuous_deinit(s_h);
+    s_h = nullptr;
+    return false;
+  }
+  return true;
+}
+
+static void drvStart() { adc_continuous_start(s_h); }
+
+static esp_err_t drvRead(uint8_t* buf, uint32_t* got, uint32_t timeoutMs) {
+  return adc_continuous_read(s_h, buf, FRAME_BYTES, got, timeoutMs);
+}
+
+static void drvStop() {
+  adc_continuous_stop(s_h);
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+  adc_continuous_flush_pool(s_h);
+#endif
+}
+
+static uint32_t rawToMv(const DmaChan& c, int raw) {
+  int mv = 0;
+  if (c.cali && adc_cali_raw_to_voltage(c.cali, raw, &mv) == ESP_OK) return (uint32_t)mv;
+  return (uint32_t)raw * 3100u / 4095u;  // sin calibración: escala nominal a 11/12 dB
+}
+
+#else  // ADC_DMA_DRIVER == 4
+
+// IDF 4.4: sólo ADC1 en el patrón (el ADC2 del S3 no va por DMA)
+static bool drvChanSetup(DmaChan& c) {
+  const int8_t ch = digitalPinToAnalogChannel(c.gpio);
+  if (ch < 0 || ch >= SOC_ADC_CHANNEL_NUM(0)) return false;
+  c.unit   = 0;
+  c.ch     = (uint8_t)ch;
+  c.caliOk = esp_adc_cal_characterize(ADC_UNIT_1, ADC_DMA_ATTEN, ADC_WIDTH_BIT_12,
+                                      1100, &c.cali) != ESP_ADC_CAL_VAL_DEFAULT_VREF;
+  return true;
+}
+
+static bool drvOpen(adc_digi_pattern_config_t* pat, uint8_t n, bool unit1, bool /*unit2*/) {
+  if (!unit1) return false;
+  adc_digi_init_config_t ic = {};
+  ic.max_store_buf_size = FRAME_BYTES * 2;
+  ic.conv_num_each_intr = FRAME_BYTES;      // en 4.4 son bytes por frame
+  for (uint8_t i = 0; i < n; ++i) ic.adc1_chan_mask |= BIT(pat[i].channel);
+  if (adc_digi_initialize(&ic) != ESP_OK) return false;
+
+  adc_digi_configuration_t cfg = {};
+  cfg.conv_limit_en  = false;               // el S3 no usa el límite de conversiones
+  cfg.conv_limit_num = 250;
+  cfg.pattern_num    = n;
+  cfg.adc_pattern    = pat;
+  cfg.sample_freq_hz = ADC_DMA_BURST_HZ;
+  cfg.conv_mode      = ADC_CONV_SINGLE_UNIT_1;
+  cfg.format         = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+  if (adc_digi_controller_configure(&cfg) != ESP_OK) {
+    adc_digi_deinitialize();
+    return false;
+  }
+  return true;
+}
+
+static void drvStart() { adc_digi_start(); }
+
+static esp_err_t drvRead(uint8_t* buf, uint32_t* got, uint32_t timeoutMs) {
+  const esp_err_t e = adc_digi_read_bytes(buf, FRAME_BYTES, got, timeoutMs);
+  // INVALID_STATE: el pool se desbordó; lo leído es válido
+  return (e == ESP_ERR_INVALID_STATE && *got > 0) ? ESP_OK : e;
+}
+
+static void drvStop() { adc_digi_stop(); }
+
+static uint32_t rawToMv(const DmaChan& c, int raw) {
+  if (c.caliOk) return esp_adc_cal_raw_to_voltage((uint32_t)raw, &c.cali);
+  return (uint32_t)raw * 3100u / 4095u;  // sin calibración: escala nominal a 11 dB
+}
+
+#endif
+
+// ------------------------------
+// Resultados publicados
+// ------------------------------
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_batMv   = 0;
+static uint32_t s_vbusMv  = 0;
+static int      s_vbusRaw = 0;
+static uint32_t s_seq     = 0;          // ráfagas publicadas
+
+// Estadísticas
+static uint32_t s_bursts   = 0;
+static uint32_t s_timeouts = 0;
+static uint32_t s_lastUs   = 0;         // última ráfaga: arranque -> frame
+static uint16_t s_batSpread  = 0;       // max-min crudo de la última ráfaga
+static uint16_t s_vbusSpread = 0;
+
+// ------------------------------
+// Filtros sobre el bloque
+// ------------------------------
+static void sortRaw(uint16_t* v, uint16_t n) {
+  for (uint16_t i = 1; i < n; ++i) {    // n <= 64: inserción basta
+    const uint16_t x = v[i];
+    int j = (int)i - 1;
+    while (j >= 0 && v[j] > x) { v[j + 1] = v[j]; --j; }
+    v[j + 1] = x;
+  }
+}
+
+static uint16_t trimmedMean(const uint16_t* sorted, uint16_t n) {
+  const uint16_t cut = (uint16_t)((n * ADC_DMA_TRIM_PCT) / 100);
+  uint32_t acc = 0;
+  for (uint16_t i = cut; i < n - cut; ++i) acc += sorted[i];
+  return (uint16_t)(acc / (uint32_t)(n - 2 * cut));
+}
+
+static uint16_t median(const uint16_t* sorted, uint16_t n) {
+  return (n & 1) ? sorted[n / 2] : (uint16_t)((sorted[n / 2 - 1] + sorted[n / 2]) / 2);
+}
+
+static void processFrame(uint32_t len) {
+  for (uint8_t i = 0; i < CH_COUNT; ++i) s_ch[i].n = 0;
+
+  for (uint32_t off = 0; off + SOC_ADC_DIGI_RESULT_BYTES <= len; off += SOC_ADC_DIGI_RESULT_BYTES) {
+    const adc_digi_output_data_t* d = (const adc_digi_output_data_t*)&s_frame[off];
+    for (uint8_t i = 0; i < CH_COUNT; ++i) {
+      DmaChan& c = s_ch[i];
+      if (c.dma && d->type2.unit == (uint32_t)c.unit && d->type2.channel == (uint32_t)c.ch &&
+          c.n < ADC_DMA_FRAME_RESULTS) {
+        c.raw[c.n++] = (uint16_t)d->type2.data;
+      }
+    }
+  }
+
+  DmaChan& b = s_ch[CH_BAT];
+  DmaChan& v = s_ch[CH_VBUS];
+  uint32_t batMv = 0, vbusMv = 0;
+  int vbusRaw = 0;
+  if (b.n) {
+    sortRaw(b.raw, b.n);
+    batMv = rawToMv(b, trimmedMean(b.raw, b.n));
+    s_batSpread = b.raw[b.n - 1] - b.raw[0];
+  }
+  if (v.n) {
+    sortRaw(v.raw, v.n);
+    vbusRaw = median(v.raw, v.n);
+    vbusMv  = rawToMv(v, vbusRaw);
+    s_vbusSpread = v.raw[v.n - 1] - v.raw[0];
+  }
+
+  portENTER_CRITICAL(&s_mux);
+  if (b.n) s_batMv = batMv;
+  if (v.n) { s_vbusMv = vbusMv; s_vbusRaw = vbusRaw; }
+  s_seq++;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+// ------------------------------
+// Tarea de ráfagas
+// ------------------------------
+static void adcDmaTask(void*) {
+  for (;;) {
+    s_busy = true;
+    if (!s_hold) {
+      const int64_t t0 = esp_timer_get_time();
+      uint32_t got = 0;
+      drvStart();
+      // Bloqueada hasta el frame: la CPU queda libre durante la conversión
+      const esp_err_t e = drvRead(s_frame, &got, 20);
+      s_lastUs = (uint32_t)(esp_timer_get_time() - t0);
+
+      // Frames de más de esta ráfaga: fuera antes de parar, o la próxima
+      // lectura devolvería datos viejos
+      uint32_t drop = 0;
+      static uint8_t s_sink[FRAME_BYTES];
+      while (drvRead(s_sink, &drop, 0) == ESP_OK) {}
+      drvStop();
+
+      s_bursts++;
+      if (e == ESP_OK && got > 0) processFrame(got);
+      else                        s_timeouts++;
+    }
+    s_busy = false;
+    vTaskDelay(pdMS_TO_TICKS(ADC_DMA_PERIOD_MS));
+  }
+}
+
+// ------------------------------
+// API
+// ------------------------------
+bool adcDmaBegin() {
+  if (s_task) return true;
+
+  adc_digi_pattern_config_t pat[CH_COUNT] = {};
+  uint8_t n = 0;
+  bool unit1 = false, unit2 = false;
+  for (uint8_t i = 0; i < CH_COUNT; ++i) {
+    if (!drvChanSetup(s_ch[i])) {
+      Serial.printf("[ADC] GPIO%d sin DMA: sigue por analogRead\n", s_ch[i].gpio);
+      continue;
+    }
+    s_ch[i].dma      = true;
+    pat[n].atten     = ADC_DMA_ATTEN;
+    pat[n].channel   = (uint8_t)s_ch[i].ch;
+    pat[n].unit      = (uint8_t)s_ch[i].unit;
+    pat[n].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    if (s_ch[i].unit == 0) unit1 = true;
+    else                   unit2 = true;
+    n++;
+  }
+  if (n == 0) return false;
+
+  if (!drvOpen(pat, n, unit1, unit2)) {
+    Serial.println("[ADC] driver continuo no disponible: analogRead");
+    for (uint8_t i = 0; i < CH_COUNT; ++i) s_ch[i].dma = false;
+    return false;
+  }
+
+  xTaskCreatePinnedToCore(adcDmaTask, "adc", 3072, nullptr, ADC_DMA_TASK_PRIO, &s_task, 0);
+
+  // Primera ráfaga antes de que batería/VBUS dejen analogRead
+  const uint32_t t0 = millis();
+  while (s_seq == 0 && (millis() - t0) < 50) vTaskDelay(1);
+  Serial.printf("[ADC] DMA: bateria=%d vbus=%d (%u Hz, %u conv. cada %lu ms)\n",
+                (int)s_ch[CH_BAT].dma, (int)s_ch[CH_VBUS].dma, (unsigned)ADC_DMA_BURST_HZ,
+                (unsigned)ADC_DMA_FRAME_RESULTS, (unsigned long)ADC_DMA_PERIOD_MS);
+  return s_seq > 0;
+}
+
+bool adcDmaBatteryMv(uint32_t &mv) {
+  if (!s_ch[CH_BAT].dma || s_seq == 0) return false;
+  portENTER_CRITICAL(&s_mux);
+  mv = s_batMv;
+  portEXIT_CRITICAL(&s_mux);
+  return true;
+}
+
+bool adcDmaVbusMv(uint32_t &mv, uint32_t &vbusSeq) {
+  if (!s_ch[CH_VBUS].dma || s_seq == 0) return false;
+  portENTER_CRITICAL(&s_mux);
+  mv      = s_vbusMv;
+  vbusSeq = s_seq;
+  portEXIT_CRITICAL(&s_mux);
+  return true;
+}
+
+bool adcDmaVbusRaw(int &raw) {
+  if (!s_ch[CH_VBUS].dma || s_seq == 0) return false;
+  raw = s_vbusRaw;
+  return true;
+}
+
+bool adcDmaPause(uint32_t timeoutMs) {
+  if (!s_task) return true;
+  s_hold = true;
+  const uint32_t t0 = millis();
+  while (s_busy) {
+    if ((millis() - t0) >= timeoutMs) return false;
+    vTaskDelay(1);
+  }
+  return true;
+}
+
+void adcDmaResume() { s_hold = false; }
+
+void adcDmaDump() {
+  if (!s_task) { Serial.println("[ADC] DMA inactivo: batería/VBUS por analogRead"); return; }
+  Serial.printf("[ADC] rafagas=%lu timeouts=%lu ultima=%luus bateria=%lumV (dispersion %u) vbus=%lumV (dispersion %u)%s\n",
+                (unsigned long)s_bursts, (unsigned long)s_timeouts, (unsigned long)s_lastUs,
+                (unsigned long)s_batMv, (unsigned)s_batSpread,
+                (unsigned long)s_vbusMv, (unsigned)s_vbusSpread, s_hold ? " [pausa]" : "");
+}
+
+#else  // sin DMA: todo sigue por analogRead
+
+bool adcDmaBegin() { return false; }
+bool adcDmaBatteryMv(uint32_t &) { return false; }
+bool adcDmaVbusMv(uint32_t &, uint32_t &) { return false; }
+bool adcDmaVbusRaw(int &) { return false; }
+bool adcDmaPause(uint32_t) { return true; }
+void adcDmaResume() {}
+void adcDmaDump() { Serial.println("[ADC] DMA deshabilitado (ADC_DMA_ENABLE=0 o IDF < 4.4)"); }
+
+#endif
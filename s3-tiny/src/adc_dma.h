@@ -0,0 +1,63 @@
+#ifndef ADC_DMA_H
+#define ADC_DMA_H
+
+// =====================================================
+// Batería y VBUS por ADC continuo (DMA) en segundo plano
+// -----------------------------------------------------
+// Una tarea hace cada ADC_DMA_PERIOD_MS una ráfaga corta
+// (ADC_DMA_BURST_HZ, ADC_DMA_FRAME_RESULTS conversiones
+// alternando canales) con el driver continuo del IDF y
+// espera el frame bloqueada: la CPU queda en IDLE durante
+// la conversión y entre ráfagas el ADC está parado.
+// Sobre el bloque DMA:
+//  - batería: media recortada (ADC_DMA_TRIM_PCT por lado),
+//  - VBUS: mediana (un glitch del cargador no mueve nada).
+// Los módulos leen el último resultado sin esperar.
+//
+// Driver: esp_adc/adc_continuous con IDF >= 5.0; adc_digi_*
+// con IDF 4.4 (core Arduino 2.x, el de platformio.ini). Si
+// el driver no arranca, o la unidad ADC del pin no admite
+// DMA (VBUS en GPIO11 es ADC2), ese canal sigue por
+// analogRead.
+// 'a' por Serial: estadísticas de ráfagas.
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef ADC_DMA_ENABLE
+  #define ADC_DMA_ENABLE         1
+#endif
+#ifndef ADC_DMA_PERIOD_MS
+  #define ADC_DMA_PERIOD_MS      100UL   // = CHARGE_UPDATE_INTERVAL_MS
+#endif
+#ifndef ADC_DMA_BURST_HZ
+  #define ADC_DMA_BURST_HZ       20000   // ~3 ms por ráfaga
+#endif
+#ifndef ADC_DMA_FRAME_RESULTS
+  #define ADC_DMA_FRAME_RESULTS  64      // conversiones por ráfaga (todos los canales)
+#endif
+#ifndef ADC_DMA_TRIM_PCT
+  #define ADC_DMA_TRIM_PCT       25      // media recortada: descarta 25 % por cada lado
+#endif
+#ifndef ADC_DMA_TASK_PRIO
+  #define ADC_DMA_TASK_PRIO      1
+#endif
+
+// En setup(), tras batteryInit() y chargeDetectBegin() (primeras
+// medidas por analogRead). Espera la primera ráfaga; false = sin DMA.
+bool adcDmaBegin();
+
+// Último resultado en mV en el pin; false si el canal no va por DMA.
+// vbusSeq cambia con cada ráfaga (para no contar dos veces la misma).
+bool adcDmaBatteryMv(uint32_t &mv);
+bool adcDmaVbusMv(uint32_t &mv, uint32_t &vbusSeq);
+bool adcDmaVbusRaw(int &raw);
+
+// Antes de light/deep sleep: no empieza más ráfagas y espera la
+// que esté en curso. adcDmaResume() al volver.
+bool adcDmaPause(uint32_t timeoutMs);
+void adcDmaResume();
+
+void adcDmaDump();
+
+#endif // ADC_DMA_H
@@ -0,0 +1,149 @@
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "config.h"
+#include "alt_history.h"
+#include "altHistoryUi.h"
+#include "lcd_flush.h"
+#include "ui_strings.h"
+
+// --- Dependencias externas ---
+extern bool unidadMetros;          // config.cpp
+extern long lastMenuInteraction;   // ui_module.cpp
+
+// --- Área de la gráfica (dentro del marco) ---
+static const int PLOT_X0 = 2;
+static const int PLOT_W  = 124;
+static const int PLOT_Y0 = 16;
+static const int PLOT_H  = 46;     // 16..61
+static const int16_t MIN_SPAN_HM = 20;   // 10 m: no amplificar ruido en tierra
+
+// --- Estado ---
+static bool       s_active    = false;
+static AltHistRes s_res       = ALT_HIST_FINE;
+static uint32_t   s_drawnRev  = 0;
+static bool       s_dirty     = true;
+static bool       s_pendingExit = false;
+static bool       s_altPrev = false, s_menuPrev = false;
+
+// min/max por columna (medios metros); mn > mx => columna vacía
+static int16_t s_colMn[PLOT_W];
+static int16_t s_colMx[PLOT_W];
+
+static inline bool btnHigh(int pin) { return digitalRead(pin) == HIGH; }
+
+// Agrupa los cubos en PLOT_W columnas; el más reciente a la derecha
+static bool buildColumns(int16_t& lo, int16_t& hi) {
+  for (int c = 0; c < PLOT_W; ++c) { s_colMn[c] = INT16_MAX; s_colMx[c] = INT16_MIN; }
+  lo = INT16_MAX; hi = INT16_MIN;
+
+  const uint16_t cap = altHistoryCapacity(s_res);
+  const uint16_t n   = altHistoryCount(s_res);
+  AltHistBucket b;
+  for (uint16_t i = 0; i < n; ++i) {
+    if (!altHistoryGet(s_res, i, b) || b.empty()) continue;
+    const int c = PLOT_W - 1 - (int)(((uint32_t)i * PLOT_W) / cap);
+    if (b.mn < s_colMn[c]) s_colMn[c] = b.mn;
+    if (b.mx > s_colMx[c]) s_colMx[c] = b.mx;
+    if (b.mn < lo) lo = b.mn;
+    if (b.mx > hi) hi = b.mx;
+  }
+  return lo <= hi;
+}
+
+static void formatHm(char* out, size_t n, int16_t hm) {
+  const float m = hm * 0.5f;
+  snprintf(out, n, "%ld", (long)lroundf(unidadMetros ? m : m * 3.281f));
+}
+
+static void draw(U8G2 &u8g2) {
+  u8g2.clearBuffer();
+
+  u8g2.drawHLine(0, 0, 128);
+  u8g2.drawHLine(0, 13, 128);
+  u8g2.drawHLine(0, 63, 128);
+  u8g2.drawVLine(0, 0, 64);
+  u8g2.drawVLine(127, 0, 64);
+
+  u8g2.setFont(u8g2_font_5x8_mf);
+  u8g2.setCursor(2, 10);
+  u8g2.print(tr(STR_HISTORY));
+  u8g2.print(s_res == ALT_HIST_FINE ? " 10 min" : " 24 h");
+
+  int16_t lo, hi;
+  if (!buildColumns(lo, hi)) {
+    u8g2.setFont(u8g2_font_ncenB08_tr);
+    u8g2.setCursor(10, 40); u8g2.print(tr(STR_HIST_NO_DATA));
+    lcdFlush();
+    return;
+  }
+
+  // Rango en la cabecera: "min..max m"
+  char sLo[8], sHi[8], rng[24];
+  formatHm(sLo, sizeof(sLo), lo);
+  formatHm(sHi, sizeof(sHi), hi);
+  snprintf(rng, sizeof(rng), "%s..%s %s", sLo, sHi, unidadMetros ? "m" : "ft");
+  u8g2.setCursor(126 - u8g2.getStrWidth(rng), 10);
+  u8g2.print(rng);
+
+  // Escala vertical con span mínimo centrado
+  if (hi - lo < MIN_SPAN_HM) {
+    const int16_t mid = (int16_t)((lo + hi) / 2);
+    lo = (int16_t)(mid - MIN_SPAN_HM / 2);
+    hi = (int16_t)(lo + MIN_SPAN_HM);
+  }
+  const int32_t span = (int32_t)hi - lo;
+  const int yBot = PLOT_Y0 + PLOT_H - 1;
+
+  for (int c = 0; c < PLOT_W; ++c) {
+    if (s_colMn[c] > s_colMx[c]) continue;
+    const int yMn = yBot - (int)(((int32_t)s_colMn[c] - lo) * (PLOT_H - 1) / span);
+    const int yMx = yBot - (int)(((int32_t)s_colMx[c] - lo) * (PLOT_H - 1) / span);
+    u8g2.drawVLine(PLOT_X0 + c, yMx, yMn - yMx + 1);
+  }
+
+  lcdFlush();
+}
+
+// ------- API -------
+void altHistoryUiOpen() {
+  s_active      = true;
+  s_res         = ALT_HIST_FINE;
+  s_dirty       = true;
+  s_pendingExit = false;
+  // Primar prevs: el botón que abrió la pantalla no cuenta como flanco
+  s_altPrev  = btnHigh(BUTTON_ALTITUDE);
+  s_menuPrev = btnHigh(BUTTON_MENU);
+  lastMenuInteraction = millis();
+}
+
+bool altHistoryUiIsActive() { return s_active; }
+
+void altHistoryUiDrawAndHandle(U8G2 &u8g2) {
+  if (!s_active) return;
+  lastMenuInteraction = millis();
+
+  const bool altDown  = btnHigh(BUTTON_ALTITUDE);
+  const bool menuDown = btnHigh(BUTTON_MENU);
+  const bool altRise  = altDown  && !s_altPrev;
+  const bool menuRise = menuDown && !s_menuPrev;
+  s_altPrev = altDown; s_menuPrev = menuDown;
+  if (altRise || menuRise) lcdFlushMarkInput();
+
+  // Salida diferida hasta soltar MENU
+  if (menuRise) s_pendingExit = true;
+  if (s_pendingExit) {
+    if (!menuDown) { s_pendingExit = false; s_active = false; }
+    return;
+  }
+
+  if (altRise) {
+    s_res   = (s_res == ALT_HIST_FINE) ? ALT_HIST_COARSE : ALT_HIST_FINE;
+    s_dirty = true;
+  }
+
+  const uint32_t rev = altHistoryRev(s_res);
+  if (!s_dirty && rev == s_drawnRev) return;
+  s_dirty    = false;
+  s_drawnRev = rev;
+  draw(u8g2);
+}
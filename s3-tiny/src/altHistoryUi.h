@@ -0,0 +1,15 @@
+#pragma once
+#include <U8g2lib.h>
+
+// Pantalla "Historial": sparkline min/max de alt_history
+//   ALT  -> alterna 10 min (1 s) / 24 h (1 min)
+//   MENU -> salir (al soltar)
+// Sólo repinta al cerrarse un cubo nuevo o al cambiar de vista.
+// Mientras está activa, processMenu() (ui_module) sólo sigue los
+// botones y retorna, como con bitácora y fecha/hora: si no, MENU
+// volvería a ejecutar "Historial" y ALT movería el cursor oculto.
+// Secuencia a comprobar: MENU (abrir) -> ALT (24 h) -> MENU
+// (al soltar vuelve al menú en "Historial", sin saveConfig()).
+void altHistoryUiOpen();
+bool altHistoryUiIsActive();
+void altHistoryUiDrawAndHandle(U8G2 &u8g2);
@@ -0,0 +1,132 @@
+#include "alt_glyph_cache.h"
+#include <string.h>
+
+// ------------------------------
+// Estado
+// ------------------------------
+static const char kGlyphs[] = "0123456789.-";
+static constexpr uint8_t N_GLYPHS = sizeof(kGlyphs) - 1;
+static constexpr int     CAP_X    = 8;        // pluma al capturar (margen para x_offset < 0)
+
+struct CachedGlyph {
+  int8_t   colStart;   // primera columna con tinta, relativa a la pluma
+  uint8_t  cols;       // columnas con tinta
+  uint8_t  advance;    // avance de pluma (dx)
+  uint8_t  lastW;      // ancho si es el último carácter (glyph_w + x_off)
+  uint8_t  page0;      // primera página de dispositivo
+  uint8_t  pages;      // páginas ocupadas
+  uint16_t off;        // offset en s_pool: cols * pages bytes, por columna
+};
+
+static CachedGlyph s_g[N_GLYPHS];
+static uint8_t     s_pool[ALT_GLYPH_POOL_BYTES];
+static bool        s_ready    = false;
+static bool        s_flip     = false;        // U8G2_R2: x e y invertidos
+static int         s_baseline = 0;
+
+static inline int glyphIndex(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c == '.') return 10;
+  if (c == '-') return 11;
+  return -1;
+}
+
+static inline int devCol(int x) { return s_flip ? (127 - x) : x; }
+
+// ------------------------------
+// Construcción
+// ------------------------------
+bool altGlyphCacheBuild(U8G2 &g, const uint8_t* font, int baseline) {
+  s_ready = false;
+  const u8g2_cb_t* rot = g.getU8g2()->cb;
+  if (rot != U8G2_R0 && rot != U8G2_R2) return false;
+  s_flip     = (rot == U8G2_R2);
+  s_baseline = baseline;
+
+  uint8_t* buf = g.getBufferPtr();
+  const int tilesW = g.getBufferTileWidth();
+  if (tilesW != 16 || g.getBufferTileHeight() != 8) return false;
+
+  g.setFont(font);   // buffer limpio: da igual modo sólido/transparente
+
+  uint16_t used = 0;
+  for (uint8_t i = 0; i < N_GLYPHS; ++i) {
+    const char one[2] = { kGlyphs[i], '\0' };
+    const char two[3] = { kGlyphs[i], kGlyphs[i], '\0' };
+    const int w1 = g.getStrWidth(one);
+    const int w2 = g.getStrWidth(two);
+
+    g.clearBuffer();
+    g.drawStr(CAP_X, baseline, one);
+
+    // Columnas y páginas con tinta (espacio lógico -> dispositivo)
+    int cMin = 128, cMax = -1, pMin = 8, pMax = -1;
+    for (int x = 0; x < 128; ++x) {
+      const int dc = devCol(x);
+      for (int p = 0; p < 8; ++p) {
+        if (!buf[p * 128 + dc]) continue;
+        if (x < cMin) cMin = x;
+        if (x > cMax) cMax = x;
+        if (p < pMin) pMin = p;
+        if (p > pMax) pMax = p;
+      }
+    }
+
+    CachedGlyph &cg = s_g[i];
+    cg.advance = (uint8_t)(w2 - w1);
+    cg.lastW   = (uint8_t)w1;
+    if (cMax < 0) { cg.cols = 0; cg.pages = 0; cg.colStart = 0; cg.page0 = 0; cg.off = used; continue; }
+
+    cg.colStart = (int8_t)(cMin - CAP_X);
+    cg.cols     = (uint8_t)(cMax - cMin + 1);
+    cg.page0    = (uint8_t)pMin;
+    cg.pages    = (uint8_t)(pMax - pMin + 1);
+    cg.off      = used;
+
+    const uint16_t need = (uint16_t)cg.cols * cg.pages;
+    if (used + need > sizeof(s_pool)) { g.clearBuffer(); return false; }
+    for (int c = 0; c < cg.cols; ++c) {
+      const int dc = devCol(cMin + c);
+      for (int p = 0; p < cg.pages; ++p) s_pool[used++] = buf[(cg.page0 + p) * 128 + dc];
+    }
+  }
+
+  g.clearBuffer();
+  s_ready = true;
+  return true;
+}
+
+bool altGlyphCacheReady() { return s_ready; }
+
+// ------------------------------
+// Uso
+// ------------------------------
+int altGlyphStrWidth(const char* s) {
+  if (!s_ready || !s || !*s) return -1;
+  int w = 0;
+  for (; *s; ++s) {
+    const int gi = glyphIndex(*s);
+    if (gi < 0) return -1;
+    w += (s[1] ? s_g[gi].advance : s_g[gi].lastW);
+  }
+  return w;
+}
+
+bool altGlyphDrawStr(U8G2 &g, int x, int baseline, const char* s) {
+  if (!s_ready || baseline != s_baseline || altGlyphStrWidth(s) < 0) return false;
+
+  uint8_t* buf = g.getBufferPtr();
+  for (; *s; ++s) {
+    const CachedGlyph &cg = s_g[glyphIndex(*s)];
+    const uint8_t* src = &s_pool[cg.off];
+    const int x0 = x + cg.colStart;
+    for (int c = 0; c < cg.cols; ++c, src += cg.pages) {
+      const int lx = x0 + c;
+      if (lx < 0 || lx > 127) continue;
+      uint8_t* dst = buf + cg.page0 * 128 + devCol(lx);
+      for (int p = 0; p < cg.pages; ++p, dst += 128) *dst |= src[p];
+    }
+    x += cg.advance;
+  }
+  return true;
+}
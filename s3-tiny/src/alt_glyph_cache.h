@@ -0,0 +1,37 @@
+#ifndef ALT_GLYPH_CACHE_H
+#define ALT_GLYPH_CACHE_H
+
+// =====================================================
+// Caché de glifos pre-rasterizados para la altitud grande
+// -----------------------------------------------------
+// La altitud del HUD usa siempre la misma fuente, la misma
+// línea base y 12 glifos ("0123456789.-"). Se rasterizan una
+// vez (altGlyphCacheBuild, tras u8g2.begin()) con el propio
+// u8g2 y se guardan como columnas del buffer de página (en
+// espacio de dispositivo, ya rotadas). Dibujar es copiar
+// bytes con OR columna a columna: sin decodificar la fuente.
+//
+// Anchos precalculados con la misma regla que getStrWidth().
+// Si la cadena tiene un glifo no cacheado, la rotación no es
+// R0/R2 o la línea base no coincide, altGlyphDrawStr()
+// devuelve false y el llamador usa u8g2 como siempre.
+// =====================================================
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+// Bytes de columna para los 12 glifos (fub30: ~12 x 24 col x 5 páginas)
+#ifndef ALT_GLYPH_POOL_BYTES
+  #define ALT_GLYPH_POOL_BYTES 2048
+#endif
+
+bool altGlyphCacheBuild(U8G2 &g, const uint8_t* font, int baseline);
+bool altGlyphCacheReady();
+
+// Ancho en px (como getStrWidth) o -1 si algún glifo no está
+int  altGlyphStrWidth(const char* s);
+
+// OR-blit en el buffer de g; false => usar u8g2
+bool altGlyphDrawStr(U8G2 &g, int x, int baseline, const char* s);
+
+#endif // ALT_GLYPH_CACHE_H
@@ -0,0 +1,96 @@
+#include "alt_history.h"
+#include <esp_heap_caps.h>
+#include <math.h>
+
+// ------------------------------
+// Estado
+// ------------------------------
+static const uint16_t kCap[ALT_HIST_RES_COUNT]      = { ALT_HIST_FINE_N, ALT_HIST_COARSE_N };
+static const uint32_t kPeriodMs[ALT_HIST_RES_COUNT] = { 1000UL, 60000UL };
+
+static AltHistBucket* s_ring[ALT_HIST_RES_COUNT]   = { nullptr, nullptr };
+static uint16_t       s_head[ALT_HIST_RES_COUNT]   = { 0, 0 };   // próximo a escribir
+static uint16_t       s_count[ALT_HIST_RES_COUNT]  = { 0, 0 };
+static uint32_t       s_rev[ALT_HIST_RES_COUNT]    = { 0, 0 };
+
+// Cubo abierto (periodo en curso)
+static AltHistBucket  s_open[ALT_HIST_RES_COUNT];
+static uint32_t       s_slot[ALT_HIST_RES_COUNT]   = { 0, 0 };
+static bool           s_started[ALT_HIST_RES_COUNT] = { false, false };
+
+static const AltHistBucket kEmpty = { INT16_MAX, INT16_MIN };
+
+static AltHistBucket* allocRing(uint16_t n) {
+  const size_t bytes = (size_t)n * sizeof(AltHistBucket);
+  void* p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!p) p = heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  return (AltHistBucket*)p;
+}
+
+static inline void push(uint8_t r, const AltHistBucket& b) {
+  s_ring[r][s_head[r]] = b;
+  s_head[r] = (uint16_t)((s_head[r] + 1) % kCap[r]);
+  if (s_count[r] < kCap[r]) s_count[r]++;
+}
+
+static void feed(uint8_t r, int16_t v, uint32_t now_ms) {
+  const uint32_t slot = now_ms / kPeriodMs[r];
+
+  if (!s_started[r]) {
+    s_started[r] = true;
+    s_slot[r] = slot;
+    s_open[r].mn = s_open[r].mx = v;
+    return;
+  }
+
+  if (slot == s_slot[r]) {
+    if (v < s_open[r].mn) s_open[r].mn = v;
+    if (v > s_open[r].mx) s_open[r].mx = v;
+    return;
+  }
+
+  // Cierra el cubo en curso y rellena los periodos sin muestras
+  push(r, s_open[r]);
+  uint32_t gap = (slot > s_slot[r]) ? (slot - s_slot[r] - 1) : 0;   // 0 si millis() dio la vuelta
+  if (gap > kCap[r]) gap = kCap[r];
+  for (uint32_t i = 0; i < gap; ++i) push(r, kEmpty);
+  s_rev[r]++;
+
+  s_slot[r] = slot;
+  s_open[r].mn = s_open[r].mx = v;
+}
+
+// ------------------------------
+// API
+// ------------------------------
+void altHistoryBegin() {
+  for (uint8_t r = 0; r < ALT_HIST_RES_COUNT; ++r) {
+    if (!s_ring[r]) s_ring[r] = allocRing(kCap[r]);
+    s_head[r] = s_count[r] = 0;
+    s_started[r] = false;
+    s_rev[r]++;
+  }
+  if (!s_ring[ALT_HIST_FINE] || !s_ring[ALT_HIST_COARSE])
+    Serial.println("[HIST] sin memoria: historial deshabilitado");
+}
+
+void altHistoryAdd(float alt_m, uint32_t now_ms) {
+  if (!s_ring[ALT_HIST_FINE] || !s_ring[ALT_HIST_COARSE] || !isfinite(alt_m)) return;
+  long hm = lroundf(alt_m * 2.0f);
+  if (hm >  INT16_MAX - 1) hm = INT16_MAX - 1;
+  if (hm < -INT16_MAX + 1) hm = -INT16_MAX + 1;
+  feed(ALT_HIST_FINE,   (int16_t)hm, now_ms);
+  feed(ALT_HIST_COARSE, (int16_t)hm, now_ms);
+}
+
+uint16_t altHistoryCapacity(AltHistRes r) { return (r < ALT_HIST_RES_COUNT) ? kCap[r] : 0; }
+uint16_t altHistoryCount(AltHistRes r)    { return (r < ALT_HIST_RES_COUNT) ? s_count[r] : 0; }
+uint32_t altHistoryPeriodMs(AltHistRes r) { return (r < ALT_HIST_RES_COUNT) ? kPeriodMs[r] : 0; }
+uint32_t altHistoryRev(AltHistRes r)      { return (r < ALT_HIST_RES_COUNT) ? s_rev[r] : 0; }
+
+bool altHistoryGet(AltHistRes r, uint16_t i, AltHistBucket& out) {
+  if (r >= ALT_HIST_RES_COUNT || !s_ring[r] || i >= s_count[r]) return false;
+  const uint16_t idx = (uint16_t)((s_head[r] + kCap[r] - 1 - i) % kCap[r]);
+  out = s_ring[r][idx];
+  return true;
+}
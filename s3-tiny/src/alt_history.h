@@ -0,0 +1,46 @@
+#ifndef ALT_HISTORY_H
+#define ALT_HISTORY_H
+
+// =====================================================
+// Historial de altitud multi-resolución (RAM fija)
+// -----------------------------------------------------
+// - Fino:   ALT_HIST_FINE_N cubos de 1 s    (10 min: último salto)
+// - Grueso: ALT_HIST_COARSE_N cubos de 1 min (24 h: deriva en tierra)
+// Cada cubo guarda min/max de la altitud relativa en medios
+// metros (int16: ±16 km). Los periodos sin muestras (sueño
+// largo) quedan como cubos vacíos. Los rings se reservan una
+// sola vez en altHistoryBegin(), en PSRAM si la placa la tiene
+// (S3 fh4r2) y si no en RAM interna (~8 KB).
+// Alimentar: O(1) por muestra desde updateSensorData().
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef ALT_HIST_FINE_N
+  #define ALT_HIST_FINE_N     600
+#endif
+#ifndef ALT_HIST_COARSE_N
+  #define ALT_HIST_COARSE_N  1440
+#endif
+
+enum AltHistRes : uint8_t { ALT_HIST_FINE = 0, ALT_HIST_COARSE = 1, ALT_HIST_RES_COUNT };
+
+struct AltHistBucket {
+  int16_t mn, mx;                     // medio metro; mn > mx => vacío
+  bool empty() const { return mn > mx; }
+};
+
+void altHistoryBegin();
+void altHistoryAdd(float alt_m, uint32_t now_ms);
+
+uint16_t altHistoryCapacity(AltHistRes r);
+uint16_t altHistoryCount(AltHistRes r);     // cubos cerrados (incluye vacíos)
+uint32_t altHistoryPeriodMs(AltHistRes r);
+
+// i = 0: cubo cerrado más reciente. false si i >= count
+bool altHistoryGet(AltHistRes r, uint16_t i, AltHistBucket& out);
+
+// Cambia cada vez que se cierra un cubo (para repintar sólo entonces)
+uint32_t altHistoryRev(AltHistRes r);
+
+#endif // ALT_HISTORY_H
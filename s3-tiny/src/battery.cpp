@@ -1,11 +1,14 @@
 // battery.cpp  (ESP32-S3: ADC "NG" via Arduino)
-// Usa solo analogRead*/analogSetPinAttenuation (sin adc1_*/esp_adc_cal_*)
+// Usa solo analogRead*/analogSetPinAttenuation (sin adc1_*/esp_adc_cal_*);
+// con adc_dma activo, batteryUpdate() toma su último resultado.
 
 #include <Arduino.h>     // millis(), delayMicroseconds(), analog*
 #include <math.h>        // floorf()
 #include "battery.h"
 #include "config.h"
 #include "charge_detect.h"  // isUsbPresent()
+#include "adc_dma.h"        // media recortada del DMA (si está activo)
+#include "power_governor.h" // corriente del modelo (caída I*R y autonomía)
 
 // ---------------------------------------------------------------------------------
 // Compatibilidad de constantes de atenuación entre cores (alias seguro):
@@ -31,6 +34,10 @@
 #define BATTERY_UPDATE_INTERVAL_MS 1000UL
 #endif
 
+#ifndef BATTERY_RINT_OHM
+#define BATTERY_RINT_OHM 0.20f          // celda + protección + cableado
+#endif
+
 // Umbrales pedidos
 static constexpr float VBAT_FULL_V     = 4.15f;
 static constexpr float VBAT_EMPTY_V    = 3.40f;
@@ -39,10 +46,12 @@ static constexpr int   LOW_PERCENT_THR = 5;
 
 // ========================= Estado interno =========================
 static float         s_vbat      = 0.0f;  // Volts
-static int           s_percent   = 0;     // % crudo (lineal por tensión)
+static float         s_vocv      = 0.0f;  // Volts, compensada por carga
+static int           s_percent   = 0;     // % crudo (tabla OCV)
 static unsigned long s_tLast     = 0;
 
 static int s_pctDisplay          = -1;    // % mostrado (monótono)
+static bool s_pctUncomp          = false; // % mostrado sembrado sin compensar
 
 // ========================= Utilidades =========================
 static inline uint32_t multisampleMilliVolts(uint8_t n = 8) {
@@ -54,18 +63,51 @@ static inline uint32_t multisampleMilliVolts(uint8_t n = 8) {
   return acc / (uint32_t)n;   // mV en el PIN (antes del divisor)
 }
 
+// Último bloque del DMA sin esperar; si no hay DMA, multimuestreo bloqueante
+static inline uint32_t readPinMilliVolts() {
+  uint32_t mV;
+  if (adcDmaBatteryMv(mV)) return mV;
+  return multisampleMilliVolts(8);
+}
+
 static inline float pinmV_to_vbatV(uint32_t mV_pin) {
   // pin ve Vbat / BATTERY_DIVIDER_RATIO
   const float v_pin = (float)mV_pin * 0.001f;      // mV -> V
   return v_pin * BATTERY_DIVIDER_RATIO;            // Vbat estimada
 }
 
-// Mapeo lineal solicitado: 3.40 V -> 0%, 4.15 V -> 100%
-static int voltageToPercent(float vbat) {
-  if (vbat <= VBAT_EMPTY_V) return 0;
-  if (vbat >= VBAT_FULL_V)  return 100;
-  const float span = VBAT_FULL_V - VBAT_EMPTY_V;
-  float p = (vbat - VBAT_EMPTY_V) * (100.0f / span);
+// Curva OCV–SoC de una LiPo 1S en reposo (descarga a ~C/5, 25 °C), con el
+// 0 % en VBAT_EMPTY_V y el 100 % en VBAT_FULL_V como el mapeo lineal anterior
+struct OcvPoint { float v; float pct; };
+static const OcvPoint kOcv[] = {
+  { 3.40f,   0.0f }, { 3.55f,   2.0f }, { 3.65f,   5.0f }, { 3.69f,  10.0f },
+  { 3.71f,  15.0f }, { 3.73f,  20.0f }, { 3.75f,  25.0f }, { 3.77f,  30.0f },
+  { 3.79f,  35.0f }, { 3.80f,  40.0f }, { 3.82f,  45.0f }, { 3.84f,  50.0f },
+  { 3.85f,  55.0f }, { 3.87f,  60.0f }, { 3.91f,  65.0f }, { 3.95f,  70.0f },
+  { 3.98f,  75.0f }, { 4.02f,  80.0f }, { 4.06f,  85.0f }, { 4.09f,  90.0f },
+  { 4.12f,  95.0f }, { 4.15f, 100.0f },
+};
+static constexpr uint8_t OCV_N = sizeof(kOcv) / sizeof(kOcv[0]);
+
+// Tensión en circuito abierto: la medida cae I*R con la carga del momento
+// (backlight, CPU a 160 MHz). Cargando, la tensión sube por la corriente de
+// carga y no se compensa: el filtro monótono ya sólo deja subir el %.
+// Sin estado de USB/carga (batteryInit() va antes que chargeDetectBegin()
+// y powerGovBegin(), y ds_housekeeping no los arranca) no se compensa.
+static inline bool compensationReady() { return chargeDetectStarted() && powerGovStarted(); }
+
+static float loadCompensatedV(float vbat) {
+  if (!compensationReady() || isUsbPresent()) return vbat;
+  return vbat + powerGovLoadMa() * 0.001f * BATTERY_RINT_OHM;
+}
+
+static int voltageToPercent(float vocv) {
+  if (vocv <= kOcv[0].v)         return 0;
+  if (vocv >= kOcv[OCV_N - 1].v) return 100;
+  uint8_t i = 1;
+  while (i < OCV_N - 1 && vocv > kOcv[i].v) ++i;
+  const OcvPoint &a = kOcv[i - 1], &b = kOcv[i];
+  const float p = a.pct + (vocv - a.v) * (b.pct - a.pct) / (b.v - a.v);
   int pct = (int)floorf(p + 1e-6f);
   return constrain(pct, 0, 100);
 }
@@ -79,27 +121,46 @@ void batteryInit() {
 
   const uint32_t mV  = multisampleMilliVolts(8);
   s_vbat             = pinmV_to_vbatV(mV);
-  s_percent          = voltageToPercent(s_vbat);
+  s_vocv             = loadCompensatedV(s_vbat);
+  s_percent          = voltageToPercent(s_vocv);
   s_pctDisplay       = s_percent;     // inicializa el % mostrado
+  s_pctUncomp        = !compensationReady();
   s_tLast            = millis();
 }
 
+// El filtro monótono sigue desde el % de antes de dormir (sin saltos al despertar)
+void batteryRestore(int pctDisplay) {
+  if (pctDisplay < 0 || pctDisplay > 100) return;
+  s_pctDisplay = pctDisplay;
+  s_pctUncomp  = false;
+}
+
 void batteryUpdate() {
   const unsigned long now = millis();
   if ((now - s_tLast) < BATTERY_UPDATE_INTERVAL_MS) return;
   s_tLast = now;
 
-  const uint32_t mV  = multisampleMilliVolts(8);
+  const uint32_t mV  = readPinMilliVolts();
   s_vbat             = pinmV_to_vbatV(mV);
-  s_percent          = voltageToPercent(s_vbat);
+  s_vocv             = loadCompensatedV(s_vbat);
+  s_percent          = voltageToPercent(s_vocv);
+
+  // Primera medida compensada: re-siembra el % que batteryInit() tomó
+  // sin compensar (si no, el filtro monótono lo dejaría bajo)
+  if (s_pctUncomp && compensationReady()) {
+    s_pctDisplay = s_percent;
+    s_pctUncomp  = false;
+  }
 }
 
+uint32_t batteryNextDueMs() { return (uint32_t)(s_tLast + BATTERY_UPDATE_INTERVAL_MS); }
+
 float batteryGetVoltage() {
   return s_vbat;
 }
 
 int batteryGetPercent() {
-  // % crudo según tu mapeo lineal
+  // % crudo según la tabla OCV
   int pct = s_percent;
   if (pct < 0)   pct = 0;
   if (pct > 100) pct = 100;
@@ -133,3 +194,20 @@ bool batteryShouldDeepSleep() {
   if (isUsbPresent()) return false;
   return (s_vbat <= VBAT_DEEPSLEEP);
 }
+
+// --- Predicción: capacidad restante con el consumo medido del gobernador ---
+float batteryGetOcvVoltage() {
+  return s_vocv;
+}
+
+float batteryRemainingHours() {
+  const float avgMa = powerGovAvgMa();
+  if (avgMa <= 0.0f || s_pctDisplay < 0) return -1.0f;
+  return (s_pctDisplay / 100.0f) * BATTERY_CAPACITY_MAH / avgMa;
+}
+
+int batteryRemainingJumps() {
+  const float perJump = powerGovMahPerJump();
+  if (perJump <= 0.0f || s_pctDisplay < 0) return -1;
+  return (int)((s_pctDisplay / 100.0f) * BATTERY_CAPACITY_MAH / perJump);
+}
@@ -1,13 +1,24 @@
 #pragma once
 #include <Arduino.h>
 
+#ifndef BATTERY_CAPACITY_MAH
+#define BATTERY_CAPACITY_MAH 400.0f     // LiPo 1S de la placa
+#endif
+
 // Inicialización / ciclo
 void  batteryInit();
 void  batteryUpdate();
+uint32_t batteryNextDueMs();   // millis() de la próxima medida (planificador)
+void  batteryRestore(int pctDisplay);  // tras batteryInit(): % mostrado antes del deep sleep
 
 // Lecturas
 float batteryGetVoltage();   // Voltaje estimado de batería (V)
-int   batteryGetPercent();   // 0..100 según regla 4.15V->100 ... 3.40V->0
+int   batteryGetPercent();   // 0..100 por tabla OCV–SoC (tensión compensada por carga)
+float batteryGetOcvVoltage();  // Vbat + I*Rint con la corriente del gobernador
+
+// Predicción con el consumo medido (gobernador); <0 si aún no hay dato
+float batteryRemainingHours();   // a la media móvil de consumo actual
+int   batteryRemainingJumps();   // con el reparto del "día de saltos"
 
 // Flags de estado para la UI / sistema
 bool  batteryIsLowPercent();     // true si % <= 5 (parpadeo en UI)
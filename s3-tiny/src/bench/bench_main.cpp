@@ -0,0 +1,268 @@
+// =====================================================
+// Firmware de microbenchmarks (env: esp32-s3-fh4r2-bench)
+// -----------------------------------------------------
+// Mide con el contador de ciclos de la CPU las operaciones
+// que fijan nuestro presupuesto de latencia:
+//   - bmp.performReading() por cada OSR de presión
+//   - u8g2.sendBuffer() (ST7567 por SPI software)
+//   - escritura tipo posixWriteAt() + fsync en LittleFS
+//   - escritura en Preferences (NVS)
+//   - multisampling de analogReadMilliVolts (batería/VBUS)
+//   - cambios de frecuencia con setCpuFrequencyMhz()
+// y repite todo a 40/80/160 MHz. Imprime una tabla por Serial.
+//
+// No toca la bitácora real: usa /bench.bin y el namespace "bench".
+// Enviar 'b' por el monitor serie para repetir la pasada.
+// =====================================================
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_BMP3XX.h>
+#include <U8g2lib.h>
+#include <LittleFS.h>
+#include <Preferences.h>
+#include <esp_timer.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../config.h"
+#include "../charge_detect.h"   // CHARGE_ADC_PIN
+#include "../cycle_count.h"
+#include "../alt_glyph_cache.h"
+
+#ifndef BENCH_REPS
+  #define BENCH_REPS 20
+#endif
+#ifndef BENCH_FILE
+  #define BENCH_FILE "/bench.bin"
+#endif
+
+static Adafruit_BMP3XX bmp;
+static U8G2_ST7567_JLX12864_F_4W_SW_SPI u8g2(U8G2_R2, LCD_SCK, LCD_MOSI, LCD_CS, LCD_DC, LCD_RST);
+static Preferences benchPrefs;
+
+static bool s_bmpOk = false;
+static bool s_fsOk  = false;
+
+static const uint32_t kCpuMhz[] = { 40, 80, 160 };
+
+// ------------------------------
+// Tabla de resultados
+// ------------------------------
+static void benchHeader() {
+  Serial.println();
+  Serial.println("| operacion                  |  MHz |   n |   min_us |   avg_us |   max_us |");
+  Serial.println("|----------------------------|------|-----|----------|----------|----------|");
+}
+
+static void benchRow(const char* name, uint32_t mhz, uint16_t n,
+                     uint32_t minUs, uint32_t avgUs, uint32_t maxUs) {
+  Serial.printf("| %-26s | %4lu | %3u | %8lu | %8lu | %8lu |\n",
+                name, (unsigned long)mhz, (unsigned)n,
+                (unsigned long)minUs, (unsigned long)avgUs, (unsigned long)maxUs);
+}
+
+// Ejecuta fn() n veces midiendo ciclos; fn devuelve false si la operación falló
+template <typename F>
+static void benchRun(const char* name, uint16_t n, F fn) {
+  const uint32_t mhz = getCpuFrequencyMhz();
+  uint32_t minC = UINT32_MAX, maxC = 0;
+  uint64_t sumC = 0;
+  uint16_t ok = 0;
+
+  for (uint16_t i = 0; i < n; ++i) {
+    const uint32_t c0 = cycNow();
+    const bool good = fn();
+    const uint32_t dc = cycNow() - c0;
+    if (!good) continue;
+    if (dc < minC) minC = dc;
+    if (dc > maxC) maxC = dc;
+    sumC += dc;
+    ok++;
+  }
+
+  if (ok == 0) {
+    Serial.printf("| %-26s | %4lu |   0 |      --- |      --- |      --- |\n",
+                  name, (unsigned long)mhz);
+    return;
+  }
+  benchRow(name, mhz, ok,
+           cycToUs(minC, mhz),
+           cycToUs((uint32_t)(sumC / ok), mhz),
+           cycToUs(maxC, mhz));
+}
+
+// ------------------------------
+// Operaciones a medir
+// ------------------------------
+static void benchSensor() {
+  if (!s_bmpOk) return;
+
+  struct { uint8_t osr; const char* name; } osrs[] = {
+    { BMP3_NO_OVERSAMPLING,  "performReading OSR x1"  },
+    { BMP3_OVERSAMPLING_2X,  "performReading OSR x2"  },
+    { BMP3_OVERSAMPLING_4X,  "performReading OSR x4"  },
+    { BMP3_OVERSAMPLING_8X,  "performReading OSR x8"  },
+    { BMP3_OVERSAMPLING_16X, "performReading OSR x16" },
+    { BMP3_OVERSAMPLING_32X, "performReading OSR x32" },
+  };
+
+  bmp.setTemperatureOversampling(BMP3_OVERSAMPLING_2X);
+  bmp.setIIRFilterCoeff(BMP3_IIR_FILTER_DISABLE);
+  for (auto &o : osrs) {
+    bmp.setPressureOversampling(o.osr);
+    bmp.performReading();                 // descarta la primera (aplica config)
+    benchRun(o.name, 10, []() { return bmp.performReading(); });
+  }
+}
+
+static void benchDisplay() {
+  // Patrón fijo: el coste de sendBuffer no depende del contenido
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_fub30_tr);
+  u8g2.drawStr(8, 50, "12345");
+  benchRun("u8g2.sendBuffer SW SPI", BENCH_REPS, []() { u8g2.sendBuffer(); return true; });
+
+  benchRun("u8g2 draw fub30 5 dig", BENCH_REPS, []() {
+    u8g2.clearBuffer();
+    u8g2.setFont(u8g2_font_fub30_tr);
+    int w = u8g2.getStrWidth("12345");
+    u8g2.setCursor((128 - w) / 2, 50);
+    u8g2.print("12345");
+    return true;
+  });
+
+  // Misma cadena con la caché de glifos del HUD
+  if (altGlyphCacheReady()) {
+    benchRun("alt glyph cache 5 dig", BENCH_REPS, []() {
+      u8g2.clearBuffer();
+      int w = altGlyphStrWidth("12345");
+      return altGlyphDrawStr(u8g2, (128 - w) / 2, 50, "12345");
+    });
+  }
+}
+
+static void benchFlash() {
+  if (!s_fsOk) return;
+
+  // Mismo patrón que posixWriteAt() de logbook.cpp: open+lseek+write+fsync+close
+  static uint8_t rec[26];
+  for (size_t i = 0; i < sizeof(rec); ++i) rec[i] = (uint8_t)i;
+
+  benchRun("posixWriteAt 26B + fsync", BENCH_REPS, []() {
+    int fd = ::open("/littlefs" BENCH_FILE, O_RDWR | O_CREAT, 0666);
+    if (fd < 0) return false;
+    bool ok = (::lseek(fd, 0, SEEK_SET) >= 0) &&
+              (::write(fd, rec, sizeof(rec)) == (ssize_t)sizeof(rec));
+    ::fsync(fd);
+    ::close(fd);
+    return ok;
+  });
+
+  benchRun("Preferences putFloat", BENCH_REPS, []() {
+    static float v = 0.0f;
+    v += 0.5f;
+    return benchPrefs.putFloat("agz", v) == sizeof(float);
+  });
+}
+
+static void benchAdc() {
+  // Igual que battery.cpp: 8 muestras con 200 us de pausa
+  benchRun("analogReadMilliVolts x8 bat", BENCH_REPS, []() {
+    uint32_t acc = 0;
+    for (uint8_t i = 0; i < 8; ++i) {
+      acc += (uint32_t)analogReadMilliVolts(BATTERY_PIN);
+      delayMicroseconds(200);
+    }
+    return acc > 0;
+  });
+
+  // Igual que charge_detect.cpp: 8 muestras seguidas
+  benchRun("analogReadMilliVolts x8 vbus", BENCH_REPS, []() {
+    uint32_t acc = 0;
+    for (uint8_t i = 0; i < 8; ++i) acc += (uint32_t)analogReadMilliVolts(CHARGE_ADC_PIN);
+    (void)acc;                 // sin VBUS el pin lee 0 mV: la medida sigue siendo válida
+    return true;
+  });
+}
+
+// setCpuFrequencyMhz() cambia la base del contador de ciclos -> medimos con esp_timer
+static void benchCpuSwitch() {
+  Serial.println();
+  Serial.println("| cambio CPU                 | desde| hasta|   min_us |   avg_us |   max_us |");
+  Serial.println("|----------------------------|------|------|----------|----------|----------|");
+
+  for (uint32_t from : kCpuMhz) {
+    for (uint32_t to : kCpuMhz) {
+      if (from == to) continue;
+      uint32_t minUs = UINT32_MAX, maxUs = 0;
+      uint64_t sumUs = 0;
+      for (uint16_t i = 0; i < BENCH_REPS; ++i) {
+        setCpuFrequencyMhz(from);
+        const int64_t t0 = esp_timer_get_time();
+        setCpuFrequencyMhz(to);
+        const uint32_t dt = (uint32_t)(esp_timer_get_time() - t0);
+        if (dt < minUs) minUs = dt;
+        if (dt > maxUs) maxUs = dt;
+        sumUs += dt;
+      }
+      Serial.printf("| setCpuFrequencyMhz         | %4lu | %4lu | %8lu | %8lu | %8lu |\n",
+                    (unsigned long)from, (unsigned long)to, (unsigned long)minUs,
+                    (unsigned long)(sumUs / BENCH_REPS), (unsigned long)maxUs);
+    }
+  }
+}
+
+static void benchPass() {
+  benchHeader();
+  for (uint32_t mhz : kCpuMhz) {
+    Serial.flush();
+    setCpuFrequencyMhz(mhz);
+    delay(20);                 // deja asentar USB-CDC / APB
+    benchSensor();
+    benchDisplay();
+    benchFlash();
+    benchAdc();
+  }
+  benchCpuSwitch();
+  setCpuFrequencyMhz(160);
+  Serial.println("[BENCH] fin. Enviar 'b' para repetir.");
+}
+
+// ------------------------------
+// Arduino
+// ------------------------------
+void setup() {
+  Serial.begin(115200);
+  const uint32_t t0 = millis();
+  while (!Serial && (millis() - t0) < 3000) { delay(10); }
+
+  Wire.begin(SDA_PIN, SCL_PIN);
+  Wire.setClock(400000);
+
+  s_bmpOk = bmp.begin_I2C(BMP_ADDR);
+  if (!s_bmpOk) Serial.println("[BENCH] BMP390 no encontrado: se omiten lecturas");
+
+  u8g2.begin();
+  u8g2.setPowerSave(0);
+  altGlyphCacheBuild(u8g2, u8g2_font_fub30_tr, 50);
+
+  s_fsOk = LittleFS.begin(false);
+  if (!s_fsOk) Serial.println("[BENCH] LittleFS no montado: se omite flash");
+
+  benchPrefs.begin("bench", false);
+
+  analogReadResolution(12);
+  analogSetPinAttenuation(BATTERY_PIN, ADC_11db);
+  analogSetPinAttenuation(CHARGE_ADC_PIN, ADC_11db);
+
+  Serial.printf("[BENCH] s3-tiny  IDF %s  reps=%u\n", esp_get_idf_version(), (unsigned)BENCH_REPS);
+  benchPass();
+}
+
+void loop() {
+  if (Serial.available()) {
+    const int c = Serial.read();
+    if (c == 'b' || c == 'B') benchPass();
+  }
+  delay(50);
+}
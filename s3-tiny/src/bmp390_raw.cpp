@@ -0,0 +1,98 @@
+#include "bmp390_raw.h"
+#include <math.h>
+
+// ------------------------------
+// Bus
+// ------------------------------
+bool bmp390WriteReg(TwoWire &w, uint8_t addr, uint8_t reg, uint8_t val) {
+  w.beginTransmission(addr);
+  w.write(reg);
+  w.write(val);
+  return w.endTransmission() == 0;
+}
+
+bool bmp390ReadRegs(TwoWire &w, uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t n) {
+  w.beginTransmission(addr);
+  w.write(reg);
+  if (w.endTransmission(false) != 0) return false;
+  if (w.requestFrom(addr, n) != n) return false;
+  for (uint8_t i = 0; i < n; ++i) buf[i] = (uint8_t)w.read();
+  return true;
+}
+
+// ------------------------------
+// Calibración (NVM_PAR_*), escalas de la hoja de datos
+// ------------------------------
+static inline uint16_t u16le(const uint8_t *b) { return (uint16_t)(b[0] | (b[1] << 8)); }
+static inline int16_t  s16le(const uint8_t *b) { return (int16_t)u16le(b); }
+
+bool bmp390ReadCalib(TwoWire &w, uint8_t addr, Bmp390Calib &c) {
+  uint8_t b[BMP390_CALIB_LEN];
+  if (!bmp390ReadRegs(w, addr, BMP390_REG_CALIB, b, sizeof(b))) return false;
+
+  c.t1  = u16le(&b[0])  / pow(2, -8);
+  c.t2  = u16le(&b[2])  / pow(2, 30);
+  c.t3  = (int8_t)b[4]  / pow(2, 48);
+  c.p1  = (s16le(&b[5]) - 16384.0) / pow(2, 20);
+  c.p2  = (s16le(&b[7]) - 16384.0) / pow(2, 29);
+  c.p3  = (int8_t)b[9]  / pow(2, 32);
+  c.p4  = (int8_t)b[10] / pow(2, 37);
+  c.p5  = u16le(&b[11]) / pow(2, -3);
+  c.p6  = u16le(&b[13]) / pow(2, 6);
+  c.p7  = (int8_t)b[15] / pow(2, 8);
+  c.p8  = (int8_t)b[16] / pow(2, 15);
+  c.p9  = s16le(&b[17]) / pow(2, 48);
+  c.p10 = (int8_t)b[19] / pow(2, 48);
+  c.p11 = (int8_t)b[20] / pow(2, 65);
+  return true;
+}
+
+bool bmp390ForcedRaw(TwoWire &w, uint8_t addr, uint32_t &up, uint32_t &ut, uint32_t timeoutMs) {
+  if (!bmp390WriteReg(w, addr, BMP390_REG_PWR_CTRL, BMP390_PWR_FORCED_PT)) return false;
+
+  const uint32_t t0 = millis();
+  uint8_t st = 0;
+  do {
+    delay(2);
+    if (!bmp390ReadRegs(w, addr, BMP390_REG_STATUS, &st, 1)) return false;
+    if ((millis() - t0) > timeoutMs) return false;
+  } while ((st & (BMP390_STATUS_DRDY_P | BMP390_STATUS_DRDY_T)) !=
+           (BMP390_STATUS_DRDY_P | BMP390_STATUS_DRDY_T));
+
+  uint8_t d[BMP390_DATA_LEN];
+  if (!bmp390ReadRegs(w, addr, BMP390_REG_DATA, d, sizeof(d))) return false;
+  up = BMP390_RAW24(&d[0]);
+  ut = BMP390_RAW24(&d[3]);
+  return true;
+}
+
+// ------------------------------
+// Compensación
+// ------------------------------
+double bmp390CompT(const Bmp390Calib &c, uint32_t ut) {
+  const double d1 = (double)ut - c.t1;
+  const double d2 = d1 * c.t2;
+  return d2 + d1 * d1 * c.t3;
+}
+
+double bmp390CompP(const Bmp390Calib &c, uint32_t up, double t) {
+  const double t2 = t * t, t3 = t2 * t;
+  const double out1 = c.p5 + c.p6 * t + c.p7 * t2 + c.p8 * t3;
+  const double out2 = (double)up * (c.p1 + c.p2 * t + c.p3 * t2 + c.p4 * t3);
+  const double u  = (double)up;
+  const double u2 = u * u;
+  const double out3 = u2 * (c.p9 + c.p10 * t) + u2 * u * c.p11;
+  return out1 + out2 + out3;
+}
+
+// Derivadas centradas: +-1000 cuentas (~12 Pa / ~0.2 °C)
+Bmp390Linear bmp390Linearize(const Bmp390Calib &c, uint32_t up0, uint32_t ut0) {
+  const uint32_t D = 1000;
+  const double t0 = bmp390CompT(c, ut0);
+  Bmp390Linear l;
+  l.p0 = bmp390CompP(c, up0, t0);
+  l.kP = (bmp390CompP(c, up0 + D, t0) - bmp390CompP(c, up0 - D, t0)) / (2.0 * D);
+  l.kT = (bmp390CompP(c, up0, bmp390CompT(c, ut0 + D)) -
+          bmp390CompP(c, up0, bmp390CompT(c, ut0 - D))) / (2.0 * D);
+  return l;
+}
@@ -0,0 +1,45 @@
+#ifndef BMP390_RAW_H
+#define BMP390_RAW_H
+
+// =====================================================
+// BMP390 a nivel de registro (CPU principal, Wire)
+// -----------------------------------------------------
+// Para lo que Adafruit_BMP3XX no expone: los crudos de 24
+// bits y la calibración NVM. Compensación en double según la
+// hoja de datos (sección 9). Lo usa ulp_climb para cargar en
+// el ULP un modelo lineal presión(crudos) alrededor del punto
+// de trabajo, que el ULP evalúa sólo con enteros.
+// =====================================================
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "bmp390_regs.h"
+
+struct Bmp390Calib {
+  double t1, t2, t3;
+  double p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11;
+};
+
+bool bmp390ReadCalib(TwoWire &w, uint8_t addr, Bmp390Calib &c);
+
+// Dispara una conversión FORCED (P+T) y lee los crudos
+bool bmp390ForcedRaw(TwoWire &w, uint8_t addr, uint32_t &up, uint32_t &ut,
+                     uint32_t timeoutMs = 100);
+
+// Temperatura linealizada (°C) y presión compensada (Pa)
+double bmp390CompT(const Bmp390Calib &c, uint32_t ut);
+double bmp390CompP(const Bmp390Calib &c, uint32_t up, double tLin);
+
+// Modelo lineal alrededor de (up0, ut0):
+//   P ≈ p0 + kP * (up - up0) + kT * (ut - ut0)
+struct Bmp390Linear {
+  double p0;   // Pa
+  double kP;   // Pa por cuenta de presión
+  double kT;   // Pa por cuenta de temperatura
+};
+Bmp390Linear bmp390Linearize(const Bmp390Calib &c, uint32_t up0, uint32_t ut0);
+
+bool bmp390WriteReg(TwoWire &w, uint8_t addr, uint8_t reg, uint8_t val);
+bool bmp390ReadRegs(TwoWire &w, uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t n);
+
+#endif // BMP390_RAW_H
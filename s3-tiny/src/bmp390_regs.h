@@ -0,0 +1,61 @@
+#ifndef BMP390_REGS_H
+#define BMP390_REGS_H
+
+// =====================================================
+// Mapa de registros del BMP390 (hoja de datos, cap. 5)
+// -----------------------------------------------------
+// C puro: lo comparten el CPU principal (bmp390_raw) y el
+// programa del ULP RISC-V (s3-tiny/ulp).
+// =====================================================
+
+#define BMP390_REG_CHIP_ID    0x00   // 0x60
+#define BMP390_REG_ERR        0x02
+#define BMP390_REG_STATUS     0x03
+#define BMP390_REG_DATA       0x04   // P xlsb,lsb,msb + T xlsb,lsb,msb
+#define BMP390_REG_INT_STATUS 0x11   // se borra al leerlo (INT latched)
+#define BMP390_REG_INT_CTRL   0x19
+#define BMP390_REG_PWR_CTRL   0x1B
+#define BMP390_REG_OSR        0x1C
+#define BMP390_REG_ODR        0x1D
+#define BMP390_REG_CONFIG     0x1F   // IIR en bits 3:1
+#define BMP390_REG_CALIB      0x31   // NVM_PAR_T1 .. NVM_PAR_P11
+#define BMP390_REG_CMD        0x7E
+
+#define BMP390_CHIP_ID        0x60
+#define BMP390_CALIB_LEN      21
+#define BMP390_DATA_LEN       6
+
+// STATUS
+#define BMP390_STATUS_DRDY_P  0x20
+#define BMP390_STATUS_DRDY_T  0x40
+
+// Ráfaga STATUS..INT_STATUS: estado, datos y borrado del INT en una lectura
+#define BMP390_BURST_LEN      (BMP390_REG_INT_STATUS - BMP390_REG_STATUS + 1)
+
+// INT_CTRL
+#define BMP390_INT_LEVEL_HIGH 0x02
+#define BMP390_INT_LATCH      0x04
+#define BMP390_INT_DRDY_EN    0x40
+
+// PWR_CTRL: press_en | temp_en | modo
+#define BMP390_PWR_PRESS_EN   0x01
+#define BMP390_PWR_TEMP_EN    0x02
+#define BMP390_PWR_MODE_SLEEP  0x00
+#define BMP390_PWR_MODE_FORCED 0x10
+#define BMP390_PWR_MODE_NORMAL 0x30
+#define BMP390_PWR_FORCED_PT  (BMP390_PWR_PRESS_EN | BMP390_PWR_TEMP_EN | BMP390_PWR_MODE_FORCED)
+
+// OSR: osr_p en bits 2:0, osr_t en bits 5:3 (0=x1 ... 5=x32)
+#define BMP390_OSR(p, t)      ((uint8_t)(((t) << 3) | (p)))
+
+// Conversión FORCED P+T en µs con osr_p/osr_t (hoja de datos 3.9.2)
+#define BMP390_CONV_US(p, t)  (234UL + (392UL + (2020UL << (p))) + (163UL + (2020UL << (t))))
+
+// ODR: periodo = 5 ms * 2^sel (0=200 Hz ... 4=12.5 Hz)
+// CONFIG: coeficiente IIR (0=bypass, 1=1, 2=3, 3=7, 4=15...)
+#define BMP390_IIR(c)         ((uint8_t)((c) << 1))
+
+// Crudos de 24 bits (little endian) desde DATA_0..5
+#define BMP390_RAW24(b)       ((uint32_t)(b)[0] | ((uint32_t)(b)[1] << 8) | ((uint32_t)(b)[2] << 16))
+
+#endif // BMP390_REGS_H
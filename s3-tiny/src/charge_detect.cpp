@@ -1,6 +1,7 @@
 #include "charge_detect.h"
 #include <Arduino.h>
 #include <driver/gpio.h>   // para deshabilitar pulls internos en el pin
+#include "adc_dma.h"       // mediana del bloque DMA (si VBUS va por DMA)
 
 // ---------------------------------------------------------------------------------
 // Compatibilidad de constantes de atenuación entre cores (alias seguro):
@@ -43,6 +44,21 @@ static constexpr float DIV_RATIO = (CHARGE_R_BOT_KOHM / (CHARGE_R_TOP_KOHM + CHA
   #define CHARGE_CNT_OFF_REQ 3
 #endif
 
+// Periodo de medida: el loop ya no gira sin parar (loop_sched)
+#ifndef CHARGE_UPDATE_INTERVAL_MS
+  #define CHARGE_UPDATE_INTERVAL_MS 100UL   // 3 cuentas = 300 ms de debounce
+#endif
+
+// Sin DMA para VBUS (GPIO11 = ADC2: el backend IDF 4.4 sólo hace ADC1)
+// el multimuestreo por analogRead bloquea el loop: se mide al ritmo de
+// la batería y con menos cuentas (el multimuestreo ya filtra glitches)
+#ifndef CHARGE_ANALOG_INTERVAL_MS
+  #define CHARGE_ANALOG_INTERVAL_MS 1000UL  // = BATTERY_UPDATE_INTERVAL_MS
+#endif
+#ifndef CHARGE_ANALOG_CNT_REQ
+  #define CHARGE_ANALOG_CNT_REQ 2           // 2 s de debounce
+#endif
+
 // Multimuestreo para cada lectura. Override con define.
 #ifndef CHARGE_MSAMPLES
   #define CHARGE_MSAMPLES 8      // 8 lecturas; se descartan min y max
@@ -52,7 +68,15 @@ static constexpr float DIV_RATIO = (CHARGE_R_BOT_KOHM / (CHARGE_R_TOP_KOHM + CHA
 static uint8_t s_cntOn  = 0;
 static uint8_t s_cntOff = 0;
 static bool    s_present = false;
+static bool    s_started = false;  // chargeDetectBegin() ya decidió el estado inicial
 static bool    s_warmed  = false;  // para descartar la primera lectura “fría”
+static uint32_t s_tLast   = 0;      // última medida (millis)
+static uint32_t s_dmaSeq  = 0;      // última ráfaga DMA ya contada
+static bool     s_dma     = false;  // VBUS por DMA (último intento)
+
+static inline uint32_t updateIntervalMs() {
+  return s_dma ? CHARGE_UPDATE_INTERVAL_MS : CHARGE_ANALOG_INTERVAL_MS;
+}
 
 // =============== Helpers (solo driver NG) ===============
 static inline int readRawOnce() {
@@ -110,23 +134,40 @@ void chargeDetectBegin() {
   (void)readMilliVoltsOnce();
   s_warmed = true;
 
-  // Resetea estado
+  // Resetea estado; el inicial, con una lectura: batería y gobernador
+  // preguntan por el USB antes de la primera Update
   s_cntOn = s_cntOff = 0;
-  // No forzamos s_present aquí: que Update lo decida
+  s_present = pinmV_to_vbusV(multisampleMilliVolts()) >= CHARGE_VBUS_TH_ON;
+  s_started = true;
 }
 
+bool chargeDetectStarted() { return s_started; }
+
 void chargeDetectUpdate() {
-  if (!s_warmed) {
-    (void)readMilliVoltsOnce();
-    s_warmed = true;
+  const uint32_t now = millis();
+  if ((uint32_t)(now - s_tLast) < updateIntervalMs()) return;
+  s_tLast = now;
+
+  // DMA: mediana de la última ráfaga; cada ráfaga cuenta una vez en el debounce
+  uint32_t mVpin, seq;
+  s_dma = adcDmaVbusMv(mVpin, seq);
+  const uint8_t onReq  = s_dma ? CHARGE_CNT_ON_REQ  : CHARGE_ANALOG_CNT_REQ;
+  const uint8_t offReq = s_dma ? CHARGE_CNT_OFF_REQ : CHARGE_ANALOG_CNT_REQ;
+  if (s_dma) {
+    if (seq == s_dmaSeq) return;
+    s_dmaSeq = seq;
+  } else {
+    if (!s_warmed) {
+      (void)readMilliVoltsOnce();
+      s_warmed = true;
+    }
+    mVpin = multisampleMilliVolts();
   }
-
-  const uint32_t mVpin = multisampleMilliVolts();
   const float    vbus  = pinmV_to_vbusV(mVpin);
 
   if (!s_present) {
     if (vbus >= CHARGE_VBUS_TH_ON) {
-      if (++s_cntOn >= CHARGE_CNT_ON_REQ) {
+      if (++s_cntOn >= onReq) {
         s_present = true;
         s_cntOff  = 0;
       }
@@ -135,7 +176,7 @@ void chargeDetectUpdate() {
     }
   } else {
     if (vbus <= CHARGE_VBUS_TH_OFF) {
-      if (++s_cntOff >= CHARGE_CNT_OFF_REQ) {
+      if (++s_cntOff >= offReq) {
         s_present = false;
         s_cntOn   = 0;
       }
@@ -149,8 +190,18 @@ bool isUsbPresent() {
   return s_present;
 }
 
+uint32_t chargeDetectNextDueMs() { return s_tLast + updateIntervalMs(); }
+
 // =============== Debug opcional ===============
 // Nota: estos helpers se mantienen por compatibilidad con tus menús/logs.
-int   chargeDebugRaw()  { return readRawOnce(); }
-float chargeDebugVadc() { return (float)readMilliVoltsOnce() * 0.001f; }  // V en el PIN
-float chargeDebugVbus() { return pinmV_to_vbusV(readMilliVoltsOnce()); }  // V en VBUS
+// Con DMA devuelven el último resultado publicado (sin tocar el ADC).
+int chargeDebugRaw() {
+  int raw;
+  return adcDmaVbusRaw(raw) ? raw : readRawOnce();
+}
+static uint32_t debugMilliVolts() {
+  uint32_t mV, seq;
+  return adcDmaVbusMv(mV, seq) ? mV : readMilliVoltsOnce();
+}
+float chargeDebugVadc() { return (float)debugMilliVolts() * 0.001f; }  // V en el PIN
+float chargeDebugVbus() { return pinmV_to_vbusV(debugMilliVolts()); }  // V en VBUS
@@ -8,11 +8,17 @@
 #define CHARGE_ADC_PIN  11
 #endif
 
-// Inicializa el ADC para detectar VBUS por divisor
+// Inicializa el ADC para detectar VBUS por divisor; el estado
+// inicial sale de una primera lectura (sin debounce)
 void chargeDetectBegin();
+bool chargeDetectStarted();
 
-// Actualiza el filtro/histéresis (llamar en cada loop)
+// Actualiza el filtro/histéresis (llamar en cada loop; mide cada
+// CHARGE_UPDATE_INTERVAL_MS con DMA, CHARGE_ANALOG_INTERVAL_MS por
+// analogRead). Para VBUS por DMA con el core IDF 4.4 el divisor
+// tiene que ir a un pin ADC1 (GPIO1..10, también RTC para EXT1).
 void chargeDetectUpdate();
+uint32_t chargeDetectNextDueMs();   // millis() de la próxima medida
 
 // true si se considera que hay USB presente (VBUS alto)
 bool isUsbPresent();
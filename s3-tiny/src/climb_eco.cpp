@@ -0,0 +1,259 @@
+#include "climb_eco.h"
+#include <Wire.h>
+#include <esp_timer.h>
+#include "driver/gpio.h"
+#include "config.h"
+#include "bmp390_raw.h"
+#include "loop_sched.h"
+
+// ------------------------------
+// Tiempos
+// ------------------------------
+static constexpr int64_t kNominalUs = (int64_t)CLIMB_ECO_PERIOD_MS * 1000;
+static constexpr int64_t kConvUs    = BMP390_CONV_US(CLIMB_ECO_OSR_P, CLIMB_ECO_OSR_T);
+static constexpr int64_t kRetryUs   = 2000;   // sin INT: aún no había DRDY
+static constexpr int64_t kTrimUpUs  = 250;    // reloj del sensor más lento de lo previsto
+static constexpr int64_t kTrimDnUs  = 50;     // dato a la primera: acercarse al DRDY
+
+// ------------------------------
+// Estado
+// ------------------------------
+static bool        s_active     = false;
+static bool        s_haveCalib  = false;
+static Bmp390Calib s_cal;
+static uint32_t    s_candSinceMs = 0;
+static bool        s_aboveBand   = false;     // banda de salida (con histéresis)
+static uint32_t    s_enterMs     = 0;
+static int64_t     s_periodUs    = kNominalUs;
+static int64_t     s_nextUs      = 0;          // próximo DRDY previsto
+static int64_t     s_lastDrdyUs  = 0;
+static bool        s_missed      = false;      // sondeo antes del DRDY desde la última muestra
+
+static volatile bool    s_intFlag = false;
+static volatile int64_t s_intUs   = 0;
+
+enum EcoExit : uint8_t { EXIT_VZ = 0, EXIT_BAND, EXIT_MODE, EXIT_BLOCKED, EXIT_COUNT };
+static const char* const kExitName[EXIT_COUNT] = { "vz", "banda", "modo", "bloqueo" };
+
+struct EcoStats {
+  uint32_t entries;
+  uint32_t exits[EXIT_COUNT];
+  uint32_t samples;
+  uint32_t byInt;          // muestras avisadas por el INT
+  uint32_t early;          // lecturas antes del DRDY
+  uint32_t errors;
+  uint32_t wakeInt;        // light-sleep cortado por el INT
+  uint32_t wakeOther;      // timer o botón
+  uint64_t activeMs;
+};
+static EcoStats s_st;
+
+// ------------------------------
+// INT del BMP
+// ------------------------------
+static void IRAM_ATTR onBmpInt() {
+  s_intUs   = esp_timer_get_time();
+  s_intFlag = true;
+  schedWakeFromISR();
+}
+
+void climbEcoBegin() {
+#if CLIMB_ECO_ENABLE
+  if (BMP_INT_PIN >= 0) {
+    pinMode(BMP_INT_PIN, INPUT_PULLDOWN);
+    attachInterrupt(digitalPinToInterrupt(BMP_INT_PIN), onBmpInt, RISING);
+  }
+#endif
+}
+
+// ------------------------------
+// Entrada / salida
+// ------------------------------
+static bool enterEco() {
+  if (!s_haveCalib) s_haveCalib = bmp390ReadCalib(Wire, BMP_ADDR, s_cal);
+  if (!s_haveCalib) { s_st.errors++; return false; }
+
+  const uint8_t en = BMP390_PWR_PRESS_EN | BMP390_PWR_TEMP_EN;
+  const uint8_t intCtrl = (BMP_INT_PIN >= 0)
+                            ? (BMP390_INT_DRDY_EN | BMP390_INT_LEVEL_HIGH | BMP390_INT_LATCH) : 0;
+  // El cambio de modo pasa por SLEEP
+  const bool ok =
+      bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_PWR_CTRL, en | BMP390_PWR_MODE_SLEEP) &&
+      bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_OSR, BMP390_OSR(CLIMB_ECO_OSR_P, CLIMB_ECO_OSR_T)) &&
+      bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_ODR, CLIMB_ECO_ODR_SEL) &&
+      bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_CONFIG, BMP390_IIR(CLIMB_ECO_IIR)) &&
+      bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_INT_CTRL, intCtrl) &&
+      bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_PWR_CTRL, en | BMP390_PWR_MODE_NORMAL);
+  if (!ok) {
+    s_st.errors++;
+    bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_PWR_CTRL, en | BMP390_PWR_MODE_SLEEP);
+    return false;
+  }
+
+  const int64_t now = esp_timer_get_time();
+  s_intFlag    = false;
+  s_periodUs   = kNominalUs;
+  s_nextUs     = now + kConvUs + 1000;   // la primera conversión arranca ya
+  s_lastDrdyUs = 0;
+  s_missed     = false;
+  s_enterMs    = millis();
+  s_active     = true;
+  s_st.entries++;
+  Serial.printf("[ECO] subida economica: BMP en NORMAL a %.1f Hz (INT=%d)\n",
+                1000.0f / CLIMB_ECO_PERIOD_MS, (int)BMP_INT_PIN);
+  return true;
+}
+
+static void exitEco(EcoExit cause) {
+  // A SLEEP; la próxima performReading() reescribe OSR/ODR/IIR de Ultra.
+  // Adafruit no escribe el IIR si lo tiene desactivado (FF): se deja el de Ultra
+  bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_PWR_CTRL, BMP390_PWR_PRESS_EN | BMP390_PWR_TEMP_EN);
+  bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_INT_CTRL, 0);
+  bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_CONFIG, BMP390_IIR(3));
+  s_active  = false;
+  s_intFlag = false;
+  s_st.exits[cause]++;
+  s_st.activeMs += millis() - s_enterMs;
+  Serial.printf("[ECO] a pleno ritmo (%s)\n", kExitName[cause]);
+}
+
+void climbEcoUpdate(SensorMode m, float altFt, float vz, bool blocked) {
+#if CLIMB_ECO_ENABLE
+  if (altFt >= CLIMB_ECO_MAX_FT)                               s_aboveBand = true;
+  else if (altFt < CLIMB_ECO_MAX_FT - CLIMB_ECO_BAND_HYST_FT)  s_aboveBand = false;
+
+  if (s_active) {
+    if (m != SENSOR_MODE_ULTRA_PRECISO)  exitEco(EXIT_MODE);
+    else if (blocked)                    exitEco(EXIT_BLOCKED);
+    else if (vz <= CLIMB_ECO_VZ_EXIT_MPS) exitEco(EXIT_VZ);
+    else if (s_aboveBand)                exitEco(EXIT_BAND);
+    return;
+  }
+
+  const bool candidate = (m == SENSOR_MODE_ULTRA_PRECISO) && !blocked && !s_aboveBand &&
+                         (vz >= CLIMB_ECO_VZ_ENTER_MPS);
+  if (!candidate) { s_candSinceMs = 0; return; }
+  if (s_candSinceMs == 0) s_candSinceMs = millis();
+  if (millis() - s_candSinceMs >= CLIMB_ECO_ENTER_MS) {
+    s_candSinceMs = 0;
+    enterEco();
+  }
+#else
+  (void)m; (void)altFt; (void)vz; (void)blocked;
+#endif
+}
+
+bool climbEcoActive() { return s_active; }
+
+// ------------------------------
+// Lectura sin conversión
+// ------------------------------
+int8_t climbEcoRead(double &pressurePa, double &temperatureC, int64_t &tMeasUs) {
+  uint8_t b[BMP390_BURST_LEN];
+  if (!bmp390ReadRegs(Wire, BMP_ADDR, BMP390_REG_STATUS, b, sizeof(b))) {
+    s_st.errors++;
+    return -1;
+  }
+  const int64_t now = esp_timer_get_time();
+  const bool    irq = s_intFlag;
+  const int64_t intUs = s_intUs;
+  s_intFlag = false;
+
+  if ((b[0] & (BMP390_STATUS_DRDY_P | BMP390_STATUS_DRDY_T)) !=
+      (BMP390_STATUS_DRDY_P | BMP390_STATUS_DRDY_T)) {
+    s_st.early++;
+    if (BMP_INT_PIN < 0) {
+      if (!s_missed) s_periodUs += kTrimUpUs;
+      s_missed = true;
+      s_nextUs = now + kRetryUs;
+    } else {
+      s_nextUs = now + s_periodUs / 2;   // respaldo si se pierde el INT
+    }
+    return 0;
+  }
+
+  const uint32_t up = BMP390_RAW24(&b[1]);
+  const uint32_t ut = BMP390_RAW24(&b[4]);
+  const double   t  = bmp390CompT(s_cal, ut);
+  temperatureC = t;
+  pressurePa   = bmp390CompP(s_cal, up, t);
+
+  // Periodo real del sensor: entre INT consecutivos o, sin INT, por sondeo
+  const int64_t drdyUs = irq ? intUs : now;
+  if (irq && s_lastDrdyUs) {
+    const int64_t d = drdyUs - s_lastDrdyUs;
+    if (d > kNominalUs / 2 && d < kNominalUs * 3 / 2) s_periodUs += (d - s_periodUs) / 8;
+  } else if (!irq && !s_missed) {
+    s_periodUs -= kTrimDnUs;
+  }
+  if (s_periodUs < kNominalUs * 9 / 10)  s_periodUs = kNominalUs * 9 / 10;
+  if (s_periodUs > kNominalUs * 11 / 10) s_periodUs = kNominalUs * 11 / 10;
+
+  s_lastDrdyUs = drdyUs;
+  s_missed     = false;
+  // Con INT el timer sólo es respaldo
+  s_nextUs     = drdyUs + s_periodUs + ((BMP_INT_PIN >= 0) ? s_periodUs / 4 : 0);
+  tMeasUs      = drdyUs - kConvUs / 2;
+
+  s_st.samples++;
+  if (irq) s_st.byInt++;
+  return 1;
+}
+
+bool climbEcoDue() {
+  return s_active && (s_intFlag || esp_timer_get_time() >= s_nextUs);
+}
+
+uint32_t climbEcoMsUntilNext() {
+  if (!s_active || s_intFlag) return 0;
+  const int64_t d = s_nextUs - esp_timer_get_time();
+  return (d > 0) ? (uint32_t)((d + 999) / 1000) : 0;
+}
+
+// ------------------------------
+// Light-sleep
+// ------------------------------
+void climbEcoArmLightSleepWake() {
+  if (!s_active || BMP_INT_PIN < 0) return;
+  // Por nivel y sin ISR: el INT queda alto (latched) hasta leerlo
+  gpio_intr_disable((gpio_num_t)BMP_INT_PIN);
+  gpio_wakeup_enable((gpio_num_t)BMP_INT_PIN, GPIO_INTR_HIGH_LEVEL);
+}
+
+void climbEcoAfterLightSleep() {
+  if (!s_active) return;
+  if (BMP_INT_PIN >= 0) {
+    gpio_wakeup_disable((gpio_num_t)BMP_INT_PIN);
+    gpio_set_intr_type((gpio_num_t)BMP_INT_PIN, GPIO_INTR_POSEDGE);
+    gpio_intr_enable((gpio_num_t)BMP_INT_PIN);
+    if (!s_intFlag && digitalRead(BMP_INT_PIN) == HIGH) {
+      s_intUs   = esp_timer_get_time();
+      s_intFlag = true;
+    }
+  }
+  if (s_intFlag) s_st.wakeInt++;
+  else           s_st.wakeOther++;
+}
+
+// ------------------------------
+// Informe
+// ------------------------------
+void climbEcoDump() {
+  const uint64_t activeMs = s_st.activeMs + (s_active ? millis() - s_enterMs : 0);
+  Serial.printf("[ECO] activo=%d INT=%d periodo=%.2fms (nominal %lu) conversion=%.1fms\n",
+                s_active ? 1 : 0, (int)BMP_INT_PIN, s_periodUs / 1000.0,
+                (unsigned long)CLIMB_ECO_PERIOD_MS, kConvUs / 1000.0);
+  Serial.printf("[ECO] entradas=%lu tiempo=%.0fs muestras=%lu (INT %lu) antes de DRDY=%lu errores=%lu\n",
+                (unsigned long)s_st.entries, activeMs / 1000.0, (unsigned long)s_st.samples,
+                (unsigned long)s_st.byInt, (unsigned long)s_st.early, (unsigned long)s_st.errors);
+  Serial.printf("[ECO] salidas: vz=%lu banda=%lu modo=%lu bloqueo=%lu  light-sleep: INT=%lu otro=%lu\n",
+                (unsigned long)s_st.exits[EXIT_VZ], (unsigned long)s_st.exits[EXIT_BAND],
+                (unsigned long)s_st.exits[EXIT_MODE], (unsigned long)s_st.exits[EXIT_BLOCKED],
+                (unsigned long)s_st.wakeInt, (unsigned long)s_st.wakeOther);
+}
+
+void climbEcoReset() {
+  memset(&s_st, 0, sizeof(s_st));
+  if (s_active) s_enterMs = millis();
+  Serial.println("[ECO] reset");
+}
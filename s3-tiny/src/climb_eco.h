@@ -0,0 +1,88 @@
+#ifndef CLIMB_ECO_H
+#define CLIMB_ECO_H
+
+// =====================================================
+// Subida económica: BMP390 en NORMAL + light-sleep
+// -----------------------------------------------------
+// Dentro de Ultra, con la subida en el avión ya estable
+// (vz >= CLIMB_ECO_VZ_ENTER_MPS durante CLIMB_ECO_ENTER_MS,
+// por debajo de la banda de salida y sin salto abierto):
+//  - el BMP convierte solo en NORMAL a CLIMB_ECO_ODR_SEL
+//    (12.5 Hz, OSR P x8 / T x1, IIR 3) con DRDY en su INT,
+//  - la muestra se lee sin disparar conversión (una ráfaga
+//    STATUS..INT_STATUS, que además borra el INT),
+//  - el gobernador pasa a GOV_CLIMB y la CPU hace
+//    light-sleep hasta el siguiente DRDY.
+// Con BMP_INT_PIN cableado, el INT despierta el light-sleep
+// y el loop (ISR -> schedWakeFromISR); sin él, se despierta
+// por timer al DRDY previsto y el periodo se ajusta al reloj
+// del sensor (si aún no hay dato, se alarga; si lo hay a la
+// primera, se acorta un poco).
+// Sale a Ultra a pleno ritmo en cuanto vz baja de
+// CLIMB_ECO_VZ_EXIT_MPS (salida, apertura o avión bajando),
+// se alcanza CLIMB_ECO_MAX_FT o cambia el modo.
+// 'c' por Serial: estadísticas.
+// =====================================================
+
+#include <Arduino.h>
+#include "sensor_module.h"
+
+#ifndef CLIMB_ECO_ENABLE
+  #define CLIMB_ECO_ENABLE        1
+#endif
+#ifndef CLIMB_ECO_ODR_SEL
+  #define CLIMB_ECO_ODR_SEL       4        // 12.5 Hz
+#endif
+#define CLIMB_ECO_PERIOD_MS       (5UL << CLIMB_ECO_ODR_SEL)
+#ifndef CLIMB_ECO_OSR_P
+  #define CLIMB_ECO_OSR_P         3        // x8
+#endif
+#ifndef CLIMB_ECO_OSR_T
+  #define CLIMB_ECO_OSR_T         0        // x1
+#endif
+#ifndef CLIMB_ECO_IIR
+  #define CLIMB_ECO_IIR           2        // coeficiente 3
+#endif
+#ifndef CLIMB_ECO_ALPHA
+  #define CLIMB_ECO_ALPHA         0.18f    // = α de Ultra (0.12 a 20 Hz) a 12.5 Hz
+#endif
+#ifndef CLIMB_ECO_VZ_ENTER_MPS
+  #define CLIMB_ECO_VZ_ENTER_MPS  0.5f     // subiendo
+#endif
+#ifndef CLIMB_ECO_ENTER_MS
+  #define CLIMB_ECO_ENTER_MS      10000UL
+#endif
+#ifndef CLIMB_ECO_VZ_EXIT_MPS
+  #define CLIMB_ECO_VZ_EXIT_MPS   (-2.0f)  // muy lejos de VZ_ENTER de FF (-18 m/s)
+#endif
+#ifndef CLIMB_ECO_MAX_FT
+  #define CLIMB_ECO_MAX_FT        10000.0f // banda de salida: a pleno ritmo
+#endif
+#ifndef CLIMB_ECO_BAND_HYST_FT
+  #define CLIMB_ECO_BAND_HYST_FT  500.0f
+#endif
+
+// En initSensor(), tras bmp.begin_I2C(): INT del BMP (si hay)
+void climbEcoBegin();
+
+// Tras la máquina de modos de cada muestra: entra o sale
+void climbEcoUpdate(SensorMode m, float altFt, float vz, bool blocked);
+
+bool climbEcoActive();
+
+// Sin espera: 1 = muestra nueva (tMeasUs = mitad de su conversión),
+// 0 = aún no hay DRDY, -1 = error de bus
+int8_t climbEcoRead(double &pressurePa, double &temperatureC, int64_t &tMeasUs);
+
+// Planificador/gobernador: ¿toca leer? y ms hasta el próximo DRDY
+bool     climbEcoDue();
+uint32_t climbEcoMsUntilNext();
+
+// Light-sleep explícito (gobernador): wake por el INT del BMP
+void climbEcoArmLightSleepWake();
+void climbEcoAfterLightSleep();
+
+void climbEcoDump();
+void climbEcoReset();
+
+#endif // CLIMB_ECO_H
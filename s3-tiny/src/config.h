@@ -67,6 +67,9 @@
 // Sensores / ADCs
 // =========================
 #define BMP_ADDR     0x77
+#ifndef BMP_INT_PIN
+  #define BMP_INT_PIN  (-1)   // INT del BMP390 (DRDY, activo-alto); −1 = sin cablear
+#endif
 #define BATTERY_PIN  1
 
 // -----------------------------------------------------------
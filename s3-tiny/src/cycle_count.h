@@ -0,0 +1,28 @@
+#ifndef CYCLE_COUNT_H
+#define CYCLE_COUNT_H
+
+// =====================================================
+// Contador de ciclos de CPU (CCOUNT / mcycle)
+// - Lectura de ~1 ciclo, sin llamadas al sistema.
+// - Ojo: cuenta ciclos a la frecuencia ACTUAL de la CPU;
+//   no compares muestras tomadas antes/después de un
+//   setCpuFrequencyMhz() (usa esp_timer para eso).
+// =====================================================
+
+#include <Arduino.h>
+#include <esp_idf_version.h>
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+  #include <esp_cpu.h>
+  static inline uint32_t cycNow() { return (uint32_t)esp_cpu_get_cycle_count(); }
+#else
+  #include <hal/cpu_hal.h>
+  static inline uint32_t cycNow() { return (uint32_t)cpu_hal_get_cycle_count(); }
+#endif
+
+// Ciclos -> microsegundos a la frecuencia indicada (MHz)
+static inline uint32_t cycToUs(uint32_t cycles, uint32_t mhz) {
+  return (mhz > 0) ? (cycles / mhz) : 0;
+}
+
+#endif // CYCLE_COUNT_H
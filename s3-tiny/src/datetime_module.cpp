@@ -42,7 +42,12 @@ typedef struct {
 static TB s_tb = {0,0,-180,0};
 
 // ====== Persistentes en deep sleep ======
+// Epoch en µs y contador RTC tomados en el mismo instante: el
+// tiempo dormido se suma sin truncar a segundos. Los despertares
+// de mantenimiento no los tocan (todo el sueño es un solo Δ).
 RTC_DATA_ATTR static uint64_t s_rtc_before_ds_us = 0;
+RTC_DATA_ATTR static int64_t  s_rtc_epoch_us     = 0;   // 0 = sin base al dormir
+RTC_DATA_ATTR static uint64_t s_rtc_planned_us   = 0;   // timer programado (0 = sin timer)
 RTC_DATA_ATTR static uint32_t s_rtc_magic        = 0;
 static constexpr uint32_t RTC_MAGIC = 0x51C0FFEE;
 
@@ -118,13 +123,19 @@ static bool ds3231_read_epoch_cached(uint32_t &out_epoch){
 void datetimeInit() {
   loadTB();
 
-  // Deep-sleep delta (solo para respaldo interno si no hay DS)
+  // Deep-sleep delta (respaldo interno si no hay DS; deriva si lo hay)
   uint64_t ds_us = 0;
+  int64_t  mono_at_delta = 0;      // esp_timer_get_time() del mismo instante
   if (s_rtc_magic == RTC_MAGIC && s_rtc_before_ds_us != 0) {
     const uint64_t now_rtc = esp_rtc_get_time_us();
+    mono_at_delta = esp_timer_get_time();
     if (now_rtc > s_rtc_before_ds_us) ds_us = now_rtc - s_rtc_before_ds_us;
+    // Contador RTC incoherente y despertó el timer: al menos lo programado
+    if (ds_us == 0 && esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER)
+      ds_us = s_rtc_planned_us;
     s_rtc_magic = 0;
   }
+  const bool have_epoch_us = (ds_us > 0 && s_rtc_epoch_us > 0);
 
 #if USE_DS3231
   s_ds_present = ds3231_present();
@@ -133,6 +144,14 @@ void datetimeInit() {
     int Y,M,D,h,mi,ss;
     if (ds3231_read_ymdhms(Y,M,D,h,mi,ss)) {
       const int64_t rtc_epoch = makeEpochUTC(Y,M,D,h,mi,ss);
+      if (have_epoch_us) {
+        // Error del respaldo interno tras este sueño (resolución 1 s del DS)
+        const int64_t est_us = s_rtc_epoch_us + (int64_t)ds_us
+                             + (esp_timer_get_time() - mono_at_delta);
+        Serial.printf("[RTC] respaldo interno tras %lus dormido: %+lld ms\n",
+                      (unsigned long)(ds_us / 1000000ULL),
+                      (long long)((est_us - rtc_epoch * 1000000LL) / 1000LL));
+      }
       s_ds_cache_epoch = (uint32_t)rtc_epoch;
       s_ds_cache_ms    = millis();
       s_tb.epoch_s_at_sync = rtc_epoch;
@@ -157,8 +176,15 @@ void datetimeInit() {
   // --- Respaldo interno (solo si no se exige DS)
   if (!RTC_REQUIRE_DS3231) {
     if (s_tb.valid == 1) {
-      if (ds_us > 0) s_tb.epoch_s_at_sync += (int64_t)(ds_us / 1000000ULL);
-      s_tb.mono_us_at_sync = esp_timer_get_time();
+      if (have_epoch_us) {
+        // La fracción de segundo queda en mono_us_at_sync (puede ser < 0)
+        const int64_t e_us = s_rtc_epoch_us + (int64_t)ds_us;
+        s_tb.epoch_s_at_sync = e_us / 1000000LL;
+        s_tb.mono_us_at_sync = mono_at_delta - e_us % 1000000LL;
+      } else {
+        if (ds_us > 0) s_tb.epoch_s_at_sync += (int64_t)(ds_us / 1000000ULL);
+        s_tb.mono_us_at_sync = esp_timer_get_time();
+      }
       saveTB();
     }
   }
@@ -248,17 +274,21 @@ void datetimeFormatYMD(char* buf, size_t n) {
   snprintf(buf, n, "%04d-%02d-%02d", y, m, d);
 }
 
-void datetimeOnBeforeDeepSleep(uint64_t /*planned_sleep_us*/) {
+void datetimeOnBeforeDeepSleep(uint64_t planned_sleep_us) {
   // Aunque el DS sea autoridad, dejamos respaldo interno consistente
   s_rtc_before_ds_us = esp_rtc_get_time_us();
+  const int64_t now_us = esp_timer_get_time();
+  s_rtc_planned_us   = planned_sleep_us;
+  s_rtc_epoch_us     = 0;
   s_rtc_magic        = RTC_MAGIC;
 
   if (s_tb.valid == 1) {
-    const int64_t now_us = esp_timer_get_time();
-    const int64_t dt_us  = now_us - s_tb.mono_us_at_sync;
+    const int64_t dt_us = now_us - s_tb.mono_us_at_sync;
     if (dt_us > 0) {
+      s_rtc_epoch_us        = s_tb.epoch_s_at_sync * 1000000LL + dt_us;
+      // Segundos enteros a la base; la fracción sigue en mono_us_at_sync
       s_tb.epoch_s_at_sync += (dt_us / 1000000LL);
-      s_tb.mono_us_at_sync  = now_us;
+      s_tb.mono_us_at_sync  = now_us - dt_us % 1000000LL;
     }
     saveTB();
   }
@@ -267,6 +297,8 @@ void datetimeOnBeforeDeepSleep(uint64_t /*planned_sleep_us*/) {
 // ====== UI de configuración (DD/MM/YY y HH:MM) ======
 #include <U8g2lib.h>
 #include "config.h"
+#include "ui_module.h"        // u8g2 (LcdU8g2)
+#include "lcd_flush.h"
 
 extern int idioma;               // 0=ES, 1=EN
 #ifndef LANG_ES
@@ -286,7 +318,6 @@ enum FieldType : uint8_t {
 static uint8_t s_field = 0;
 static int y=2025, M=9, d=26, h=12, mi=0;
 
-extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 static void fmt2(char* b, int v) { b[0]='0'+((v/10)%10); b[1]='0'+(v%10); b[2]='\0'; }
 
 bool datetimeMenuActive(){ return s_menuActive; }
@@ -392,7 +423,7 @@ void datetimeMenuDrawAndHandle() {
     u8g2.drawStr(x_arrow, yAcciones, ">");
   }
 
-  u8g2.sendBuffer();
+  lcdFlush();
 
   // Entradas
   const bool altDown  = (digitalRead(BUTTON_ALTITUDE) == HIGH);
@@ -58,9 +58,13 @@ void datetimeFormatEpoch_DDMMYY(uint32_t ts, char* out, size_t n);
 // ============================================================
 
 // Llamar justo antes de entrar a deep sleep.
-// - En IDF 5.x, el parámetro se ignora (usaremos el tiempo real dormido).
-// - En IDF 4.x, si duermes por TIMER, pasa los microsegundos programados.
-//   Si duermes por botón (sin TIMER), pasa 0 (no hay forma fiable de medir Δ).
+// - Guarda en RTC el epoch en µs junto al contador RTC: al despertar
+//   se suma el tiempo dormido sin truncar a segundos.
+// - planned_sleep_us: timer programado (0 si sólo botón/VBUS/ULP).
+//   Sólo se usa si al despertar por TIMER el contador RTC no avanzó.
+// - Los despertares de mantenimiento (ds_housekeeping) no pasan por
+//   aquí ni por datetimeInit(): el Δ cubre todo el sueño y cada
+//   arranque recalibra el reloj lento del contador RTC.
 void datetimeOnBeforeDeepSleep(uint64_t planned_sleep_us = 0);
 
 // Helper para la UI: true si la API de duración de deep sleep está disponible (IDF ≥ 5).
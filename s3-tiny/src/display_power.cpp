@@ -0,0 +1,183 @@
+#include "display_power.h"
+#include <driver/ledc.h>
+#include "driver/gpio.h"
+#include <esp_idf_version.h>
+#include "config.h"
+#include "ui_module.h"
+#include "sensor_module.h"
+#include "power_lock.h"
+#include "logbook.h"
+#include "lcd_flush.h"
+
+extern unsigned long getLastActivityMs();   // main.cpp
+
+#define DISP_LEDC_MODE  LEDC_LOW_SPEED_MODE
+#define DISP_LEDC_CH    ((ledc_channel_t)LCD_LEDC_CH)
+
+// Activo-bajo: duty máximo (2^bits) = pin alto todo el periodo = BL apagado
+static constexpr uint32_t kDutyMax = 1UL << LCD_LEDC_RES_BITS;
+
+// ------------------------------
+// Estado
+// ------------------------------
+static bool     s_userOn      = false;
+static uint32_t s_targetDuty  = kDutyMax;
+static uint32_t s_fadeEndMs   = 0;
+static bool     s_dimmed      = false;     // contraste bajo
+static bool     s_lcdAsleep   = false;
+
+struct DispStats {
+  uint32_t fades;
+  uint32_t lcdSleeps;
+  uint32_t lcdSleepMs;       // acumulado en power-save (sin el tramo actual)
+  uint32_t lcdSleepT0;
+};
+static DispStats s_st;
+
+// ------------------------------
+// Backlight
+// ------------------------------
+static inline uint32_t dutyForLevel(int level255) {
+  if (level255 < 0)   level255 = 0;
+  if (level255 > 255) level255 = 255;
+  return kDutyMax - (uint32_t)level255 * kDutyMax / 255;
+}
+
+static void blFadeTo(uint32_t duty) {
+  if (duty == s_targetDuty) return;
+#if ESP_IDF_VERSION_MAJOR >= 5
+  ledc_fade_stop(DISP_LEDC_MODE, DISP_LEDC_CH);   // nuevo destino a mitad de un fade
+#else
+  // IDF 4.4 no puede parar un fade (esperaría bloqueado): se aplica al terminar
+  if ((int32_t)(millis() - s_fadeEndMs) < 0) return;
+#endif
+  const uint32_t ms = (duty < s_targetDuty) ? DISP_BL_FADE_UP_MS : DISP_BL_FADE_DOWN_MS;
+  ledc_set_fade_time_and_start(DISP_LEDC_MODE, DISP_LEDC_CH, duty, ms, LEDC_FADE_NO_WAIT);
+  s_targetDuty = duty;
+  s_fadeEndMs  = millis() + ms;
+  s_st.fades++;
+}
+
+// Nivel por contexto: en salto el del usuario; si no, según inactividad
+static uint32_t blTargetDuty(uint32_t idleMs) {
+  if (!s_userOn) return kDutyMax;
+  const SensorMode m = getSensorMode();
+  const bool jump = (m == SENSOR_MODE_FREEFALL) || inJump || logbookIsActive();
+  if (!jump) {
+    if (m == SENSOR_MODE_AHORRO && idleMs >= DISP_BL_OFF_MS) return kDutyMax;
+    if (idleMs >= DISP_BL_DIM_MS) return dutyForLevel(brilloPantalla * DISP_BL_DIM_PCT / 100);
+  }
+  return dutyForLevel(brilloPantalla);
+}
+
+void displayPowerBegin() {
+  gpio_hold_dis((gpio_num_t)LCD_LED);   // retenido en alto durante el deep sleep
+  pinMode(LCD_LED, OUTPUT);
+  digitalWrite(LCD_LED, HIGH);
+
+  ledc_timer_config_t t = {
+    .speed_mode      = DISP_LEDC_MODE,
+    .duty_resolution = (ledc_timer_bit_t)LCD_LEDC_RES_BITS,
+    .timer_num       = LEDC_TIMER_0,
+    .freq_hz         = LCD_LEDC_FREQ,
+    .clk_cfg         = LEDC_AUTO_CLK
+  };
+  ledc_timer_config(&t);
+  ledc_channel_config_t ch = {
+    .gpio_num   = (int)LCD_LED,
+    .speed_mode = DISP_LEDC_MODE,
+    .channel    = DISP_LEDC_CH,
+    .intr_type  = LEDC_INTR_DISABLE,
+    .timer_sel  = LEDC_TIMER_0,
+    .duty       = kDutyMax,          // BL apagado desde el primer ciclo
+    .hpoint     = 0
+  };
+  ledc_channel_config(&ch);
+  ledc_fade_func_install(0);
+  s_userOn     = false;
+  s_targetDuty = kDutyMax;
+
+  u8g2.setPowerSave(false);
+  u8g2.setContrast(DISP_CONTRAST);
+  s_dimmed    = false;
+  s_lcdAsleep = false;
+}
+
+void displayPowerSetBacklight(bool on) {
+  s_userOn = on;
+  blFadeTo(blTargetDuty(millis() - getLastActivityMs()));
+}
+
+void displayPowerToggleBacklight() {
+  // Atenuado o apagado por inactividad: la pulsación sólo lo devuelve
+  if (s_userOn && s_targetDuty != dutyForLevel(brilloPantalla)) {
+    blFadeTo(dutyForLevel(brilloPantalla));
+    return;
+  }
+  displayPowerSetBacklight(!s_userOn);
+}
+
+bool displayPowerBacklightOn() { return s_userOn; }
+
+float displayPowerBacklightFrac() {
+  const uint32_t duty = ledc_get_duty(DISP_LEDC_MODE, DISP_LEDC_CH);
+  return (duty >= kDutyMax) ? 0.0f : (float)(kDutyMax - duty) / (float)kDutyMax;
+}
+
+// ------------------------------
+// LCD: contraste y power-save
+// ------------------------------
+static void lcdSetAsleep(bool asleep) {
+  if (asleep == s_lcdAsleep) return;
+  lcdFlushWaitIdle(5);               // no mezclar comandos con un DMA del frame
+  u8g2.setPowerSave(asleep);
+  s_lcdAsleep = asleep;
+  if (asleep) {
+    s_st.lcdSleeps++;
+    s_st.lcdSleepT0 = millis();
+    Serial.println("[DISP] LCD en power-save");
+  } else {
+    s_st.lcdSleepMs += millis() - s_st.lcdSleepT0;
+    uiRequestRefresh();              // frame completo al volver
+  }
+}
+
+static void lcdSetDimmed(bool dimmed) {
+  if (dimmed == s_dimmed) return;
+  lcdFlushWaitIdle(5);
+  u8g2.setContrast(dimmed ? DISP_DIM_CONTRAST : DISP_CONTRAST);
+  s_dimmed = dimmed;
+}
+
+bool displayPowerLcdAsleep() { return s_lcdAsleep; }
+
+void displayPowerTick() {
+  const uint32_t idle = millis() - getLastActivityMs();
+  const bool awake = (getSensorMode() != SENSOR_MODE_AHORRO) || powerLockActive() ||
+                     inJump || menuActivo;
+
+  lcdSetDimmed(!awake && idle >= DISP_DIM_MS);
+  lcdSetAsleep(!awake && !isUsbPresent() && DISP_LCD_SLEEP_MS > 0 && idle >= DISP_LCD_SLEEP_MS);
+  blFadeTo(blTargetDuty(idle));
+}
+
+void displayPowerOff() {
+  ledc_stop(DISP_LEDC_MODE, DISP_LEDC_CH, 1);   // salida en alto: BL apagado
+  gpio_hold_en((gpio_num_t)LCD_LED);
+  gpio_deep_sleep_hold_en();
+  lcdFlushWaitIdle(20);
+  u8g2.clearBuffer();
+  u8g2.sendBuffer();
+  u8g2.setPowerSave(true);
+  s_lcdAsleep = true;
+}
+
+void displayPowerDump() {
+  const uint32_t sleepMs = s_st.lcdSleepMs + (s_lcdAsleep ? millis() - s_st.lcdSleepT0 : 0);
+  Serial.printf("[DISP] lcd=%s contraste=%u bl usuario=%d ahora=%u%% destino=%u%% fades=%lu\n",
+                s_lcdAsleep ? "power-save" : "on", (unsigned)(s_dimmed ? DISP_DIM_CONTRAST : DISP_CONTRAST),
+                s_userOn ? 1 : 0, (unsigned)(displayPowerBacklightFrac() * 100.0f + 0.5f),
+                (unsigned)((kDutyMax - s_targetDuty) * 100 / kDutyMax), (unsigned long)s_st.fades);
+  Serial.printf("[DISP] power-save: %lu veces, %.0fs\n",
+                (unsigned long)s_st.lcdSleeps, sleepMs / 1000.0);
+}
@@ -0,0 +1,77 @@
+#ifndef DISPLAY_POWER_H
+#define DISPLAY_POWER_H
+
+// =====================================================
+// Energía de la pantalla: backlight, contraste y LCD
+// -----------------------------------------------------
+// Backlight (LEDC, activo-bajo): el usuario lo enciende o
+// apaga; el nivel lo decide el contexto y se alcanza con
+// fades por hardware del LEDC (sin CPU durante el fade):
+//  - en salto (FF o bitácora abierta): nivel del usuario,
+//  - en Ultra: atenuado tras DISP_BL_DIM_MS sin actividad,
+//  - en Ahorro: atenuado y, tras DISP_BL_OFF_MS, apagado.
+// Cualquier actividad vuelve al nivel del usuario.
+// LCD en Ahorro, sin lock ni USB: contraste bajo tras
+// DISP_DIM_MS sin actividad; el panel sigue encendido y el
+// HUD sigue con sus repintados espaciados (UI_AHORRO_TICK_MS).
+// Opcional (DISP_LCD_SLEEP_MS > 0): tras ese tiempo el ST7567
+// pasa a power-save (RAM conservada, bomba de carga parada):
+// la pantalla queda EN BLANCO y el HUD deja de repintar hasta
+// que cualquier actividad o salir de Ahorro lo despierta con
+// un frame completo.
+// El gobernador contabiliza el duty real (también a mitad
+// de un fade) y el estado del LCD. 'v' por Serial.
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef DISP_CONTRAST
+  #define DISP_CONTRAST        150
+#endif
+#ifndef DISP_DIM_CONTRAST
+  #define DISP_DIM_CONTRAST    5
+#endif
+#ifndef DISP_DIM_MS
+  #define DISP_DIM_MS          120000UL   // contraste bajo
+#endif
+#ifndef DISP_LCD_SLEEP_MS
+  #define DISP_LCD_SLEEP_MS    0UL        // ST7567 en power-save, en blanco (0 = nunca)
+#endif
+#ifndef DISP_BL_DIM_MS
+  #define DISP_BL_DIM_MS       15000UL
+#endif
+#ifndef DISP_BL_DIM_PCT
+  #define DISP_BL_DIM_PCT      30         // % del nivel del usuario
+#endif
+#ifndef DISP_BL_OFF_MS
+  #define DISP_BL_OFF_MS       60000UL    // sólo en Ahorro
+#endif
+#ifndef DISP_BL_FADE_UP_MS
+  #define DISP_BL_FADE_UP_MS   150
+#endif
+#ifndef DISP_BL_FADE_DOWN_MS
+  #define DISP_BL_FADE_DOWN_MS 800
+#endif
+
+// En initUI(), tras u8g2.begin(): LEDC + fades, contraste, BL apagado
+void displayPowerBegin();
+
+// Cada vuelta de la UI: contraste, power-save y nivel de backlight
+void displayPowerTick();
+
+// Backlight pedido por el usuario (nivel = brilloPantalla)
+void displayPowerSetBacklight(bool on);
+// Botón: si estaba atenuado por inactividad, sólo lo restaura
+void displayPowerToggleBacklight();
+bool displayPowerBacklightOn();
+
+// Estado real para el gobernador y la UI
+float displayPowerBacklightFrac();   // 0..1 del brillo máximo (duty actual)
+bool  displayPowerLcdAsleep();       // ST7567 en power-save: no repintar
+
+// Antes de deep sleep: LCD en power-save y pin del BL retenido en alto
+void displayPowerOff();
+
+void displayPowerDump();
+
+#endif // DISPLAY_POWER_H
@@ -0,0 +1,218 @@
+#include "ds_housekeeping.h"
+#include <Wire.h>
+#include <math.h>
+#include <esp_sleep.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include "driver/rtc_io.h"
+#include "config.h"
+#include "sensor_module.h"
+#include "bmp390_raw.h"
+#include "battery.h"
+#include "logbook.h"
+#include "warm_boot.h"
+#include "ulp_climb.h"
+#include "power_governor.h"
+
+// ---- forward decl. portátil del contador RTC en µs
+extern "C" uint64_t esp_rtc_get_time_us(void);
+
+// ------------------------------
+// Estadísticas (RTC slow mem)
+// ------------------------------
+struct HkStats {
+  uint32_t runs;
+  uint32_t aborted;          // botón/VBUS en alto: arranque normal
+  uint32_t noSnapshot;       // timer sin snapshot: de vuelta a dormir sin timer
+  uint32_t bmpErrors;
+  uint32_t ulpReads;         // presión tomada del ULP (sin tocar el bus)
+  uint32_t agzUpdates;
+  uint32_t agzOutside;       // lejos del cero: sin AGZ, la referencia envejece
+  uint32_t lbChecked;
+  uint32_t lbBad;
+  uint16_t lbCursor;         // próximo índice (más nuevo = 0)
+  uint16_t lbLastBad;        // índice + 1 del último malo (0 = ninguno)
+  uint32_t lastUs;
+  uint32_t maxUs;
+  uint64_t sumUs;
+  uint64_t lastRtcUs;        // esp_rtc_get_time_us() de la última presión
+  float    lastPa;
+  float    driftPaH;         // deriva de presión entre pasadas
+  float    agzStepM;         // última corrección AGZ
+};
+RTC_DATA_ATTR static HkStats s_hk;
+
+// ------------------------------
+// Pasos
+// ------------------------------
+// Con el ULP corriendo, su última muestra (el bus es suyo); si no,
+// FORCED como la del ULP por Wire
+static bool hkReadPressure(bool ulp, float &pa) {
+  if (ulp && ulpClimbLastPa(pa)) {
+    s_hk.ulpReads++;
+    return true;
+  }
+  if (ulp) return false;               // sin muestra aún: no se le quita el bus
+
+  bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_OSR, BMP390_OSR(3, 0));
+  bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_CONFIG, 0);
+
+  Bmp390Calib cal;
+  uint32_t up, ut;
+  if (!bmp390ReadCalib(Wire, BMP_ADDR, cal) || !bmp390ForcedRaw(Wire, BMP_ADDR, up, ut)) {
+    s_hk.bmpErrors++;
+    return false;
+  }
+  pa = (float)bmp390CompP(cal, up, bmp390CompT(cal, ut));
+  return true;
+}
+
+// AGZ como el del sensor, con una sola muestra y dt = tiempo
+// desde la pasada anterior
+static bool hkPressure(bool ulp, bool refOk) {
+  float pa;
+  if (!hkReadPressure(ulp, pa)) return false;
+
+  const uint64_t now = esp_rtc_get_time_us();
+  const float dtS = (s_hk.lastRtcUs != 0 && now > s_hk.lastRtcUs)
+                      ? (float)(now - s_hk.lastRtcUs) * 1e-6f : 0.0f;
+  const bool consecutive = dtS > 0.0f && dtS < 3.0f * DS_HK_PERIOD_S;
+  if (consecutive) s_hk.driftPaH = (pa - s_hk.lastPa) * 3600.0f / dtS;
+  s_hk.lastPa    = pa;
+  s_hk.lastRtcUs = now;
+
+  if (!refOk) return false;
+  const float rel = sensorPressureToAltitude(pa) - altitudReferencia + agzBias;
+  if (fabsf(rel) >= AGZ_WINDOW_M) {
+    s_hk.agzOutside++;
+    return false;
+  }
+
+  const float dt   = consecutive ? dtS : (float)DS_HK_PERIOD_S;
+  const float vmax = AGZ_RATE_LIMIT_MPH / 3600.0f * dt;
+  float step = -rel * fminf(dt / AGZ_TAU_SECONDS, 1.0f);
+  if (step >  vmax) step =  vmax;
+  if (step < -vmax) step = -vmax;
+  agzBias += step;
+  if (agzBias >  AGZ_BIAS_CLAMP_M) agzBias =  AGZ_BIAS_CLAMP_M;
+  if (agzBias < -AGZ_BIAS_CLAMP_M) agzBias = -AGZ_BIAS_CLAMP_M;
+  s_hk.agzStepM = step;
+  s_hk.agzUpdates++;
+  return true;
+}
+
+// El filtro monótono sigue desde el % mostrado antes de dormir
+static void hkBattery() {
+  batteryInit();
+  warmBootRestoreBattery();
+  batteryGetPercent();
+}
+
+static void hkLogbook() {
+  warmBootRestoreLogbook();            // cabecera del snapshot; LittleFS al leer
+  uint16_t n = 0;
+  if (!logbookGetCount(n) || n == 0) return;
+  for (uint8_t i = 0; i < DS_HK_LOG_RECORDS && i < n; ++i) {
+    const uint16_t idx = (s_hk.lbCursor < n) ? s_hk.lbCursor : 0;
+    JumpLog jl;
+    if (!logbookGetByIndex(idx, jl)) {
+      s_hk.lbBad++;
+      s_hk.lbLastBad = idx + 1;
+    }
+    s_hk.lbChecked++;
+    s_hk.lbCursor = (uint16_t)((idx + 1) % n);
+  }
+}
+
+// ------------------------------
+// API
+// ------------------------------
+bool dsHousekeepingWake() {
+#if DS_HK_ENABLE
+  return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER;
+#else
+  return false;
+#endif
+}
+
+void dsHousekeepingRun() {
+  // Alguien lo está usando: arranque normal (los pines siguen en el RTC)
+  if (rtc_gpio_get_level((gpio_num_t)WAKE_BTN_PIN) || rtc_gpio_get_level((gpio_num_t)CHARGE_ADC_PIN)) {
+    s_hk.aborted++;
+    Serial.println("[HK] boton/VBUS en alto: arranque normal");
+    return;
+  }
+
+  setCpuFrequencyMhz(DS_HK_CPU_MHZ);
+  // ULP corriendo: programa, línea base y SDA/SCL se quedan en el RTC
+  // (una subida lenta sigue sumando a través de la pasada)
+  const bool ulp = ulpClimbRunning();
+  if (!ulp) {
+    ulpClimbBoot();
+    Wire.begin(SDA_PIN, SCL_PIN);
+    Wire.setClock(400000);
+  }
+
+  bool tracked = false;
+  if (warmBootActive()) {
+    warmBootRestoreConfig();           // agzBias y config del snapshot
+    tracked = hkPressure(ulp, warmBootRestoreReference());
+    hkBattery();
+    hkLogbook();
+    warmBootResave(tracked);
+  } else {
+    // Sin snapshot no hay referencia ni cabecera: sólo deriva y batería
+    // (ULP con batería sana); dsHousekeepingArm() ya no arma el timer
+    s_hk.noSnapshot++;
+    hkPressure(ulp, false);
+    batteryInit();
+  }
+
+  const uint32_t us = (uint32_t)esp_timer_get_time();
+  s_hk.runs++;
+  s_hk.lastUs = us;
+  s_hk.sumUs += us;
+  if (us > s_hk.maxUs) s_hk.maxUs = us;
+  Serial.printf("[HK] %lu us: %.0f Pa (%+.0f Pa/h) AGZ=%.2f m%s bat=%d%% bitacora malos=%lu\n",
+                (unsigned long)us, s_hk.lastPa, s_hk.driftPaH, agzBias,
+                tracked ? "" : " (sin seguir)", batteryGetPercent(), (unsigned long)s_hk.lbBad);
+
+  powerGovReenterDeepSleep();
+}
+
+uint64_t dsHousekeepingArm() {
+#if DS_HK_ENABLE
+  if (DS_HK_PERIOD_S == 0 || !warmBootSaved()) return 0;   // sin pasada útil
+  const uint64_t us = (uint64_t)DS_HK_PERIOD_S * 1000000ULL;
+  esp_sleep_enable_timer_wakeup(us);
+  return us;
+#else
+  return 0;
+#endif
+}
+
+float dsHousekeepingAvgMa() {
+  if (!DS_HK_ENABLE || DS_HK_PERIOD_S == 0) return 0.0f;
+  const float runMs = s_hk.runs ? (float)(s_hk.sumUs / s_hk.runs) * 1e-3f : 60.0f;
+  return DS_HK_MA_AWAKE * (DS_HK_BOOT_MS + runMs) / (DS_HK_PERIOD_S * 1000.0f);
+}
+
+void dsHousekeepingDump() {
+  Serial.printf("[HK] periodo=%lus pasadas=%lu abortadas=%lu sin snapshot=%lu  ultima=%lu us media=%lu us max=%lu us  ~%.4f mA\n",
+                (unsigned long)DS_HK_PERIOD_S, (unsigned long)s_hk.runs, (unsigned long)s_hk.aborted,
+                (unsigned long)s_hk.noSnapshot,
+                (unsigned long)s_hk.lastUs, (unsigned long)(s_hk.runs ? s_hk.sumUs / s_hk.runs : 0),
+                (unsigned long)s_hk.maxUs, dsHousekeepingAvgMa());
+  Serial.printf("[HK] presion=%.0f Pa deriva=%+.0f Pa/h  AGZ: %lu correcciones (ultima %+.3f m), %lu fuera de ventana, BMP errores=%lu, del ULP=%lu\n",
+                s_hk.lastPa, s_hk.driftPaH, (unsigned long)s_hk.agzUpdates, s_hk.agzStepM,
+                (unsigned long)s_hk.agzOutside, (unsigned long)s_hk.bmpErrors,
+                (unsigned long)s_hk.ulpReads);
+  Serial.printf("[HK] bitacora: %lu revisados, %lu malos (ultimo idx=%d), cursor=%u\n",
+                (unsigned long)s_hk.lbChecked, (unsigned long)s_hk.lbBad,
+                (int)s_hk.lbLastBad - 1, (unsigned)s_hk.lbCursor);
+}
+
+void dsHousekeepingReset() {
+  memset(&s_hk, 0, sizeof(s_hk));
+  Serial.println("[HK] estadisticas a cero");
+}
@@ -0,0 +1,72 @@
+#ifndef DS_HOUSEKEEPING_H
+#define DS_HOUSEKEEPING_H
+
+// =====================================================
+// Mantenimiento en deep sleep por timer
+// -----------------------------------------------------
+// Además de botón/VBUS/ULP, el deep sleep despierta cada
+// DS_HK_PERIOD_S (salvo batería baja) y, con snapshot de
+// warm_boot válido, hace una pasada mínima sin HUD ni NVS
+// y vuelve a dormir:
+//  - presión: la última muestra del ULP si está corriendo
+//    (no se recarga ni se reinicia su línea base: una
+//    subida lenta no se pierde por la pasada); si no, una
+//    FORCED del BMP390 (P x8 / T x1). Deriva de presión y,
+//    si sigue cerca del cero, AGZ sobre el snapshot; la
+//    referencia queda como recién tomada (no caduca a las
+//    WARM_REF_MAX_AGE_S mientras se siga en tierra),
+//  - batería (multimuestreo) al % mostrado del snapshot,
+//  - CRC de DS_HK_LOG_RECORDS registros de la bitácora,
+//    con un cursor rotatorio en RTC que recorre el ring.
+// La hora no se toca: el contador RTC sigue la cuenta y
+// cada arranque recalibra el reloj lento, así la duración
+// del sueño se integra por tramos de DS_HK_PERIOD_S con
+// una calibración reciente (datetime_module).
+// Botón o VBUS en alto al despertar: arranque normal.
+// El timer sólo se arma con snapshot guardado: sin él
+// (WARM_BOOT_ENABLE=0, CRC malo) un despertar por timer
+// sólo mide presión y batería y vuelve a dormir sin timer.
+// Duración medida desde el arranque de la app (el
+// bootloader no cuenta). 'x' por Serial: estadísticas.
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef DS_HK_ENABLE
+  #define DS_HK_ENABLE         1
+#endif
+#ifndef DS_HK_PERIOD_S
+  #define DS_HK_PERIOD_S       900UL     // 15 min (0 = sin timer)
+#endif
+#ifndef DS_HK_LOG_RECORDS
+  #define DS_HK_LOG_RECORDS    4
+#endif
+#ifndef DS_HK_CPU_MHZ
+  #define DS_HK_CPU_MHZ        80
+#endif
+#ifndef DS_HK_MA_AWAKE
+  #define DS_HK_MA_AWAKE       22.0f     // modelo: placa despierta a DS_HK_CPU_MHZ
+#endif
+#ifndef DS_HK_BOOT_MS
+  #define DS_HK_BOOT_MS        35        // modelo: ROM + bootloader (no medible)
+#endif
+
+// Justo después de warmBootBegin(): ¿despertar por timer?
+bool dsHousekeepingWake();
+
+// Pasada de mantenimiento; no retorna si vuelve a dormir.
+// Si retorna, sigue el arranque normal (en caliente).
+void dsHousekeepingRun();
+
+// Al armar el deep sleep, tras warmBootSave(): timer de
+// mantenimiento si hay snapshot; devuelve los µs programados
+// (0 = sin timer)
+uint64_t dsHousekeepingArm();
+
+// Consumo medio que añade al deep sleep (gobernador)
+float dsHousekeepingAvgMa();
+
+void dsHousekeepingDump();
+void dsHousekeepingReset();
+
+#endif // DS_HOUSEKEEPING_H
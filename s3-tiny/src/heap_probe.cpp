@@ -0,0 +1,73 @@
+#include "heap_probe.h"
+
+#if ALT_HEAP_PROBE
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// ------------------------------
+// Envolturas (-Wl,--wrap=...)
+// ------------------------------
+extern "C" {
+void* __real_malloc(size_t n);
+void* __real_calloc(size_t n, size_t sz);
+void* __real_realloc(void* p, size_t n);
+}
+
+static TaskHandle_t      s_owner  = nullptr;   // tarea de loop()
+static volatile uint32_t s_allocs = 0;         // reservas de s_owner
+static volatile uint32_t s_bytes  = 0;
+
+static inline void countAlloc(size_t n) {
+  if (!s_owner || xTaskGetCurrentTaskHandle() != s_owner) return;
+  s_allocs++;
+  s_bytes += n;
+}
+
+extern "C" {
+void* __wrap_malloc(size_t n)                { countAlloc(n);      return __real_malloc(n); }
+void* __wrap_calloc(size_t n, size_t sz)     { countAlloc(n * sz); return __real_calloc(n, sz); }
+void* __wrap_realloc(void* p, size_t n)      { countAlloc(n);      return __real_realloc(p, n); }
+}
+
+// ------------------------------
+// Frames del HUD
+// ------------------------------
+static uint32_t s_frameA0 = 0, s_frameB0 = 0;
+static uint32_t s_frames = 0;          // frames medidos
+static uint32_t s_framesDirty = 0;     // frames con >= 1 reserva
+static uint32_t s_lastAllocs = 0, s_lastBytes = 0;
+static uint32_t s_maxAllocs = 0;
+static uint32_t s_sumAllocs = 0;
+
+void heapProbeFrameBegin() {
+  if (!s_owner) s_owner = xTaskGetCurrentTaskHandle();
+  s_frameA0 = s_allocs;
+  s_frameB0 = s_bytes;
+}
+
+void heapProbeFrameEnd() {
+  s_lastAllocs = s_allocs - s_frameA0;
+  s_lastBytes  = s_bytes  - s_frameB0;
+  s_frames++;
+  s_sumAllocs += s_lastAllocs;
+  if (s_lastAllocs) s_framesDirty++;
+  if (s_lastAllocs > s_maxAllocs) s_maxAllocs = s_lastAllocs;
+}
+
+void heapProbeDump() {
+  Serial.printf("[HEAP] hud frames=%lu con_reserva=%lu reservas: ultimo=%lu (%luB) max=%lu total=%lu | loop total=%lu free=%lu min=%lu\n",
+                (unsigned long)s_frames, (unsigned long)s_framesDirty,
+                (unsigned long)s_lastAllocs, (unsigned long)s_lastBytes,
+                (unsigned long)s_maxAllocs, (unsigned long)s_sumAllocs,
+                (unsigned long)s_allocs,
+                (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMinFreeHeap());
+}
+
+void heapProbeReset() {
+  s_frames = s_framesDirty = 0;
+  s_lastAllocs = s_lastBytes = s_maxAllocs = s_sumAllocs = 0;
+  Serial.println("[HEAP] reset");
+}
+
+#endif // ALT_HEAP_PROBE
@@ -0,0 +1,43 @@
+#ifndef HEAP_PROBE_H
+#define HEAP_PROBE_H
+
+// =====================================================
+// Contador de reservas de heap (malloc/calloc/realloc)
+// -----------------------------------------------------
+// Sólo en el env *-heap: el linker envuelve las funciones
+// (-Wl,--wrap=malloc,...) y se cuentan las llamadas hechas
+// desde la tarea de loop(). Incluye String/new (pasan por
+// malloc); no ve heap_caps_malloc directo del IDF.
+//
+// HEAP_PROBE_FRAME_BEGIN/END() delimitan un frame del HUD;
+// en régimen estable se espera 0 reservas por frame.
+// Volcado por Serial ('h' volcar, 'H' reset).
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef ALT_HEAP_PROBE
+  #define ALT_HEAP_PROBE 0
+#endif
+
+#if ALT_HEAP_PROBE
+
+void heapProbeFrameBegin();
+void heapProbeFrameEnd();
+void heapProbeDump();
+void heapProbeReset();
+
+#define HEAP_PROBE_FRAME_BEGIN() heapProbeFrameBegin()
+#define HEAP_PROBE_FRAME_END()   heapProbeFrameEnd()
+
+#else
+
+#define HEAP_PROBE_FRAME_BEGIN() do {} while (0)
+#define HEAP_PROBE_FRAME_END()   do {} while (0)
+
+static inline void heapProbeDump()  { Serial.println("[HEAP] deshabilitado (env esp32-s3-fh4r2-heap)"); }
+static inline void heapProbeReset() {}
+
+#endif // ALT_HEAP_PROBE
+
+#endif // HEAP_PROBE_H
@@ -0,0 +1,249 @@
+#include "hil_link.h"
+#include <esp_timer.h>
+#include <string.h>
+
+// ------------------------------
+// Protocolo
+// ------------------------------
+static constexpr uint8_t HIL_SYNC0 = 0xA5;
+static constexpr uint8_t HIL_SYNC1 = 0x5A;
+static constexpr uint8_t HIL_MAX_PAYLOAD = 32;
+
+enum : uint8_t {
+  HIL_T_ENTER  = 0x01,
+  HIL_T_EXIT   = 0x02,
+  HIL_T_SAMPLE = 0x03,
+  HIL_T_PING   = 0x04,
+  HIL_T_ACK    = 0x81,
+  HIL_T_LAT    = 0x83,
+  HIL_T_PONG   = 0x84,
+};
+
+enum ParseState : uint8_t { PS_SYNC0, PS_SYNC1, PS_TYPE, PS_LEN, PS_PAYLOAD, PS_CRC0, PS_CRC1 };
+
+static ParseState s_ps = PS_SYNC0;
+static uint8_t    s_type = 0, s_len = 0, s_pos = 0;
+static uint8_t    s_payload[HIL_MAX_PAYLOAD];
+static uint16_t   s_crcRx = 0;
+
+// ------------------------------
+// Sesión
+// ------------------------------
+static bool     s_active      = false;
+static uint32_t s_lastRxMs    = 0;
+static bool     s_refPending  = false;
+static float    s_refPa       = 0.0f;
+
+// Última muestra recibida
+static bool     s_fresh       = false;
+static uint16_t s_seq         = 0;
+static float    s_presPa      = 0.0f;
+static float    s_tempC       = 0.0f;
+static int64_t  s_rxUs        = 0;
+
+// Muestra consumida pendiente de llegar a pantalla
+static bool     s_latPending  = false;
+static uint16_t s_latSeq      = 0;
+static int64_t  s_latRxUs     = 0;
+static uint32_t s_latUseUs    = 0;
+
+static uint16_t s_superseded  = 0;   // muestras pisadas antes de consumirse
+static uint16_t s_underrun    = 0;   // el firmware pidió muestra y no había
+
+// LAT cerrada en la tarea de render (lcd_flush): sale por Serial en hilTick()
+static portMUX_TYPE s_latMux  = portMUX_INITIALIZER_UNLOCKED;
+static bool     s_latReady    = false;
+static uint8_t  s_latOut[14];
+
+// CRC16-CCITT (0x1021, init 0xFFFF), igual que la bitácora
+static uint16_t crc16(const uint8_t* d, size_t n, uint16_t crc = 0xFFFF) {
+  while (n--) {
+    crc ^= (uint16_t)(*d++) << 8;
+    for (uint8_t i = 0; i < 8; ++i) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+static void sendFrame(uint8_t type, const void* payload, uint8_t len) {
+  uint8_t buf[4 + HIL_MAX_PAYLOAD + 2];
+  buf[0] = HIL_SYNC0; buf[1] = HIL_SYNC1; buf[2] = type; buf[3] = len;
+  if (len) memcpy(&buf[4], payload, len);
+  const uint16_t crc = crc16(&buf[2], (size_t)len + 2);
+  buf[4 + len] = (uint8_t)(crc & 0xFF);
+  buf[5 + len] = (uint8_t)(crc >> 8);
+  Serial.write(buf, (size_t)len + 6);
+}
+
+static void sendAck(uint8_t type, uint8_t status) {
+  const uint8_t p[2] = { type, status };
+  sendFrame(HIL_T_ACK, p, sizeof(p));
+}
+
+static void enterHil() {
+  s_active     = true;
+  s_fresh      = false;
+  portENTER_CRITICAL(&s_latMux);
+  s_latPending = false;
+  s_latReady   = false;
+  portEXIT_CRITICAL(&s_latMux);
+  s_superseded = 0;
+  s_underrun   = 0;
+  Serial.println("[HIL] ON");
+}
+
+static void exitHil(const char* why) {
+  s_active     = false;
+  s_fresh      = false;
+  portENTER_CRITICAL(&s_latMux);
+  s_latPending = false;
+  s_latReady   = false;
+  portEXIT_CRITICAL(&s_latMux);
+  s_refPending = false;
+  Serial.printf("[HIL] OFF (%s)\n", why);
+}
+
+// ------------------------------
+// Tramas recibidas
+// ------------------------------
+static void handleFrame() {
+  s_lastRxMs = millis();
+
+  switch (s_type) {
+    case HIL_T_ENTER:
+      if (s_len >= 4) {
+        memcpy(&s_refPa, &s_payload[0], 4);
+        s_refPending = true;
+      }
+      enterHil();
+      sendAck(HIL_T_ENTER, 0);
+      break;
+
+    case HIL_T_EXIT:
+      exitHil("host");
+      sendAck(HIL_T_EXIT, 0);
+      break;
+
+    case HIL_T_SAMPLE: {
+      if (!s_active || s_len < 14) { sendAck(HIL_T_SAMPLE, 1); break; }
+      if (s_fresh) s_superseded++;
+      memcpy(&s_seq,    &s_payload[0],  2);
+      // host_us (payload[2..5]) sólo le sirve al host
+      memcpy(&s_presPa, &s_payload[6],  4);
+      memcpy(&s_tempC,  &s_payload[10], 4);
+      s_rxUs  = esp_timer_get_time();
+      s_fresh = true;
+      break;
+    }
+
+    case HIL_T_PING: {
+      uint8_t p[8];
+      memset(p, 0, sizeof(p));
+      if (s_len >= 4) memcpy(&p[0], &s_payload[0], 4);
+      const uint32_t devUs = (uint32_t)esp_timer_get_time();
+      memcpy(&p[4], &devUs, 4);
+      sendFrame(HIL_T_PONG, p, sizeof(p));
+      break;
+    }
+
+    default:
+      sendAck(s_type, 2);   // tipo desconocido
+      break;
+  }
+}
+
+bool hilFeedByte(uint8_t b) {
+  switch (s_ps) {
+    case PS_SYNC0:
+      if (b != HIL_SYNC0) return false;
+      s_ps = PS_SYNC1;
+      return true;
+    case PS_SYNC1:
+      if (b != HIL_SYNC1) { s_ps = PS_SYNC0; return false; }
+      s_ps = PS_TYPE;
+      return true;
+    case PS_TYPE:
+      s_type = b; s_ps = PS_LEN;
+      return true;
+    case PS_LEN:
+      if (b > HIL_MAX_PAYLOAD) { s_ps = PS_SYNC0; return true; }
+      s_len = b; s_pos = 0;
+      s_ps = s_len ? PS_PAYLOAD : PS_CRC0;
+      return true;
+    case PS_PAYLOAD:
+      s_payload[s_pos++] = b;
+      if (s_pos >= s_len) s_ps = PS_CRC0;
+      return true;
+    case PS_CRC0:
+      s_crcRx = b; s_ps = PS_CRC1;
+      return true;
+    case PS_CRC1: {
+      s_crcRx |= (uint16_t)b << 8;
+      s_ps = PS_SYNC0;
+      const uint8_t hdr[2] = { s_type, s_len };
+      const uint16_t crc = crc16(s_payload, s_len, crc16(hdr, 2));
+      if (crc == s_crcRx) handleFrame();
+      return true;
+    }
+  }
+  s_ps = PS_SYNC0;
+  return false;
+}
+
+void hilTick() {
+  if (s_active && (millis() - s_lastRxMs) >= HIL_TIMEOUT_MS) exitHil("timeout");
+
+  uint8_t p[sizeof(s_latOut)];
+  portENTER_CRITICAL(&s_latMux);
+  const bool ready = s_latReady;
+  if (ready) memcpy(p, s_latOut, sizeof(p));
+  s_latReady = false;
+  portEXIT_CRITICAL(&s_latMux);
+  if (ready) sendFrame(HIL_T_LAT, p, sizeof(p));
+}
+
+bool hilActive() { return s_active; }
+
+// ------------------------------
+// Consumo desde sensor/UI
+// ------------------------------
+bool hilTakeSample(double &pressure_pa, double &temp_c) {
+  if (!s_active) return false;
+  if (!s_fresh) { s_underrun++; return false; }
+
+  pressure_pa = s_presPa;
+  temp_c      = s_tempC;
+  s_fresh     = false;
+
+  const uint32_t useUs = (uint32_t)(esp_timer_get_time() - s_rxUs);
+  portENTER_CRITICAL(&s_latMux);
+  s_latPending = true;
+  s_latSeq     = s_seq;
+  s_latRxUs    = s_rxUs;
+  s_latUseUs   = useUs;
+  portEXIT_CRITICAL(&s_latMux);
+  return true;
+}
+
+bool hilTakeReference(float &ref_pa) {
+  if (!s_refPending) return false;
+  s_refPending = false;
+  ref_pa = s_refPa;
+  return true;
+}
+
+// Desde la tarea de render: sólo sella y prepara la trama
+void hilOnFrameSent() {
+  const int64_t now = esp_timer_get_time();
+  portENTER_CRITICAL(&s_latMux);
+  if (s_latPending) {
+    s_latPending = false;
+    const uint32_t frameUs = (uint32_t)(now - s_latRxUs);
+    memcpy(&s_latOut[0],  &s_latSeq,     2);
+    memcpy(&s_latOut[2],  &s_latUseUs,   4);
+    memcpy(&s_latOut[6],  &frameUs,      4);
+    memcpy(&s_latOut[10], &s_superseded, 2);
+    memcpy(&s_latOut[12], &s_underrun,   2);
+    s_latReady = true;
+  }
+  portEXIT_CRITICAL(&s_latMux);
+}
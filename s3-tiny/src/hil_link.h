@@ -0,0 +1,57 @@
+#ifndef HIL_LINK_H
+#define HIL_LINK_H
+
+// =====================================================
+// HIL: inyección de presión/temperatura por USB-CDC
+// -----------------------------------------------------
+// Un host envía muestras al ritmo real del sensor y el
+// firmware las usa en updateSensorData() en lugar de leer
+// el BMP390 por I2C. UI, bitácora, sueño y vibro corren de
+// verdad. Se activa/desactiva en caliente (no requiere
+// recompilar como ALT_SIM; si ALT_SIM != 0 la simulación
+// sigue teniendo prioridad).
+//
+// Trama (little-endian):
+//   A5 5A | tipo u8 | len u8 | payload[len] | crc16-ccitt(tipo..payload)
+//
+// Host -> equipo
+//   0x01 ENTER   [ref_pa f32]  (opcional: presión de referencia = 0 m)
+//   0x02 EXIT
+//   0x03 SAMPLE  seq u16, host_us u32, pres_pa f32, temp_c f32
+//   0x04 PING    host_us u32
+// Equipo -> host
+//   0x81 ACK     tipo u8, estado u8 (0=ok)
+//   0x83 LAT     seq u16, rx_to_use_us u32, rx_to_frame_us u32,
+//                superseded u16, underrun u16
+//   0x84 PONG    host_us u32, dev_us u32
+//
+// Si no llega nada en HIL_TIMEOUT_MS se sale de HIL solo.
+// Host: tools/hil_stream.py (perfil sintético o CSV, resumen
+// de las LAT).
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef HIL_TIMEOUT_MS
+  #define HIL_TIMEOUT_MS 3000UL
+#endif
+
+// Parser: devuelve true si el byte pertenece a una trama HIL
+// (el llamador no debe interpretarlo como comando de texto)
+bool hilFeedByte(uint8_t b);
+
+void hilTick();                         // timeout de sesión + LAT pendiente
+bool hilActive();
+
+// updateSensorData(): toma la muestra más reciente (false si no hay nueva)
+bool hilTakeSample(double &pressure_pa, double &temp_c);
+
+// Referencia pedida en ENTER (una sola vez por sesión)
+bool hilTakeReference(float &ref_pa);
+
+// lcd_flush: frame del HUD ya en el panel (cierra la medida de
+// latencia). Con DMA corre en la tarea de render; la trama LAT
+// sale después por Serial desde hilTick()
+void hilOnFrameSent();
+
+#endif // HIL_LINK_H
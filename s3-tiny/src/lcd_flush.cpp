@@ -0,0 +1,266 @@
+#include "lcd_flush.h"
+#include "ui_module.h"
+#include "lcd_spi_dma.h"
+#include "loop_sched.h"
+#include <esp_timer.h>
+#include <string.h>
+
+#if LCD_USE_HW_SPI_DMA
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+#endif
+
+// ------------------------------
+// Estado
+// ------------------------------
+static constexpr uint8_t  LCD_TILES_W = 16;          // 128 px / 8
+static constexpr uint8_t  LCD_TILES_H = 8;           // 64 px / 8
+static constexpr uint16_t LCD_BUF_LEN = LCD_TILES_W * LCD_TILES_H * 8;
+
+static uint8_t       s_shadow[LCD_BUF_LEN];          // lo que tiene el LCD
+static bool          s_valid = false;
+static LcdFlushStats s_st;
+static bool          s_stInit = false;
+static portMUX_TYPE  s_stMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t      s_flushEmaUs = 0;           // EMA 1/8 de frames enviados
+static int64_t       s_inputUs = 0;              // flanco de botón aún sin frame
+
+static inline void ensureStats() {
+  if (s_stInit) return;
+  memset(&s_st, 0, sizeof(s_st));
+  s_st.us.reset();
+  s_st.callUs.reset();
+  s_st.s2p.reset();
+  s_st.b2p.reset();
+  s_stInit = true;
+}
+
+static inline bool tileDirty(const uint8_t* buf, uint8_t tx, uint8_t ty) {
+  const uint16_t off = (uint16_t)ty * (LCD_TILES_W * 8) + (uint16_t)tx * 8;
+  return memcmp(buf + off, s_shadow + off, 8) != 0;
+}
+
+static inline void sendRun(uint8_t* buf, uint8_t tx, uint8_t ty, uint8_t tw) {
+#if LCD_USE_HW_SPI_DMA
+  lcdDmaSendArea(buf, tx, ty, tw);
+#else
+  (void)buf;
+  u8g2.updateDisplayArea(tx, ty, tw, 1);
+#endif
+}
+
+// Diff contra la sombra y envío de tramos; devuelve tiles/tramos enviados
+static void diffAndSend(uint8_t* buf, bool full, uint16_t& tiles, uint16_t& runs) {
+  tiles = 0; runs = 0;
+  for (uint8_t ty = 0; ty < LCD_TILES_H; ++ty) {
+    if (full) {
+      sendRun(buf, 0, ty, LCD_TILES_W);
+      tiles += LCD_TILES_W; runs++;
+      continue;
+    }
+    int8_t  runStart = -1;   // primer tile sucio del tramo abierto
+    uint8_t runEnd   = 0;    // último tile sucio del tramo
+    for (uint8_t tx = 0; tx < LCD_TILES_W; ++tx) {
+      if (!tileDirty(buf, tx, ty)) continue;
+      if (runStart >= 0 && (tx - runEnd - 1) > LCD_FLUSH_MERGE_GAP) {
+        sendRun(buf, runStart, ty, runEnd - runStart + 1);
+        tiles += runEnd - runStart + 1; runs++;
+        runStart = -1;
+      }
+      if (runStart < 0) runStart = tx;
+      runEnd = tx;
+    }
+    if (runStart >= 0) {
+      sendRun(buf, runStart, ty, runEnd - runStart + 1);
+      tiles += runEnd - runStart + 1; runs++;
+    }
+  }
+  if (tiles) memcpy(s_shadow, buf, LCD_BUF_LEN);
+}
+
+static void recordFlush(uint16_t tiles, uint16_t runs, bool full, uint32_t dt, int64_t sampleUs,
+                        int64_t inputUs) {
+  const int64_t tEnd = esp_timer_get_time();
+  portENTER_CRITICAL(&s_stMux);
+  ensureStats();
+  s_st.frames++;
+  if (full) s_st.full++;
+  s_st.lastTiles = tiles;
+  s_st.lastBytes = (uint16_t)(tiles * 8 + runs * LCD_FLUSH_CMD_BYTES);
+  s_st.lastUs    = dt;
+  s_st.bytesTotal += s_st.lastBytes;
+  if (tiles) {
+    s_st.us.add(dt);
+    s_flushEmaUs = s_flushEmaUs ? (s_flushEmaUs * 7 + dt) / 8 : dt;
+  } else s_st.skipped++;
+  if (tiles && sampleUs > 0 && tEnd > sampleUs) s_st.s2p.add((uint32_t)(tEnd - sampleUs));
+  if (tiles && inputUs > 0 && tEnd > inputUs)   s_st.b2p.add((uint32_t)(tEnd - inputUs));
+  portEXIT_CRITICAL(&s_stMux);
+}
+
+static inline void recordCall(uint32_t dt, bool dropped) {
+  portENTER_CRITICAL(&s_stMux);
+  ensureStats();
+  s_st.callUs.add(dt);
+  if (dropped) s_st.dropped++;
+  portEXIT_CRITICAL(&s_stMux);
+}
+
+#if LCD_USE_HW_SPI_DMA
+// ------------------------------
+// Tarea de render (doble buffer)
+// ------------------------------
+#ifndef LCD_RENDER_TASK_PRIO
+  #define LCD_RENDER_TASK_PRIO 2
+#endif
+#ifndef LCD_RENDER_TASK_CORE
+  #define LCD_RENDER_TASK_CORE 0
+#endif
+
+static TaskHandle_t   s_task   = nullptr;
+static volatile bool  s_busy   = false;    // la tarea tiene un frame en vuelo
+static uint8_t*       s_txBuf  = nullptr;
+static bool           s_txFull = false;
+static int64_t        s_txSampleUs = 0;
+static int64_t        s_txInputUs  = 0;
+static LcdShownFn     s_txShown    = nullptr;
+static int64_t        s_pendingSampleUs = 0;   // del frame aplazado
+static LcdShownFn     s_pendingShown    = nullptr;
+static uint8_t        s_drawIdx = 0;       // buffer donde dibuja u8g2
+static bool           s_pending = false;   // frame aplazado por bus ocupado
+
+static void lcdRenderTask(void*) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    const int64_t t0 = esp_timer_get_time();
+    uint16_t tiles, runs;
+    lcdDmaLock();
+    diffAndSend(s_txBuf, s_txFull, tiles, runs);
+    lcdDmaUnlock();
+    recordFlush(tiles, runs, s_txFull, (uint32_t)(esp_timer_get_time() - t0), s_txSampleUs, s_txInputUs);
+    const LcdShownFn shown = s_txShown;
+    s_txShown = nullptr;
+    s_busy = false;
+    if (shown) shown();
+    if (s_pending) schedWake();   // frame aplazado: que el loop lo envíe ya
+  }
+}
+
+static void ensureTask() {
+  if (s_task) return;
+  xTaskCreatePinnedToCore(lcdRenderTask, "lcd", 3072, nullptr,
+                          LCD_RENDER_TASK_PRIO, &s_task, LCD_RENDER_TASK_CORE);
+}
+
+void lcdFlush(int64_t sampleUs, LcdShownFn onShown) {
+  const int64_t t0 = esp_timer_get_time();
+  ensureTask();
+
+  // Frame anterior aún en el bus: no esperamos. Queda en el buffer
+  // de dibujo y lcdFlushTick() lo envía cuando el bus se libere.
+  if (s_busy) {
+    s_pending = true;
+    if (sampleUs) s_pendingSampleUs = sampleUs;
+    if (onShown)  s_pendingShown    = onShown;
+    recordCall((uint32_t)(esp_timer_get_time() - t0), true);
+    return;
+  }
+  if (!sampleUs) sampleUs = s_pendingSampleUs;
+  if (!onShown)  onShown  = s_pendingShown;
+  s_pending = false;
+  s_pendingSampleUs = 0;
+  s_pendingShown    = nullptr;
+
+  uint8_t* ready = lcdDmaFrameBuffer(s_drawIdx);
+  s_drawIdx ^= 1;
+  uint8_t* next = lcdDmaFrameBuffer(s_drawIdx);
+  memcpy(next, ready, LCD_BUF_LEN);             // u8g2 conserva el contenido
+  u8g2.getU8g2()->tile_buf_ptr = next;
+
+  s_txBuf  = ready;
+  s_txFull = !s_valid;
+  s_txSampleUs = sampleUs;
+  s_txShown    = onShown;
+  s_txInputUs  = s_inputUs;                     // el botón queda reflejado en este frame
+  s_inputUs    = 0;
+  s_valid  = true;
+  s_busy   = true;
+  xTaskNotifyGive(s_task);
+
+  recordCall((uint32_t)(esp_timer_get_time() - t0), false);
+}
+
+void lcdFlushTick() {
+  if (s_pending && !s_busy) lcdFlush(0, nullptr);
+}
+
+bool lcdFlushWaitIdle(uint32_t timeoutMs) {
+  const uint32_t t0 = millis();
+  while (s_busy) {
+    if ((millis() - t0) >= timeoutMs) return false;
+    vTaskDelay(1);
+  }
+  return true;
+}
+
+#else
+// ------------------------------
+// SPI software: todo en el llamador
+// ------------------------------
+void lcdFlush(int64_t sampleUs, LcdShownFn onShown) {
+  const int64_t t0 = esp_timer_get_time();
+  const bool full = !s_valid;
+  uint16_t tiles, runs;
+  diffAndSend(u8g2.getBufferPtr(), full, tiles, runs);
+  s_valid = true;
+  const uint32_t dt = (uint32_t)(esp_timer_get_time() - t0);
+  recordFlush(tiles, runs, full, dt, sampleUs, s_inputUs);
+  s_inputUs = 0;
+  recordCall(dt, false);
+  if (onShown) onShown();
+}
+
+void lcdFlushTick() {}
+bool lcdFlushWaitIdle(uint32_t) { return true; }
+
+#endif // LCD_USE_HW_SPI_DMA
+
+// ------------------------------
+// API
+// ------------------------------
+void lcdFlushInvalidate() { s_valid = false; }
+
+uint32_t lcdFlushEstimateUs() { return s_flushEmaUs; }
+
+void lcdFlushMarkInput() { if (!s_inputUs) s_inputUs = esp_timer_get_time(); }
+
+LcdFlushStats lcdFlushStats() {
+  portENTER_CRITICAL(&s_stMux);
+  ensureStats();
+  LcdFlushStats copy = s_st;
+  portEXIT_CRITICAL(&s_stMux);
+  return copy;
+}
+
+void lcdFlushDump() {
+  const LcdFlushStats st = lcdFlushStats();
+  const uint32_t sent = st.frames - st.skipped;
+  Serial.printf("[LCD] %s frames=%lu iguales=%lu completos=%lu aplazados=%lu bytes=%llu (media %lu B/frame enviado, completo=%u B)\n",
+                LCD_USE_HW_SPI_DMA ? "spi-dma" : "spi-sw",
+                (unsigned long)st.frames, (unsigned long)st.skipped, (unsigned long)st.full,
+                (unsigned long)st.dropped, (unsigned long long)st.bytesTotal,
+                (unsigned long)(sent ? (uint32_t)(st.bytesTotal / sent) : 0),
+                (unsigned)(LCD_BUF_LEN + LCD_TILES_H * LCD_FLUSH_CMD_BYTES));
+  st.us.print("[LCD]", "flush");
+  st.callUs.print("[LCD]", "llamada");
+  st.s2p.print("[LCD]", "muestra>lcd");
+  st.b2p.print("[LCD]", "boton>lcd");
+}
+
+void lcdFlushReset() {
+  portENTER_CRITICAL(&s_stMux);
+  s_stInit = false;
+  ensureStats();
+  portEXIT_CRITICAL(&s_stMux);
+  Serial.println("[LCD] reset");
+}
@@ -0,0 +1,75 @@
+#ifndef LCD_FLUSH_H
+#define LCD_FLUSH_H
+
+// =====================================================
+// Volcado parcial del ST7567 (tiles sucios)
+// -----------------------------------------------------
+// Guarda una copia (1 KB) del último frame enviado y, en
+// cada lcdFlush(), compara el buffer de u8g2 tile a tile
+// (8x8 px = 8 bytes). Por cada página envía sólo los tramos
+// de columnas cambiados con updateDisplayArea(). Tramos
+// separados por <= LCD_FLUSH_MERGE_GAP tiles limpios se unen
+// (reposicionar columna cuesta casi lo mismo que un tile).
+//
+// lcdFlushInvalidate(): el próximo flush es completo
+// (tras begin(), power-save o si el LCD pudo perder la RAM).
+//
+// Con LCD_USE_HW_SPI_DMA (lcd_spi_dma.h) el diff y el envío
+// corren en una tarea de render: lcdFlush() sólo intercambia
+// el doble buffer y la despierta. Si el frame anterior sigue
+// en el bus no se espera: el nuevo se aplaza a lcdFlushTick().
+// =====================================================
+
+#include <Arduino.h>
+#include "log_hist.h"
+
+#ifndef LCD_FLUSH_MERGE_GAP
+  #define LCD_FLUSH_MERGE_GAP 1
+#endif
+
+// Bytes de comando por tramo (página + columna alta/baja)
+#ifndef LCD_FLUSH_CMD_BYTES
+  #define LCD_FLUSH_CMD_BYTES 3
+#endif
+
+struct LcdFlushStats {
+  uint32_t frames;       // frames volcados
+  uint32_t skipped;      // frames idénticos (0 bytes)
+  uint32_t full;         // volcados completos
+  uint32_t dropped;      // aplazados por bus ocupado (sólo DMA)
+  uint64_t bytesTotal;
+  uint16_t lastBytes;    // último frame: bytes enviados (datos + comandos)
+  uint16_t lastTiles;
+  uint32_t lastUs;       // último frame: tiempo de diff + envío
+  LogHist  us;           // tiempo por frame enviado (tarea de render si DMA)
+  LogHist  callUs;       // tiempo bloqueado en lcdFlush() (loop)
+  LogHist  s2p;          // muestra del sensor -> fin de envío al LCD
+  LogHist  b2p;          // flanco de botón -> fin de envío del frame que lo refleja
+};
+
+// sampleUs: esp_timer de la muestra que este frame muestra por primera
+// vez (0 = no medir). Se cierra al terminar de salir por el bus.
+// onShown: se llama cuando este frame terminó de salir por el bus (con
+// DMA desde la tarea de render; un frame aplazado lo conserva)
+typedef void (*LcdShownFn)();
+void lcdFlush(int64_t sampleUs = 0, LcdShownFn onShown = nullptr);
+void lcdFlushInvalidate();
+
+// UI: flanco de botón. Se cierra con el primer frame que cambie algo
+// (b2p); si el siguiente frame es idéntico, la marca se descarta.
+void lcdFlushMarkInput();
+
+// Cada vuelta de loop(): envía el frame aplazado si lo hay
+void lcdFlushTick();
+
+// Antes de light/deep sleep o de cambiar la frecuencia de CPU
+bool lcdFlushWaitIdle(uint32_t timeoutMs);
+
+// Media móvil del tiempo de envío de un frame (para compensar latencia)
+uint32_t lcdFlushEstimateUs();
+
+LcdFlushStats lcdFlushStats();
+void lcdFlushDump();
+void lcdFlushReset();
+
+#endif // LCD_FLUSH_H
@@ -0,0 +1,159 @@
+#include "lcd_spi_dma.h"
+
+#if LCD_USE_HW_SPI_DMA
+
+#include "config.h"
+#include <driver/spi_master.h>
+#include <driver/gpio.h>
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <string.h>
+
+// ------------------------------
+// Estado
+// ------------------------------
+DMA_ATTR static uint8_t s_fb[2][LCD_FB_LEN];
+
+static spi_device_handle_t s_dev   = nullptr;
+static SemaphoreHandle_t   s_mutex = nullptr;
+static u8x8_t*             s_u8x8  = nullptr;   // para leer x_offset del controlador
+
+// Bytes de u8g2 acumulados entre SET_DC/END_TRANSFER
+DMA_ATTR static uint8_t s_cadBuf[128];
+static uint16_t s_cadLen = 0;
+static uint8_t  s_cadDc  = 0;
+
+// DC viaja en t->user (0 = comando, 1 = datos)
+static void IRAM_ATTR lcdPreCb(spi_transaction_t* t) {
+  gpio_set_level((gpio_num_t)LCD_DC, (int)(intptr_t)t->user);
+}
+
+static void busInit() {
+  if (s_dev) return;
+  s_mutex = xSemaphoreCreateMutex();
+
+  spi_bus_config_t bus = {};
+  bus.mosi_io_num     = LCD_MOSI;
+  bus.miso_io_num     = -1;
+  bus.sclk_io_num     = LCD_SCK;
+  bus.quadwp_io_num   = -1;
+  bus.quadhd_io_num   = -1;
+  bus.max_transfer_sz = LCD_FB_LEN;
+  ESP_ERROR_CHECK(spi_bus_initialize(SPI2_HOST, &bus, SPI_DMA_CH_AUTO));
+
+  spi_device_interface_config_t dev = {};
+  dev.mode           = 0;
+  dev.clock_speed_hz = LCD_SPI_HZ;
+  dev.spics_io_num   = LCD_CS;
+  dev.queue_size     = 2;
+  dev.pre_cb         = lcdPreCb;
+  ESP_ERROR_CHECK(spi_bus_add_device(SPI2_HOST, &dev, &s_dev));
+}
+
+static void xfer(const uint8_t* data, size_t len, uint8_t dc) {
+  if (!len) return;
+  spi_transaction_t t = {};
+  t.length    = len * 8;
+  t.tx_buffer = data;
+  t.user      = (void*)(intptr_t)dc;
+  spi_device_polling_transmit(s_dev, &t);
+}
+
+static inline void cadFlush() {
+  xfer(s_cadBuf, s_cadLen, s_cadDc);
+  s_cadLen = 0;
+}
+
+// ------------------------------
+// Callbacks u8x8
+// ------------------------------
+static uint8_t lcdDmaByteCb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+  switch (msg) {
+    case U8X8_MSG_BYTE_INIT:
+      s_u8x8 = u8x8;
+      busInit();
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      if (s_cadLen && arg_int != s_cadDc) cadFlush();
+      s_cadDc = arg_int;
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      xSemaphoreTake(s_mutex, portMAX_DELAY);
+      s_cadLen = 0;
+      break;
+    case U8X8_MSG_BYTE_SEND: {
+      const uint8_t* p = (const uint8_t*)arg_ptr;
+      while (arg_int--) {
+        s_cadBuf[s_cadLen++] = *p++;
+        if (s_cadLen == sizeof(s_cadBuf)) cadFlush();
+      }
+      break;
+    }
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      cadFlush();
+      xSemaphoreGive(s_mutex);
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+static uint8_t lcdDmaGpioCb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+  (void)u8x8; (void)arg_ptr;
+  switch (msg) {
+    case U8X8_MSG_GPIO_AND_DELAY_INIT:
+      pinMode(LCD_DC, OUTPUT);
+      pinMode(LCD_RST, OUTPUT);
+      digitalWrite(LCD_RST, HIGH);
+      break;
+    case U8X8_MSG_GPIO_RESET:     digitalWrite(LCD_RST, arg_int); break;
+    case U8X8_MSG_DELAY_MILLI:    delay(arg_int); break;
+    case U8X8_MSG_DELAY_10MICRO:  delayMicroseconds(10U * arg_int); break;
+    case U8X8_MSG_DELAY_100NANO:  delayMicroseconds(1); break;
+    case U8X8_MSG_GPIO_CS:        break;   // CS lo maneja el periférico
+    case U8X8_MSG_GPIO_DC:        break;   // DC va en pre_cb
+    default: return 0;
+  }
+  return 1;
+}
+
+U8G2_ST7567_JLX12864_F_SPI_DMA::U8G2_ST7567_JLX12864_F_SPI_DMA(const u8g2_cb_t* rotation) : U8G2() {
+  // Equivale a u8g2_Setup_st7567_jlx12864_f() con buffer propio (DMA)
+  u8g2_SetupDisplay(&u8g2, u8x8_d_st7567_jlx12864, u8x8_cad_001, lcdDmaByteCb, lcdDmaGpioCb);
+  u8g2_SetupBuffer(&u8g2, s_fb[0], 8, u8g2_ll_hvline_vertical_top_lsb, rotation);
+}
+
+// ------------------------------
+// API de la tarea de render
+// ------------------------------
+uint8_t* lcdDmaFrameBuffer(uint8_t idx) { return s_fb[idx & 1]; }
+
+void lcdDmaLock()   { xSemaphoreTake(s_mutex, portMAX_DELAY); }
+void lcdDmaUnlock() { xSemaphoreGive(s_mutex); }
+
+void lcdDmaSendArea(const uint8_t* buf, uint8_t tx, uint8_t ty, uint8_t tw) {
+  // Mismo direccionamiento que u8x8_d_st7567 (DRAW_TILE)
+  const uint8_t x = (uint8_t)(tx * 8 + (s_u8x8 ? s_u8x8->x_offset : 0));
+  spi_transaction_t cmd = {};
+  cmd.flags      = SPI_TRANS_USE_TXDATA;
+  cmd.length     = 3 * 8;
+  cmd.tx_data[0] = 0x10 | (x >> 4);
+  cmd.tx_data[1] = 0x00 | (x & 0x0F);
+  cmd.tx_data[2] = 0xB0 | ty;
+  cmd.user       = (void*)0;
+
+  spi_transaction_t dat = {};
+  dat.length     = (size_t)tw * 8 * 8;
+  dat.tx_buffer  = buf + (uint16_t)ty * 128 + (uint16_t)tx * 8;
+  dat.user       = (void*)1;
+
+  spi_transaction_t* done;
+  spi_device_queue_trans(s_dev, &cmd, portMAX_DELAY);
+  spi_device_queue_trans(s_dev, &dat, portMAX_DELAY);
+  spi_device_get_trans_result(s_dev, &done, portMAX_DELAY);
+  spi_device_get_trans_result(s_dev, &done, portMAX_DELAY);
+}
+
+#endif // LCD_USE_HW_SPI_DMA
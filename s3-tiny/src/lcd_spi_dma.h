@@ -0,0 +1,53 @@
+#ifndef LCD_SPI_DMA_H
+#define LCD_SPI_DMA_H
+
+// =====================================================
+// ST7567 por SPI hardware (SPI2) con DMA
+// -----------------------------------------------------
+// - U8G2_ST7567_JLX12864_F_SPI_DMA: mismo controlador y
+//   buffer que el modelo _F_4W_SW_SPI, pero los comandos de
+//   u8g2 (init, contraste, power-save, sendBuffer) salen por
+//   el periférico SPI en lugar de bit-banging.
+// - Dos framebuffers de 1 KB en RAM interna (DMA): u8g2
+//   dibuja en uno mientras lcd_flush vuelca el otro desde su
+//   tarea de render con lcdDmaSendArea().
+// - lcdDmaLock()/Unlock(): el bus es uno solo; la tarea lo
+//   toma durante el frame y u8g2 durante cada transferencia.
+//
+// Con LCD_USE_HW_SPI_DMA=0 se vuelve al SPI software.
+// =====================================================
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+#ifndef LCD_USE_HW_SPI_DMA
+  #define LCD_USE_HW_SPI_DMA 1
+#endif
+
+#if LCD_USE_HW_SPI_DMA
+
+// SCLK del ST7567 (máx. ~20 MHz según hoja de datos). El divisor
+// se calcula sobre APB: con CPU a 40 MHz el reloj real cae a la mitad.
+#ifndef LCD_SPI_HZ
+  #define LCD_SPI_HZ 8000000
+#endif
+
+class U8G2_ST7567_JLX12864_F_SPI_DMA : public U8G2 {
+public:
+  explicit U8G2_ST7567_JLX12864_F_SPI_DMA(const u8g2_cb_t* rotation);
+};
+
+static constexpr uint16_t LCD_FB_LEN = 1024;   // 128x64 / 8
+
+uint8_t* lcdDmaFrameBuffer(uint8_t idx);        // idx 0 = buffer inicial de u8g2
+
+// Envía tw tiles de la página ty desde buf (layout de u8g2).
+// Bloquea sólo a quien llama (la tarea de render) hasta fin de DMA.
+void lcdDmaSendArea(const uint8_t* buf, uint8_t tx, uint8_t ty, uint8_t tw);
+
+void lcdDmaLock();
+void lcdDmaUnlock();
+
+#endif // LCD_USE_HW_SPI_DMA
+
+#endif // LCD_SPI_DMA_H
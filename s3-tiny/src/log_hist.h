@@ -0,0 +1,59 @@
+#ifndef LOG_HIST_H
+#define LOG_HIST_H
+
+// =====================================================
+// Histograma log2 de memoria fija (microsegundos)
+//   bucket 0      : 0 us
+//   bucket k >= 1 : [2^(k-1), 2^k) us
+//   último bucket : todo lo que pase de ~1 s
+// Sin heap; add() es O(1) (un clz).
+// =====================================================
+
+#include <Arduino.h>
+#include <string.h>
+
+struct LogHist {
+  static constexpr uint8_t BUCKETS = 22;
+
+  uint32_t n;
+  uint32_t minv;
+  uint32_t maxv;
+  uint64_t sum;
+  uint32_t b[BUCKETS];
+
+  void reset() {
+    memset(this, 0, sizeof(*this));
+    minv = UINT32_MAX;
+  }
+
+  void add(uint32_t us) {
+    uint8_t k = (us == 0) ? 0 : (uint8_t)(32 - __builtin_clz(us));
+    if (k >= BUCKETS) k = BUCKETS - 1;
+    b[k]++;
+    n++;
+    sum += us;
+    if (us < minv) minv = us;
+    if (us > maxv) maxv = us;
+  }
+
+  uint32_t avg() const { return n ? (uint32_t)(sum / n) : 0; }
+
+  // Una línea de resumen + buckets no vacíos ("<2^k us:cuenta")
+  void print(const char* tag, const char* name) const {
+    if (n == 0) {
+      Serial.printf("%s %-10s n=0\n", tag, name);
+      return;
+    }
+    Serial.printf("%s %-10s n=%lu min=%luus avg=%luus max=%luus |",
+                  tag, name, (unsigned long)n, (unsigned long)minv,
+                  (unsigned long)avg(), (unsigned long)maxv);
+    for (uint8_t k = 0; k < BUCKETS; ++k) {
+      if (!b[k]) continue;
+      if (k == BUCKETS - 1) Serial.printf(" >=%lu:%lu", 1UL << (k - 1), (unsigned long)b[k]);
+      else                  Serial.printf(" <%lu:%lu", 1UL << k, (unsigned long)b[k]);
+    }
+    Serial.println();
+  }
+};
+
+#endif // LOG_HIST_H
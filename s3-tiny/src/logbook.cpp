@@ -559,8 +559,40 @@ static bool posixZeroRange(uint32_t off, uint32_t len) {
   return true;
 }
 
+bool logbookGetHead(LogbookHead &out) {
+  if (!g_hdr_loaded) return false;
+  out.capacity = g_hdr.capacity;
+  out.head     = g_hdr.head;
+  out.count    = g_hdr.count;
+  out.nextId   = g_hdr.nextId;
+  out.gen      = g_hdr.gen;
+  return true;
+}
+
+void logbookInitWarm(const LogbookHead &h) {
+  if (h.capacity != LOGBOOK_CAPACITY || h.head >= h.capacity || h.count > h.capacity) {
+    logbookInit();
+    return;
+  }
+  memset(&g_hdr, 0, sizeof(g_hdr));
+  g_hdr.magic    = LB_MAGIC;
+  g_hdr.version  = LB_HDR_VER;
+  g_hdr.rec_size = sizeof(JumpLog);
+  g_hdr.capacity = h.capacity;
+  g_hdr.head     = h.head;
+  g_hdr.count    = h.count;
+  g_hdr.nextId   = h.nextId;
+  g_hdr.gen      = h.gen;
+  g_hdr.crc      = hdr_crc(g_hdr);
+  g_hdr_loaded   = true;
+  DBG("[logbook] Header (RTC): head=%u count=%u nextId=%u gen=%u\n",
+      (unsigned)g_hdr.head, (unsigned)g_hdr.count,
+      (unsigned)g_hdr.nextId, (unsigned)g_hdr.gen);
+}
+
 bool logbookResetAll() {
   if (!g_hdr_loaded) return false;
+  if (!ensureFileOpenRW()) return false;   // arranque en caliente: FS aún sin montar
   clearActiveState();
   formatFreshFile(g_hdr.capacity);  // trunca y escribe headers A/B frescos
   DBG("[logbook] reset ok (fresh format; cap=%u)\n", (unsigned)g_hdr.capacity);
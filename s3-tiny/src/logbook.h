@@ -32,6 +32,19 @@ bool     logbookGetTotal(uint32_t &total);   // total histórico (nextId-1)
 bool     logbookGetByIndex(uint16_t idxNewestFirst, JumpLog &out); // idx=0 => último
 bool     logbookResetAll();
 
+// ===== Cabecera en RAM (snapshot de deep sleep) =====
+struct LogbookHead {
+  uint32_t capacity;
+  uint32_t head;
+  uint32_t count;
+  uint32_t nextId;
+  uint32_t gen;
+};
+bool     logbookGetHead(LogbookHead &out);
+// Arranque en caliente: toma la cabecera sin leer LittleFS
+// (se monta al primer acceso). Capacidad distinta => logbookInit().
+void     logbookInitWarm(const LogbookHead &h);
+
 // ===== Fuente de tiempo (opcional, ya la usabas) =====
 typedef uint32_t (*LogbookTimeFn)();
 void     logbookSetTimeSource(LogbookTimeFn fn);
@@ -4,6 +4,9 @@
 #include "logbook.h"
 #include "logbookUi.h"
 #include "datetime_module.h"   // para formatear ts_local
+#include "lcd_flush.h"
+#include "ui_strings.h"
+#include "ui_layer_cache.h"
 
 //Aceleracion para logbook (variables globales originales, se mantienen aunque no se usen aquí)
 static uint16_t s_step = 1;           // tamaño de paso actual
@@ -38,11 +41,6 @@ extern bool   unidadMetros;          // config.cpp
 extern int    idioma;                // LANG_ES / LANG_EN (config.cpp)
 extern long   lastMenuInteraction;   // ui_module.cpp
 
-// Helper simple de idioma
-static inline const char* T(const char* es, const char* en) {
-  return (idioma == LANG_ES) ? es : en;
-}
-
 static inline uint8_t decAlt() { return unidadMetros ? 1 : 0; }
 // Activo-alto: pulsado = HIGH (pulldown)
 static inline bool btnHigh(int pin) { return digitalRead(pin) == HIGH; }
@@ -50,14 +48,24 @@ static inline bool btnHigh(int pin) { return digitalRead(pin) == HIGH; }
 // ------- Dibujo de una entrada -------
 static void drawEntry(U8G2 &u8g2, const JumpLog& jl, int idx, int total) {
   (void)total;
-  u8g2.clearBuffer();
 
-  // Marco
-  u8g2.drawHLine(0, 0, 128);
-  u8g2.drawHLine(0, 13, 128);
-  u8g2.drawHLine(0, 63, 128);
-  u8g2.drawVLine(0, 0, 64);
-  u8g2.drawVLine(127, 0, 64);
+  // Capa estática (marco + etiquetas) en ui_layer_cache; aquí sólo valores
+  const uint32_t key = UI_LAYER_KEY(UI_LAYER_LOGBOOK, idioma, 0);
+  if (!uiLayerBegin(u8g2, key)) {
+    u8g2.drawHLine(0, 0, 128);
+    u8g2.drawHLine(0, 13, 128);
+    u8g2.drawHLine(0, 63, 128);
+    u8g2.drawVLine(0, 0, 64);
+    u8g2.drawVLine(127, 0, 64);
+
+    u8g2.setFont(u8g2_font_5x8_mf);
+    u8g2.setCursor(2, 22); u8g2.print(tr(STR_LB_EXIT));
+    u8g2.setCursor(2, 32); u8g2.print(tr(STR_LB_OPEN));
+    u8g2.setCursor(2, 42); u8g2.print("FF:");
+    u8g2.setCursor(2, 52); u8g2.print("V:");
+    u8g2.setCursor(2, 62); u8g2.print("Vc:");
+    uiLayerSave(u8g2, key);
+  }
 
   // ===========================
   // Encabezado: "Jump: x HH:MM DD/MM/YY"
@@ -76,32 +84,27 @@ static void drawEntry(U8G2 &u8g2, const JumpLog& jl, int idx, int total) {
   u8g2.print(hdr);
 
   // Campos (alturas y tiempos)
-  String sExit   = logbookFormatAltCm(jl.exit_alt_cm,   unidadMetros, decAlt());
-  String sDeploy = logbookFormatAltCm(jl.deploy_alt_cm, unidadMetros, decAlt());
-  String sFF     = logbookFormatFF(jl.freefall_time_ds);
+  char sExit[16], sDeploy[16], sFF[12];
+  logbookFormatAltCm(sExit,   sizeof(sExit),   jl.exit_alt_cm,   unidadMetros, decAlt());
+  logbookFormatAltCm(sDeploy, sizeof(sDeploy), jl.deploy_alt_cm, unidadMetros, decAlt());
+  logbookFormatFF(sFF, sizeof(sFF), jl.freefall_time_ds);
 
   // >>> Velocidades en km/h
-  String sVff  = logbookFormatVelKmh(jl.vmax_ff_cmps,  1);
-  String sVcan = logbookFormatVelKmh(jl.vmax_can_cmps, 1);
+  char sVff[16], sVcan[16];
+  logbookFormatVelKmh(sVff,  sizeof(sVff),  jl.vmax_ff_cmps,  1);
+  logbookFormatVelKmh(sVcan, sizeof(sVcan), jl.vmax_can_cmps, 1);
 
   // Exit / Open
-  u8g2.setCursor(2, 22);  u8g2.print(T("Exit:", "Exit:"));
   u8g2.setCursor(30, 22); u8g2.print(sExit);
-
-  u8g2.setCursor(2, 32);  u8g2.print(T("Open:", "Open:"));
   u8g2.setCursor(30, 32); u8g2.print(sDeploy);
 
   // Freefall (tiempo) y V (freefall en km/h)
-  u8g2.setCursor(2, 42);  u8g2.print("FF:");
   u8g2.setCursor(30, 42); u8g2.print(sFF);
-
-  u8g2.setCursor(2, 52);  u8g2.print("V:");
   u8g2.setCursor(30, 52); u8g2.print(sVff);
 
   // ===========================
   // Fila inferior: "Vc:" y el id del salto
   // ===========================
-  u8g2.setCursor(2, 62);   u8g2.print("Vc:");
   u8g2.setCursor(30, 62);  u8g2.print(sVcan);
 
   // Footer: solo número de salto <jump_id>
@@ -114,26 +117,26 @@ static void drawEntry(U8G2 &u8g2, const JumpLog& jl, int idx, int total) {
   u8g2.setCursor(idX, 62);
   u8g2.print(idbuf);
 
-  u8g2.sendBuffer();
+  lcdFlush();
 }
 
 static void drawEmpty(U8G2 &u8g2) {
   u8g2.clearBuffer();
   u8g2.setFont(u8g2_font_ncenB08_tr);
-  u8g2.setCursor(10, 28); u8g2.print(T("Sin registros", "No entries"));
-  u8g2.setCursor(10, 46); u8g2.print(T("MENU para salir", "MENU to exit"));
-  u8g2.sendBuffer();
+  u8g2.setCursor(10, 28); u8g2.print(tr(STR_LB_NO_ENTRIES));
+  u8g2.setCursor(10, 46); u8g2.print(tr(STR_LB_MENU_EXIT));
+  lcdFlush();
 }
 
 static void drawErasePrompt(U8G2 &u8g2, bool confirmStage) {
   (void)confirmStage;
   u8g2.clearBuffer();
   u8g2.setFont(u8g2_font_profont12_mf);
-  u8g2.setCursor(0, 16); u8g2.print(T("Borrar Bitacora", "Erase Logbook"));
-  u8g2.setCursor(0, 32); u8g2.print(T("Mantener ALT+OLED", "Hold ALT+OLED"));
-  u8g2.setCursor(0, 44); u8g2.print(T("2s para CONFIRMAR", "2s to CONFIRM"));
-  u8g2.setCursor(0, 60); u8g2.print(T("MENU para cancelar", "MENU to cancel"));
-  u8g2.sendBuffer();
+  u8g2.setCursor(0, 16); u8g2.print(tr(STR_LB_ERASE));
+  u8g2.setCursor(0, 32); u8g2.print(tr(STR_LB_HOLD));
+  u8g2.setCursor(0, 44); u8g2.print(tr(STR_LB_CONFIRM));
+  u8g2.setCursor(0, 60); u8g2.print(tr(STR_LB_CANCEL));
+  lcdFlush();
 }
 
 // Reemplazo NO bloqueante del antiguo delay(900)
@@ -205,7 +208,7 @@ void logbookUiDrawAndHandle(U8G2 &u8g2) {
     int x = (128 - w) / 2; if (x < 0) x = 0;
     u8g2.setCursor(x, 36);
     u8g2.print(s_toastMsg);
-    u8g2.sendBuffer();
+    lcdFlush();
 
     if ((int32_t)(millis() - s_toastUntilMs) >= 0) {
       s_toastActive = false;
@@ -225,6 +228,7 @@ void logbookUiDrawAndHandle(U8G2 &u8g2) {
   const bool altRise  = altRiseRaw  && (now - lastAltEdgeMs  > EDGE_DEBOUNCE_MS);
   const bool oledRise = oledRiseRaw && (now - lastOledEdgeMs > EDGE_DEBOUNCE_MS);
   const bool menuRise = menuRiseRaw && (now - lastMenuEdgeMs > EDGE_DEBOUNCE_MS);
+  if (altRise || oledRise || menuRise) lcdFlushMarkInput();
   if (altRise)  lastAltEdgeMs  = now;
   if (oledRise) lastOledEdgeMs = now;
   if (menuRise) lastMenuEdgeMs = now;
@@ -354,7 +358,7 @@ void logbookUiDrawAndHandle(U8G2 &u8g2) {
         confirmStartMs  = 0;
         logbookGetCount(s_count);
         s_idx = 0;
-        drawToast(u8g2, T("Bitacora borrada", "Logbook erased")); // no bloquea
+        drawToast(u8g2, tr(STR_LB_ERASED)); // no bloquea
       }
     } else {
       confirmStartMs = 0;
@@ -0,0 +1,127 @@
+#include "loop_watchdog.h"
+#include "sensor_module.h"
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include <string.h>
+
+// ------------------------------
+// Ring post-mortem en RTC (no se inicializa en reset)
+// ------------------------------
+static constexpr uint32_t LWD_MAGIC = 0x4C574431; // "LWD1"
+
+struct LwdEvent {
+  uint32_t t_ms;        // millis() al terminar la sección
+  uint32_t dur_us;
+  uint32_t budget_us;
+  uint8_t  mode;        // SensorMode
+  char     name[11];
+};
+
+struct LwdRing {
+  uint32_t magic;
+  uint16_t head;        // próximo slot a escribir
+  uint16_t count;       // eventos válidos (<= LWD_RING_SIZE)
+  uint32_t total;       // eventos totales (incluye sobrescritos)
+  uint32_t boots;       // arranques desde el último borrado
+  LwdEvent ev[LWD_RING_SIZE];
+};
+
+RTC_NOINIT_ATTR static LwdRing s_ring;
+
+static int64_t s_loopT0     = 0;
+static int64_t s_loopEx0    = 0;
+static int64_t s_pauseT0    = 0;
+static int64_t s_excused    = 0;     // acumulado: light-sleep + esperas previstas
+
+static void ringClear() {
+  memset(&s_ring, 0, sizeof(s_ring));
+  s_ring.magic = LWD_MAGIC;
+}
+
+void lwdInit() {
+  if (s_ring.magic != LWD_MAGIC || s_ring.count > LWD_RING_SIZE ||
+      s_ring.head >= LWD_RING_SIZE) {
+    ringClear();                     // power-on: RAM RTC con basura
+  }
+  s_ring.boots++;
+  if (s_ring.count) {
+    Serial.printf("[LWD] post-mortem: %u eventos (total=%lu) -> 'w' para ver\n",
+                  (unsigned)s_ring.count, (unsigned long)s_ring.total);
+  }
+}
+
+uint32_t lwdBudgetUs() {
+  switch (getSensorMode()) {
+    case SENSOR_MODE_FREEFALL:      return LWD_BUDGET_FREEFALL_US;
+    case SENSOR_MODE_ULTRA_PRECISO: return LWD_BUDGET_ULTRA_US;
+    case SENSOR_MODE_AHORRO:
+    default:                        return LWD_BUDGET_AHORRO_US;
+  }
+}
+
+void lwdReport(const char* name, uint32_t durUs) {
+  const uint32_t budget = lwdBudgetUs();
+  if (durUs <= budget) return;
+
+  LwdEvent &e = s_ring.ev[s_ring.head];
+  e.t_ms      = millis();
+  e.dur_us    = durUs;
+  e.budget_us = budget;
+  e.mode      = (uint8_t)getSensorMode();
+  strncpy(e.name, name ? name : "?", sizeof(e.name) - 1);
+  e.name[sizeof(e.name) - 1] = '\0';
+
+  s_ring.head = (uint16_t)((s_ring.head + 1) % LWD_RING_SIZE);
+  if (s_ring.count < LWD_RING_SIZE) s_ring.count++;
+  s_ring.total++;
+}
+
+// ------------------------------
+// Secciones nombradas
+// ------------------------------
+LwdSection::LwdSection(const char* name)
+  : name_(name), t0_(esp_timer_get_time()), ex0_(s_excused) {}
+
+LwdSection::~LwdSection() {
+  const int64_t busy = (esp_timer_get_time() - t0_) - (s_excused - ex0_);
+  if (busy > 0) lwdReport(name_, (uint32_t)busy);
+}
+
+// ------------------------------
+// Iteración de loop()
+// ------------------------------
+void lwdLoopBegin() {
+  s_loopT0  = esp_timer_get_time();
+  s_loopEx0 = s_excused;
+}
+
+void lwdLoopPause()  { s_pauseT0 = esp_timer_get_time(); }
+void lwdLoopResume() { s_excused += esp_timer_get_time() - s_pauseT0; }
+void lwdExcuse(uint32_t us) { s_excused += us; }
+
+void lwdLoopEnd() {
+  const int64_t busy = (esp_timer_get_time() - s_loopT0) - (s_excused - s_loopEx0);
+  if (busy > 0) lwdReport("loop", (uint32_t)busy);
+}
+
+// ------------------------------
+// Volcado
+// ------------------------------
+void lwdDump() {
+  static const char* const kModes[3] = { "ahorro", "ultra", "ff" };
+  Serial.printf("[LWD] eventos=%u total=%lu boots=%lu\n", (unsigned)s_ring.count,
+                (unsigned long)s_ring.total, (unsigned long)s_ring.boots);
+  // Del más antiguo al más reciente
+  const uint16_t first = (uint16_t)((s_ring.head + LWD_RING_SIZE - s_ring.count) % LWD_RING_SIZE);
+  for (uint16_t i = 0; i < s_ring.count; ++i) {
+    const LwdEvent &e = s_ring.ev[(first + i) % LWD_RING_SIZE];
+    Serial.printf("[LWD] t=%lums %-10s %luus > %luus (%s)\n",
+                  (unsigned long)e.t_ms, e.name, (unsigned long)e.dur_us,
+                  (unsigned long)e.budget_us, kModes[e.mode <= 2 ? e.mode : 0]);
+  }
+}
+
+void lwdClear() {
+  ringClear();
+  Serial.println("[LWD] ring borrado");
+}
@@ -0,0 +1,58 @@
+#ifndef LOOP_WATCHDOG_H
+#define LOOP_WATCHDOG_H
+
+// =====================================================
+// Watchdog de latencia del loop (siempre activo, barato)
+// -----------------------------------------------------
+// - Sella cada iteración de loop() y cada sección crítica
+//   nombrada (LWD_SECTION("nombre")).
+// - Si una sección o la iteración supera el presupuesto del
+//   modo actual (p.ej. 5 ms en FREEFALL) se guarda en un ring
+//   post-mortem en RTC (sobrevive a resets por pánico/WDT).
+// - Las esperas previstas (conversión FORCED del BMP390)
+//   se descuentan con lwdExcuse(): sólo cuenta el exceso.
+// - No imprime en el momento (imprimir también bloquea):
+//   'w' vuelca el ring, 'W' lo borra.
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef LWD_BUDGET_AHORRO_US
+  #define LWD_BUDGET_AHORRO_US    50000UL   // 50 ms en tierra
+#endif
+#ifndef LWD_BUDGET_ULTRA_US
+  #define LWD_BUDGET_ULTRA_US     20000UL   // 20 ms en avión/campana
+#endif
+#ifndef LWD_BUDGET_FREEFALL_US
+  #define LWD_BUDGET_FREEFALL_US   5000UL   // 5 ms en caída libre
+#endif
+#ifndef LWD_RING_SIZE
+  #define LWD_RING_SIZE 16
+#endif
+
+void     lwdInit();                    // en setup(): informa si hay post-mortem
+void     lwdLoopBegin();
+void     lwdLoopPause();               // light-sleep no cuenta
+void     lwdLoopResume();
+void     lwdLoopEnd();
+void     lwdExcuse(uint32_t us);       // espera prevista: fuera de sección e iteración
+uint32_t lwdBudgetUs();                // presupuesto del modo actual
+void     lwdReport(const char* name, uint32_t durUs);
+void     lwdDump();
+void     lwdClear();
+
+class LwdSection {
+public:
+  explicit LwdSection(const char* name);
+  ~LwdSection();
+private:
+  const char* name_;
+  int64_t     t0_;
+  int64_t     ex0_;
+};
+
+#define LWD_CAT_(a, b) a##b
+#define LWD_CAT(a, b)  LWD_CAT_(a, b)
+#define LWD_SECTION(name) LwdSection LWD_CAT(_lwd_, __LINE__)(name)
+
+#endif // LOOP_WATCHDOG_H
@@ -2,8 +2,6 @@
 #include <Wire.h>
 #include <U8g2lib.h>
 #include <esp_sleep.h>        // deep sleep (GPIO wakeup)
-#include "driver/gpio.h"
-#include "driver/rtc_io.h"
 
 #include "config.h"
 #include "sensor_module.h"
@@ -14,6 +12,21 @@
 #include "logbook.h"
 #include "charge_detect.h"
 #include "alarm.h"
+#include "profiler.h"
+#include "serial_cmd.h"
+#include "sample_stats.h"
+#include "loop_watchdog.h"
+#include "hil_link.h"
+#include "lcd_flush.h"
+#include "alt_history.h"
+#include "power_governor.h"
+#include "loop_sched.h"
+#include "ulp_climb.h"
+#include "wake_stub.h"
+#include "warm_boot.h"
+#include "ds_housekeeping.h"
+#include "adc_dma.h"
+#include "climb_eco.h"
 
 // ==========================
 // Externs provistos por otros módulos
@@ -52,6 +65,7 @@ extern unsigned long ahorroTimeoutMs;
 #endif
 
 #if DEBUG_HZ
+// Sólo updateSensorData() llama a onSampleAccepted(): una vez por muestra aceptada
 volatile uint32_t g_samples = 0;     // incrementa al aceptar una lectura válida
 unsigned long g_t_last = 0;          // millis() del último reporte
 void onSampleAccepted() { g_samples++; }
@@ -59,21 +73,14 @@ void onSampleAccepted() { g_samples++; }
 static void hzReportTick(int modo /* 0: Ahorro, 1: Ultra, 2: Freefall */) {
   unsigned long now = millis();
   if (now - g_t_last >= 1000UL) {
-    Serial.printf("[HZ] modo=%d  Hz=%lu\n", modo, (unsigned long)g_samples);
+    LWD_SECTION("hz_print");
+    sampleStatsReportTick((uint8_t)modo, g_samples);   // [HZ] + objetivo/jitter/pérdidas
     g_samples = 0;
     g_t_last = now;
   }
 }
 #endif
 
-// === Deep Sleep por aterrizaje (fijo 5 min) ===
-#ifndef LANDING_DS_ENABLE
-#define LANDING_DS_ENABLE   1
-#endif
-#ifndef LANDING_DS_DELAY_MS
-#define LANDING_DS_DELAY_MS 300000UL   // 5 minutos
-#endif
-
 // ==========================
 // Estado general
 // ==========================
@@ -81,90 +88,11 @@ bool pantallaEncendida = true;   // compat
 bool calibracionRealizada = false;
 
 static unsigned long lastActivityMs = 0;
-static inline void noteUserActivity() { lastActivityMs = millis(); }
+void noteUserActivity() { lastActivityMs = millis(); }   // también el gobernador
 unsigned long getLastActivityMs() {  // expone a la UI
   return lastActivityMs;
 }
 
-// Temporizador fijo post-aterrizaje
-static SensorMode    s_prevMode      = SENSOR_MODE_AHORRO;
-static bool          s_landingArmed  = false;
-static unsigned long s_landingT0     = 0;
-
-// ==========================
-// Wake por GPIO (nivel alto)
-// ==========================
-// Botón: ACTIVO-ALTO (pulldown). VBUS: HIGH con divisor 330k/510k (o similar).
-static inline void setupWakeSourceGPIO() {
-  // Config digital (no rige en deep-sleep, pero útil en runtime)
-  pinMode(WAKE_BTN_PIN, INPUT_PULLDOWN);
-
-  pinMode(CHARGE_ADC_PIN, INPUT);
-  gpio_pullup_dis((gpio_num_t)CHARGE_ADC_PIN);
-  gpio_pulldown_dis((gpio_num_t)CHARGE_ADC_PIN);
-
-  // Fuentes de wake (EXT1: cualquiera en HIGH)
-  const uint64_t mask = (1ULL << WAKE_BTN_PIN) | (1ULL << CHARGE_ADC_PIN);
-  ESP_ERROR_CHECK(esp_sleep_enable_ext1_wakeup(mask, ESP_EXT1_WAKEUP_ANY_HIGH));
-}
-
-// Wake GPIO para light-sleep (nivel alto en botones/VBUS)
-static inline void setupGpioWakeForLightSleep() {
-  // Botones (activos en HIGH)
-  gpio_wakeup_enable((gpio_num_t)BUTTON_MENU,     GPIO_INTR_HIGH_LEVEL);
-  gpio_wakeup_enable((gpio_num_t)BUTTON_ALTITUDE, GPIO_INTR_HIGH_LEVEL);
-  gpio_wakeup_enable((gpio_num_t)BUTTON_OLED,     GPIO_INTR_HIGH_LEVEL);
-  // VBUS por divisor (CHARGE_ADC_PIN sube cuando hay USB)
-  gpio_wakeup_enable((gpio_num_t)CHARGE_ADC_PIN,  GPIO_INTR_HIGH_LEVEL);
-
-  // Habilita fuente de wake por GPIO en light sleep
-  ESP_ERROR_CHECK(esp_sleep_enable_gpio_wakeup());
-}
-
-// Duerme entre lecturas FORCED en suelo/ahorro para ahorrar batería
-static void lightSleepBetweenSensorReads() {
-  // No dormir si estamos en UI interactiva o juegos, o con sleep-lock
-  if (menuActivo) return;
-  if (gameSnakeRunning) return;
-  if (powerLockActive()) return;
-  if (getSensorMode() != SENSOR_MODE_AHORRO) return;
-
-  uint32_t rem_ms = sensor_ms_until_next_forced_read();
-  // Umbral: evita dormir para descansos muy cortos
-  if (rem_ms < 25) return;
-
-  // Margen para despertar un poco antes de la lectura
-  const uint32_t SAFETY_MS = 8;
-  uint64_t sleep_us = (uint64_t)((rem_ms > SAFETY_MS) ? (rem_ms - SAFETY_MS) : 0) * 1000ULL;
-  if (sleep_us < 1000) return;
-
-  // Programa fuentes de wake para este ciclo de light sleep
-  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
-  setupGpioWakeForLightSleep();
-  ESP_ERROR_CHECK(esp_sleep_enable_timer_wakeup(sleep_us));
-
-  Serial.flush();                // evita que el UART despierte/consuma
-  esp_light_sleep_start();       // vuelve aquí al despertar (timer o GPIO)
-}
-
-
-// ==========================
-// Pull-downs RTC para deep-sleep
-// ==========================
-static void armRtcPullsForDeepSleep() {
-  // WAKE_BTN_PIN: mantener LOW en deep-sleep (evita falsos HIGH por flotación)
-  rtc_gpio_init((gpio_num_t)WAKE_BTN_PIN);
-  rtc_gpio_set_direction((gpio_num_t)WAKE_BTN_PIN, RTC_GPIO_MODE_INPUT_ONLY);
-  rtc_gpio_pullup_dis((gpio_num_t)WAKE_BTN_PIN);
-  rtc_gpio_pulldown_en((gpio_num_t)WAKE_BTN_PIN);
-
-  // CHARGE_ADC_PIN (VBUS divisor): mantener LOW si no hay USB
-  rtc_gpio_init((gpio_num_t)CHARGE_ADC_PIN);
-  rtc_gpio_set_direction((gpio_num_t)CHARGE_ADC_PIN, RTC_GPIO_MODE_INPUT_ONLY);
-  rtc_gpio_pullup_dis((gpio_num_t)CHARGE_ADC_PIN);
-  rtc_gpio_pulldown_en((gpio_num_t)CHARGE_ADC_PIN);
-}
-
 // ==========================
 // Debug: causa de wake
 // ==========================
@@ -175,6 +103,7 @@ static void printWakeDebug() {
     uint64_t pins = esp_sleep_get_ext1_wakeup_status();
     Serial.printf("[WAKE] ext1 mask=0x%llX (pin(es) HIGH)\n", pins);
   }
+  if (cause != ESP_SLEEP_WAKEUP_UNDEFINED) wakeStubDump();   // despertares filtrados por el stub
 }
 
 // ======================================================================
@@ -186,150 +115,64 @@ static uint32_t timeProviderThunk() {
 }
 
 // ======================================================================
-// *** BLINDAJE DE VUELO ***
+// Estrangulador de lecturas del BMP sin tocar sensor_module
 // ======================================================================
-static inline bool inFlightNow() {
-  SensorMode sm = getSensorMode();     // AHORRO / ULTRA / FREEFALL
-  if (sm != SENSOR_MODE_AHORRO) return true; // modo de vuelo activo
-  if (enSalto || inJump)        return true; // flags UI/estado de salto
-  return false;
-}
-
-static bool     s_flightGraceArmed = false;
-static uint32_t s_flightGraceT0    = 0;
-static const uint32_t FLIGHT_GRACE_MS = 120000UL; // 120 s de gracia global
+#ifndef SENSOR_TICK_AHORRO_MS
+#define SENSOR_TICK_AHORRO_MS       150  // tick en tierra (la FORCED real va cada FORCED_AHORRO_MS)
+#endif
+#ifndef SENSOR_TICK_ULTRA_MS
+#define SENSOR_TICK_ULTRA_MS         50  // objetivo 20 Hz
+#endif
+#ifndef SENSOR_TICK_FREEFALL_MS
+#define SENSOR_TICK_FREEFALL_MS      10  // objetivo 100 Hz (limitado por la conversión)
+#endif
 
-static inline void updateFlightGraceWindow() {
-  static bool prevInFlight_ctx = false;
-  bool nowInFlight = inFlightNow();
-  if (nowInFlight) {
-    prevInFlight_ctx   = true;
-    s_flightGraceArmed = false;
-  } else {
-    if (prevInFlight_ctx) {
-      s_flightGraceArmed = true;
-      s_flightGraceT0    = millis();
-      prevInFlight_ctx   = false;
-    }
-  }
-}
+static uint32_t s_sensorLastTick = 0;
 
-static inline bool inFlightGraceNow() {
-  return s_flightGraceArmed && (millis() - s_flightGraceT0 < FLIGHT_GRACE_MS);
+static uint16_t sensorTickInterval(SensorMode m) {
+  if (m == SENSOR_MODE_ULTRA_PRECISO) return SENSOR_TICK_ULTRA_MS;
+  if (m == SENSOR_MODE_FREEFALL)      return SENSOR_TICK_FREEFALL_MS;
+  return SENSOR_TICK_AHORRO_MS;
 }
 
-// ==========================
-// Entrar a deep sleep
-// ==========================
-static void enterDeepSleepNow(const char* reason = "inactividad") {
-  if (inFlightNow() || inFlightGraceNow()) {
-    Serial.printf("Deep sleep BLOQUEADO por vuelo/gracia (%s).\n", reason);
-    return;
-  }
-
-  // Evitar dormir si el botón está presionado (si duermes con HIGH, EXT1 despierta al toque)
-  if (digitalRead(WAKE_BTN_PIN) == HIGH) {
-    Serial.println("Deep sleep cancelado: botón en HIGH.");
-    noteUserActivity();
-    return;
-  }
-  // Evitar dormir si hay USB presente
-  if (isUsbPresent()) {
-    Serial.println("Deep sleep cancelado: USB presente.");
-    noteUserActivity();
+// Plazo del próximo tick para loop_sched. En Ahorro, además, no antes
+// de la próxima FORCED (los ticks intermedios no convierten). En la
+// subida económica, al DRDY previsto (o antes, por el INT del BMP).
+static void scheduleSensor() {
+  if (climbEcoActive()) {
+    schedAt(SCHED_SENSOR, millis() + climbEcoMsUntilNext());
     return;
   }
-
-  Serial.printf("Entrando a deep sleep por %s...\n", reason);
-
-  // Cierre de logbook si hubiera salto abierto
-  logbookFinalizeIfOpen();
-
-  // Apagar OLED de forma segura
-  u8g2.setPowerSave(true);
-  u8g2.clearBuffer();
-  u8g2.sendBuffer();
-
-  // Asegurar niveles estables en dominio RTC durante deep-sleep
-  armRtcPullsForDeepSleep();
-
-  // Re-configurar fuentes de wake de forma limpia
-  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
-  const uint64_t mask = (1ULL << WAKE_BTN_PIN) | (1ULL << CHARGE_ADC_PIN);
-  ESP_ERROR_CHECK(esp_sleep_enable_ext1_wakeup(mask, ESP_EXT1_WAKEUP_ANY_HIGH));
-
-  // Hook de fecha/hora
-  datetimeOnBeforeDeepSleep();
-
-  delay(30);
-  Serial.flush();
-  esp_deep_sleep_start();   // ¡a dormir!
-}
-
-// ==========================
-// Evaluar si corresponde dormir
-// ==========================
-static inline void maybeEnterDeepSleep() {
-  if (inFlightNow() || inFlightGraceNow()) return;
-  if (isUsbPresent()) { noteUserActivity(); return; }
-
-#if LANDING_DS_ENABLE
-  if (s_landingArmed) {
-    if (!menuActivo && !gameSnakeRunning && !powerLockActive()) {
-      if (getSensorMode() == SENSOR_MODE_AHORRO) {
-        if (millis() - lastActivityMs >= 10000UL) {
-          if (millis() - s_landingT0 >= LANDING_DS_DELAY_MS) {
-            enterDeepSleepNow("aterrizaje (5min)");
-          }
-        }
-      } else {
-        s_landingArmed = false;
-      }
-    }
+  const SensorMode m = getSensorMode();
+  uint32_t due = s_sensorLastTick + sensorTickInterval(m);
+  if (m == SENSOR_MODE_AHORRO) {
+    const uint32_t forced = millis() + sensor_ms_until_next_forced_read();
+    if ((int32_t)(forced - due) > 0) due = forced;
   }
-#endif
-
-  if (ahorroTimeoutMs == 0) return;            // OFF
-  if (menuActivo) return;                      // no dormir dentro del menú
-  if (gameSnakeRunning) return;                // no dormir durante Snake
-  if (powerLockActive()) return;               // sleep-lock activo
-
-  SensorMode sm = getSensorMode();
-  if (sm != SENSOR_MODE_AHORRO) return;
-
-  unsigned long now = millis();
-  if ((now - lastActivityMs) >= ahorroTimeoutMs) enterDeepSleepNow("inactividad");
+  schedAt(SCHED_SENSOR, due);
 }
 
-// ======================================================================
-// Estrangulador de lecturas del BMP sin tocar sensor_module
-// ======================================================================
-#ifndef SENSOR_TICK_AHORRO_MS
-#define SENSOR_TICK_AHORRO_MS       150  // ~6.7 Hz en tierra (ahorro real de I2C/energía)
-#endif
-#ifndef SENSOR_TICK_ULTRA_MS
-#define SENSOR_TICK_ULTRA_MS         50  // ~10 Hz
-#endif
-#ifndef SENSOR_TICK_FREEFALL_MS
-#define SENSOR_TICK_FREEFALL_MS      10  // ~12.5 Hz
-#endif
-
 static void tickSensor() {
-  static uint32_t lastTick = 0;
   const uint32_t now = millis();
 
-  uint16_t interval = SENSOR_TICK_AHORRO_MS;
   SensorMode m = getSensorMode();
-  if (m == SENSOR_MODE_ULTRA_PRECISO) interval = SENSOR_TICK_ULTRA_MS;
-  else if (m == SENSOR_MODE_FREEFALL) interval = SENSOR_TICK_FREEFALL_MS;
+  const bool eco = climbEcoActive();
+  const uint16_t interval = eco ? (uint16_t)CLIMB_ECO_PERIOD_MS : sensorTickInterval(m);
 
-  if (now - lastTick < interval) return;
-  lastTick = now;
+  // En Ahorro updateSensorData() sólo convierte cada FORCED_AHORRO_MS
+  sampleStatsSetTarget((uint8_t)m, (m == SENSOR_MODE_AHORRO)
+                                     ? max((uint32_t)interval, (uint32_t)FORCED_AHORRO_MS)
+                                     : (uint32_t)interval);
 
-  updateSensorData();
-#if DEBUG_HZ
-  onSampleAccepted();
-#endif
+  // Subida económica: el ritmo lo marca el reloj del BMP, no el tick
+  if (eco ? climbEcoDue() : (now - s_sensorLastTick >= interval)) {
+    s_sensorLastTick = now;
+
+    PROF_SCOPE(PROF_SENSOR);
+    LWD_SECTION("sensor");
+    updateSensorData();   // cuenta la muestra (onSampleAccepted) sólo si hubo lectura
+  }
+  scheduleSensor();       // con el modo que haya dejado la muestra
 }
 
 // ==========================
@@ -340,28 +183,40 @@ bool testFired = false;
 
 void setup() {
   Serial.begin(115200);
-  delay(300);
-  Serial.println("Setup iniciado");
+  const bool warm = warmBootBegin();   // snapshot RTC válido de este deep sleep
+  if (dsHousekeepingWake()) dsHousekeepingRun();   // timer: pasada mínima y a dormir
+  if (!warm) delay(300);
+  Serial.println(warm ? "Setup iniciado (caliente)" : "Setup iniciado");
   printWakeDebug();
+  ulpClimbBoot();         // antes de Wire: SDA/SCL pueden seguir en el RTC
+  lwdInit();
 
   Wire.begin(SDA_PIN, SCL_PIN);
   Wire.setClock(400000);  // 400 kHz
 
-  loadConfig();
-  loadUserConfig();
+  if (warm) {
+    warmBootRestoreConfig();  // sin NVS
+  } else {
+    loadConfig();
+    loadUserConfig();
+  }
 
   // Orden: tiempo -> logbook (init + proveedor) -> Sensor/UI/Batería
   datetimeInit();
-  logbookInit();
+  if (warm) warmBootRestoreLogbook();   // sin LittleFS hasta el primer acceso
+  else      logbookInit();
   logbookSetTimeSource(timeProviderThunk);
 
+  altHistoryBegin();
   initSensor();
   initUI();
   //alarmInit();
   tTest = millis();
 
   batteryInit();          // inicializar batería
+  if (warm) warmBootRestoreBattery();
   chargeDetectBegin();    // inicializar medición de VBUS (ADC)
+  adcDmaBegin();          // a partir de aquí batería/VBUS por ráfagas DMA
 
   // Botones de UI (ACTIVOS-ALTO)
   pinMode(BUTTON_ALTITUDE, INPUT_PULLDOWN);
@@ -370,20 +225,28 @@ void setup() {
 
   uiBlockMenuOpenUntilMs = millis() + 300;
 
-  // Prepara EXT1 (no imprescindible, lo volvemos a armar antes de dormir)
-  setupWakeSourceGPIO();
+  // Arranque en caliente: sin cuenta regresiva y, salvo que el ULP traiga
+  // el suelo o la referencia sea vieja, sin volver a poner a cero
+  if (warm) {
+    float groundPa;
+    startupDone = true;
+    if (!ulpClimbWoke(groundPa) && warmBootRestoreReference()) calibracionRealizada = true;
+  }
 
   // Iniciar temporizador de inactividad
   noteUserActivity();
 
-  // Inicializa referencia de modo para el temporizador de aterrizaje
-  s_prevMode = getSensorMode();
-  s_landingArmed = false;
+  // CPU/I2C/sueño: EXT1, estado inicial y temporizador de aterrizaje
+  powerGovBegin();
+  schedBegin();           // el loop espera plazos en vez de girar
 
   Serial.println("Setup completado");
 }
 
 void loop() {
+  PROF_LOOP_BEGIN();
+  lwdLoopBegin();
+
   // Servicio de alarmas y lock
   //alarmService();
   powerLockUpdate();
@@ -391,48 +254,44 @@ void loop() {
 
   // === Sensores / Batería / Carga / UI ===
   tickSensor();
-  batteryUpdate();
-  chargeDetectUpdate();
+  { PROF_SCOPE(PROF_BATTERY); batteryUpdate(); }
+  { PROF_SCOPE(PROF_CHARGE);  chargeDetectUpdate(); }
+  schedAt(SCHED_BATTERY, batteryNextDueMs());
+  schedAt(SCHED_CHARGE,  chargeDetectNextDueMs());
   static uint32_t lastDbg = 0;
   uint32_t now = millis();
   if (now - lastDbg >= 1000) {
     lastDbg = now;
+    LWD_SECTION("chg_print");   // USB-CDC con back-pressure puede bloquear
     Serial.printf("[CHG] raw=%d vadc=%.2fV vbus=%.2fV present=%d\n",
                   chargeDebugRaw(), chargeDebugVadc(),
                   chargeDebugVbus(), isUsbPresent());
   }
+  schedAt(SCHED_DEBUG, lastDbg + 1000);
 
-  updateUI();
-
-  // === Gracia global por contexto de vuelo ===
-  updateFlightGraceWindow();
-  lightSleepBetweenSensorReads();
-  // ----- Corte por batería baja, pero NUNCA durante el vuelo -----
-  if (!inFlightNow() && !inFlightGraceNow() && batteryShouldDeepSleep()) {
-    enterDeepSleepNow("batería baja");
-    return; // seguridad (deep sleep no retorna)
-  }
+  // === Gobernador: estado de energía (CPU/I2C) antes de pintar ===
+  powerGovTick();
 
-  // --- Armado/cancelación del temporizador de aterrizaje (transiciones de modo) ---
-#if LANDING_DS_ENABLE
-  {
-    SensorMode cur = getSensorMode();
-    if (s_prevMode != SENSOR_MODE_AHORRO && cur == SENSOR_MODE_AHORRO) {
-      s_landingArmed = true;
-      s_landingT0    = millis();
-    }
-    if (s_prevMode == SENSOR_MODE_AHORRO && cur != SENSOR_MODE_AHORRO) {
-      s_landingArmed = false;
-    }
-    s_prevMode = cur;
-  }
-#endif
+  { PROF_SCOPE(PROF_UI); LWD_SECTION("ui"); updateUI(); lcdFlushTick(); }
+  schedAt(SCHED_UI, uiNextDueMs());
 
+  // Light-sleep (tierra) y espera hasta el próximo plazo o un botón
+  PROF_LOOP_PAUSE();              // el tiempo dormido no cuenta como carga
+  lwdLoopPause();
+  powerGovIdle();
+  lwdLoopResume();
+  PROF_LOOP_RESUME();
   // === Calibración automática al inicio (una sola vez) ===
   if (!calibracionRealizada) {
-    if (bmp.performReading()) {
-      altitudReferencia = bmp.readAltitude(1013.25);
+    if (sensorForcedReading()) {
+      altitudReferencia = sensorPressureToAltitude(bmp.pressure);
       Serial.println("Calibración inicial: altitud reiniciada a cero.");
+      float groundPa;
+      if (ulpClimbWoke(groundPa)) {
+        // Despertó el ULP ya subiendo: el cero es el suelo, no aquí
+        altitudReferencia = sensorPressureToAltitude(groundPa);
+        Serial.printf("Calibración: referencia del ULP (suelo) %.0f Pa\n", groundPa);
+      }
       // ====== RESET AGZ INCONDICIONAL AL ARRANCAR ======
       agzBias = 0.0f;
       Serial.println("AGZ: sesgo reseteado (boot).");
@@ -480,21 +339,18 @@ void loop() {
       altDidAction = false;
     }
     if (altNow && !altDidAction && (millis() - altDownTs >= 1000UL)) {
-      if (bmp.performReading()) {
-        altitudReferencia = bmp.readAltitude(1013.25);
+      if (sensorForcedReading()) {
+        altitudReferencia = sensorPressureToAltitude(bmp.pressure);
 
         // **Importante**: NO borrar el offset (alturaOffset se mantiene).
         // Tras el lock, la UI muestra el offset configurado.
 
         // AGZ: resetear sesgo para que la lectura quede exacta tras el lock
         agzBias = 0.0f;
-        saveAgzBias();
+        { LWD_SECTION("lock_save"); saveAgzBias(); }
 
         Serial.printf("Lock aplicado: ref=%.2fm, offset=%.2fm (AGZ=0)\n",
                       altitudReferencia, alturaOffset);
-#if DEBUG_HZ
-        onSampleAccepted();
-#endif
         powerLockActivate();
       } else {
         Serial.println("Error al leer sensor en recalibración manual.");
@@ -509,7 +365,7 @@ void loop() {
 
     if (okRise) {
       noteUserActivity();
-      // Botón OLED: alternar backlight (ON=brillo menú, OFF=duty 250)
+      // Botón OLED: alternar backlight (ON=brillo menú); atenuado, lo restaura
       lcdBacklightToggle();
     }
 
@@ -528,9 +384,17 @@ void loop() {
     hzReportTick(modoIdx);
   }
 #endif
+  { LWD_SECTION("samp_print"); sampleStatsJumpTick(); }   // [SAMP] por salto
+
+  // Comandos de depuración por Serial (perfil, etc.) + tramas HIL
+  serialCmdTick();
+  hilTick();
+
+  // === Evaluar sueño (batería baja, aterrizaje fijo, inactividad) ===
+  { PROF_SCOPE(PROF_SLEEP_DECIDE); powerGovSleepCheck(); }
 
-  // === Evaluar sueño (aterrizaje fijo primero, luego inactividad) ===
-  maybeEnterDeepSleep();
+  PROF_LOOP_END(getSensorMode());
+  lwdLoopEnd();
 
-  // Sin delay bloqueante: la UI regula su ritmo de repintado por modo
+  // Sin delay: la espera entre plazos la hace powerGovIdle() (loop_sched)
 }
@@ -0,0 +1,685 @@
+#include "power_governor.h"
+#include <Wire.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include "driver/gpio.h"
+#include "driver/rtc_io.h"
+
+#include "config.h"
+#include "sensor_module.h"
+#include "ui_module.h"
+#include "power_lock.h"
+#include "battery.h"
+#include "charge_detect.h"
+#include "datetime_module.h"
+#include "logbook.h"
+#include "logbookUi.h"
+#include "hil_link.h"
+#include "lcd_flush.h"
+#include "loop_sched.h"
+#include "ulp_climb.h"
+#include "warm_boot.h"
+#include "adc_dma.h"
+#include "climb_eco.h"
+#include "display_power.h"
+#include "ds_housekeeping.h"
+#if CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#include <esp_idf_version.h>
+#endif
+
+// --- Dependencias externas ---
+extern bool editingOffset;                  // ui_module.cpp
+extern void noteUserActivity();             // main.cpp
+extern unsigned long getLastActivityMs();   // main.cpp
+
+// === Deep Sleep por aterrizaje (fijo 5 min) ===
+#ifndef LANDING_DS_ENABLE
+#define LANDING_DS_ENABLE   1
+#endif
+#ifndef LANDING_DS_DELAY_MS
+#define LANDING_DS_DELAY_MS 300000UL   // 5 minutos
+#endif
+
+static const uint32_t FLIGHT_GRACE_MS = 120000UL; // 120 s de gracia global
+
+// ===== Escalado de CPU =====
+#ifndef CPU_FREQ_AHORRO_MHZ
+#define CPU_FREQ_AHORRO_MHZ   40
+#endif
+#ifndef CPU_FREQ_ACTIVO_MHZ
+#define CPU_FREQ_ACTIVO_MHZ   160
+#endif
+#ifndef CPU_FREQ_RAPIDO_MHZ
+#define CPU_FREQ_RAPIDO_MHZ   160
+#endif
+
+// ===== I2C (ahorro=100 kHz, vuelo=400 kHz) =====
+#ifndef GOV_I2C_SLOW_HZ
+#define GOV_I2C_SLOW_HZ       100000UL
+#endif
+#ifndef GOV_I2C_FAST_HZ
+#define GOV_I2C_FAST_HZ       400000UL
+#endif
+
+// ===== Latencia pedida por contexto (ms) =====
+#ifndef GOV_LAT_FF_MS
+#define GOV_LAT_FF_MS         10    // = tick de sensor en FF
+#endif
+#ifndef GOV_LAT_CLIMB_MS
+#define GOV_LAT_CLIMB_MS      20
+#endif
+#ifndef GOV_LAT_UI_MS
+#define GOV_LAT_UI_MS         50
+#endif
+#ifndef GOV_LAT_GROUND_MS
+#define GOV_LAT_GROUND_MS     150   // = tick de sensor en Ahorro
+#endif
+
+// ===== Modelo de energía (mA estimados, radios apagadas) =====
+#ifndef GOV_MA_CPU_40
+#define GOV_MA_CPU_40         13.0f
+#endif
+#ifndef GOV_MA_CPU_80
+#define GOV_MA_CPU_80         19.0f
+#endif
+#ifndef GOV_MA_CPU_160
+#define GOV_MA_CPU_160        27.0f
+#endif
+#ifndef GOV_MA_CPU_240
+#define GOV_MA_CPU_240        36.0f
+#endif
+#ifndef GOV_MA_LIGHT_SLEEP
+#define GOV_MA_LIGHT_SLEEP    0.24f
+#endif
+#ifndef GOV_MA_DEEP_SLEEP
+#define GOV_MA_DEEP_SLEEP     0.02f   // placa completa
+#endif
+// BMP390 por modo: FORCED cada 2 s / 20 Hz OSR x8 / 100 Hz OSR x2
+#ifndef GOV_MA_BMP_AHORRO
+#define GOV_MA_BMP_AHORRO     0.004f
+#endif
+#ifndef GOV_MA_BMP_ULTRA
+#define GOV_MA_BMP_ULTRA      0.35f
+#endif
+#ifndef GOV_MA_BMP_CLIMB
+#define GOV_MA_BMP_CLIMB      0.17f   // NORMAL 12.5 Hz OSR x8/x1 (subida económica)
+#endif
+#ifndef GOV_MA_BMP_FF
+#define GOV_MA_BMP_FF         0.70f
+#endif
+#ifndef GOV_MA_LCD
+#define GOV_MA_LCD            0.25f   // ST7567 (lógica + bomba de carga)
+#endif
+#ifndef GOV_MA_LCD_SAVE
+#define GOV_MA_LCD_SAVE       0.005f  // ST7567 en power-save
+#endif
+#ifndef GOV_MA_BACKLIGHT
+#define GOV_MA_BACKLIGHT      18.0f   // 100 % de brillo
+#endif
+#ifndef GOV_WAIT_PCT
+#define GOV_WAIT_PCT          55.0f   // CPU en WAITI (loop bloqueado) vs activa
+#endif
+#ifndef GOV_SLEEPY_AWAKE_PCT
+#define GOV_SLEEPY_AWAKE_PCT  5.0f    // modelo: % despierto en GOV_SLEEPY
+#endif
+#ifndef GOV_CLIMB_AWAKE_PCT
+#define GOV_CLIMB_AWAKE_PCT   10.0f   // modelo: % despierto en GOV_CLIMB (muestra + HUD)
+#endif
+
+// ===== Espera del loop (loop_sched) =====
+#ifndef GOV_USB_POLL_MS
+#define GOV_USB_POLL_MS       20UL    // con USB/HIL: comandos y tramas por CDC
+#endif
+#ifndef GOV_PM_MIN_MHZ
+#define GOV_PM_MIN_MHZ        40      // DFS: suelo con CONFIG_PM_ENABLE
+#endif
+
+// ===== Día de saltos (informe de autonomía) =====
+#ifndef GOV_BATTERY_MAH
+#define GOV_BATTERY_MAH       BATTERY_CAPACITY_MAH
+#endif
+#ifndef GOV_DAY_JUMPS
+#define GOV_DAY_JUMPS         6
+#endif
+#ifndef GOV_DAY_AWAKE_H
+#define GOV_DAY_AWAKE_H       10.0f   // encendido; el resto del día en deep sleep
+#endif
+#ifndef GOV_DAY_CLIMB_MIN
+#define GOV_DAY_CLIMB_MIN     20.0f
+#endif
+#ifndef GOV_DAY_FF_S
+#define GOV_DAY_FF_S          60.0f
+#endif
+#ifndef GOV_DAY_CANOPY_MIN
+#define GOV_DAY_CANOPY_MIN    5.0f
+#endif
+#ifndef GOV_AVG_TAU_S
+#define GOV_AVG_TAU_S         600.0f  // media móvil de consumo (predicción de autonomía)
+#endif
+
+// ------------------------------
+// Perfiles por estado
+// ------------------------------
+struct GovProfile {
+  const char* name;
+  uint16_t    cpuMHz;
+  uint32_t    i2cHz;
+  bool        lightSleep;
+  uint32_t    latencyMs;    // peor respuesta que garantiza
+};
+
+static const GovProfile kProf[GOV_STATE_COUNT] = {
+  { "dormido", CPU_FREQ_AHORRO_MHZ, GOV_I2C_SLOW_HZ, true,  FORCED_AHORRO_MS  },
+  { "tierra",  CPU_FREQ_AHORRO_MHZ, GOV_I2C_SLOW_HZ, false, GOV_LAT_GROUND_MS },
+  { "ui",      CPU_FREQ_ACTIVO_MHZ, GOV_I2C_SLOW_HZ, false, GOV_LAT_UI_MS     },
+  { "vuelo",   CPU_FREQ_RAPIDO_MHZ, GOV_I2C_FAST_HZ, false, GOV_LAT_FF_MS     },
+  { "subida",  CPU_FREQ_AHORRO_MHZ, GOV_I2C_FAST_HZ, true,  CLIMB_ECO_PERIOD_MS },
+};
+
+enum GovSub : uint8_t { SUB_CPU = 0, SUB_SENSOR, SUB_LCD, SUB_BACKLIGHT, SUB_COUNT };
+static const char* const kSubNames[SUB_COUNT] = { "cpu", "sensor", "lcd", "backlight" };
+
+// ------------------------------
+// Estado
+// ------------------------------
+static GovState      s_state      = GOV_IDLE;
+static uint16_t      s_curMHz     = 0;
+static uint32_t      s_curI2cHz   = 0;
+static float         s_blFrac     = 0.0f;   // 0..1 del brillo máximo (duty real)
+static bool          s_lcdAsleep  = false;
+static int64_t       s_lastUs     = 0;
+static int64_t       s_sleptUs    = 0;      // light-sleep desde el último tick
+static int64_t       s_waitUs     = 0;      // loop bloqueado en schedWait()
+static bool          s_curAutoSleep = false;
+static bool          s_started    = false;
+
+// Contabilidad (desde el último reset)
+static double        s_stateS[GOV_STATE_COUNT];
+static double        s_stateMAs[GOV_STATE_COUNT];
+static double        s_subMAs[SUB_COUNT];
+static double        s_totalS     = 0.0;
+static uint32_t      s_lightSleeps = 0;
+static float         s_avgMa      = -1.0f;  // media móvil (no se resetea con 'G')
+
+// Deep sleep: aterrizaje + gracia de vuelo
+static SensorMode    s_prevMode      = SENSOR_MODE_AHORRO;
+static bool          s_landingArmed  = false;
+static unsigned long s_landingT0     = 0;
+static bool          s_flightGraceArmed = false;
+static uint32_t      s_flightGraceT0    = 0;
+static bool          s_prevInFlight     = false;
+
+// ------------------------------
+// Modelo
+// ------------------------------
+static float cpuMa(uint16_t mhz) {
+  if (mhz <= 40)  return GOV_MA_CPU_40;
+  if (mhz <= 80)  return GOV_MA_CPU_80;
+  if (mhz <= 160) return GOV_MA_CPU_160;
+  return GOV_MA_CPU_240;
+}
+
+static float sensorMa(SensorMode m, bool eco) {
+  if (eco)                            return GOV_MA_BMP_CLIMB;
+  if (m == SENSOR_MODE_FREEFALL)      return GOV_MA_BMP_FF;
+  if (m == SENSOR_MODE_ULTRA_PRECISO) return GOV_MA_BMP_ULTRA;
+  return GOV_MA_BMP_AHORRO;
+}
+
+// Corriente media estimada de un estado (sin backlight)
+static float modelMa(GovState st, SensorMode m) {
+  float cpu = cpuMa(kProf[st].cpuMHz);
+  if (kProf[st].lightSleep) {
+    const float awake = (st == GOV_CLIMB ? GOV_CLIMB_AWAKE_PCT : GOV_SLEEPY_AWAKE_PCT) / 100.0f;
+    cpu = awake * cpu + (1.0f - awake) * GOV_MA_LIGHT_SLEEP;
+  }
+  return cpu + sensorMa(m, st == GOV_CLIMB) + GOV_MA_LCD;
+}
+
+// ------------------------------
+// Vuelo y gracia
+// ------------------------------
+static inline bool inFlightNow() {
+  if (getSensorMode() != SENSOR_MODE_AHORRO) return true;  // modo de vuelo activo
+  if (enSalto || inJump)                     return true;  // flags de salto
+  return false;
+}
+
+static void updateFlightGraceWindow() {
+  const bool nowInFlight = inFlightNow();
+  if (nowInFlight) {
+    s_prevInFlight     = true;
+    s_flightGraceArmed = false;
+  } else if (s_prevInFlight) {
+    s_flightGraceArmed = true;
+    s_flightGraceT0    = millis();
+    s_prevInFlight     = false;
+  }
+}
+
+static inline bool inFlightGraceNow() {
+  return s_flightGraceArmed && (millis() - s_flightGraceT0 < FLIGHT_GRACE_MS);
+}
+
+bool powerGovInFlight() { return inFlightNow() || inFlightGraceNow(); }
+
+// ------------------------------
+// Elección de estado
+// ------------------------------
+static uint32_t requiredLatencyMs() {
+  const SensorMode m = getSensorMode();
+  if (m == SENSOR_MODE_FREEFALL)      return GOV_LAT_FF_MS;
+  if (m == SENSOR_MODE_ULTRA_PRECISO) return climbEcoActive() ? CLIMB_ECO_PERIOD_MS : GOV_LAT_CLIMB_MS;
+
+  const bool interactive = menuActivo || editingOffset || logbookUiIsActive() ||
+                           datetimeMenuActive() || gameSnakeRunning;
+  if (interactive) return GOV_LAT_UI_MS;
+
+  // Lock del usuario o HIL (bytes por USB-CDC): despierto pero lento
+  if (powerLockActive() || hilActive()) return GOV_LAT_GROUND_MS;
+  return FORCED_AHORRO_MS;
+}
+
+// El más barato (modelo) cuya latencia cumple lo pedido
+static GovState pickState() {
+  const uint32_t need = requiredLatencyMs();
+  const SensorMode m  = getSensorMode();
+  GovState best = GOV_FLIGHT;
+  float bestMa  = 1e9f;
+  // GOV_CLIMB sólo con el BMP en NORMAL; el backlight (LEDC) y el
+  // USB-CDC no sobreviven al light-sleep
+  const bool climbOk = climbEcoActive() && s_blFrac == 0.0f && !isUsbPresent();
+  for (uint8_t i = 0; i < GOV_STATE_COUNT; ++i) {
+    if (kProf[i].latencyMs > need) continue;
+    if (i == GOV_CLIMB && !climbOk) continue;
+    const float ma = modelMa((GovState)i, m);
+    if (ma < bestMa) { bestMa = ma; best = (GovState)i; }
+  }
+  return best;
+}
+
+#if CONFIG_PM_ENABLE
+// DFS + light-sleep automático mientras el loop espera. El LEDC del
+// backlight y el USB-CDC no sobreviven al light-sleep: sólo sin ellos.
+static void pmApply(uint16_t maxMHz, bool autoSleep) {
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_pm_config_t pm = {};
+#else
+  esp_pm_config_esp32s3_t pm = {};
+#endif
+  pm.max_freq_mhz = maxMHz;
+  pm.min_freq_mhz = (maxMHz < GOV_PM_MIN_MHZ) ? maxMHz : GOV_PM_MIN_MHZ;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  pm.light_sleep_enable = autoSleep;
+#else
+  (void)autoSleep;
+#endif
+  esp_pm_configure(&pm);
+}
+#endif
+
+static void applyState(GovState st) {
+  const GovProfile& p = kProf[st];
+#if CONFIG_PM_ENABLE
+  const bool autoSleep = (s_blFrac == 0.0f) && !isUsbPresent() && !hilActive();
+  if (p.cpuMHz != s_curMHz || autoSleep != s_curAutoSleep) {
+    lcdFlushWaitIdle(5);   // el divisor SPI cuelga de APB
+    pmApply(p.cpuMHz, autoSleep);
+    s_curMHz = p.cpuMHz;
+    s_curAutoSleep = autoSleep;
+  }
+#else
+  if (p.cpuMHz != s_curMHz) {
+    lcdFlushWaitIdle(5);   // el divisor SPI cuelga de APB
+    setCpuFrequencyMhz(p.cpuMHz);
+    s_curMHz = p.cpuMHz;
+  }
+#endif
+  if (p.i2cHz != s_curI2cHz) {
+    Wire.setClock(p.i2cHz);
+    s_curI2cHz = p.i2cHz;
+  }
+  s_state = st;
+}
+
+// ------------------------------
+// Contabilidad
+// ------------------------------
+static void account() {
+  const int64_t now = esp_timer_get_time();
+  int64_t dtUs = now - s_lastUs;
+  s_lastUs = now;
+  if (dtUs <= 0) { s_sleptUs = 0; s_waitUs = 0; return; }
+
+  int64_t slept = s_sleptUs;
+  if (slept > dtUs) slept = dtUs;
+  int64_t waited = s_waitUs;
+  if (waited > dtUs - slept) waited = dtUs - slept;
+  s_sleptUs = 0;
+  s_waitUs  = 0;
+
+  const double dt     = dtUs * 1e-6;
+  const double awakeS = (dtUs - slept - waited) * 1e-6;
+  const double waitS  = waited * 1e-6;
+  const double sleptS = slept * 1e-6;
+
+  const double cpu = awakeS * cpuMa(s_curMHz) +
+                     waitS  * cpuMa(s_curMHz) * (GOV_WAIT_PCT / 100.0f) +
+                     sleptS * GOV_MA_LIGHT_SLEEP;
+  const double sen = dt * sensorMa(getSensorMode(), climbEcoActive());
+  const double lcd = dt * (s_lcdAsleep ? GOV_MA_LCD_SAVE : GOV_MA_LCD);
+  const double bl  = dt * GOV_MA_BACKLIGHT * s_blFrac;
+
+  s_subMAs[SUB_CPU]       += cpu;
+  s_subMAs[SUB_SENSOR]    += sen;
+  s_subMAs[SUB_LCD]       += lcd;
+  s_subMAs[SUB_BACKLIGHT] += bl;
+  s_stateS[s_state]   += dt;
+  s_stateMAs[s_state] += cpu + sen + lcd + bl;
+  s_totalS += dt;
+
+  const float ma = (float)((cpu + sen + lcd + bl) / dt);
+  if (s_avgMa < 0.0f) s_avgMa = ma;
+  else                s_avgMa += (ma - s_avgMa) * (float)(dt / (GOV_AVG_TAU_S + dt));
+}
+
+// ------------------------------
+// Wake por GPIO (nivel alto)
+// ------------------------------
+// Botón: ACTIVO-ALTO (pulldown). VBUS: HIGH con divisor 330k/510k (o similar).
+static void setupWakeSourceGPIO() {
+  // Config digital (no rige en deep-sleep, pero útil en runtime)
+  pinMode(WAKE_BTN_PIN, INPUT_PULLDOWN);
+
+  pinMode(CHARGE_ADC_PIN, INPUT);
+  gpio_pullup_dis((gpio_num_t)CHARGE_ADC_PIN);
+  gpio_pulldown_dis((gpio_num_t)CHARGE_ADC_PIN);
+
+  // Fuentes de wake (EXT1: cualquiera en HIGH)
+  const uint64_t mask = (1ULL << WAKE_BTN_PIN) | (1ULL << CHARGE_ADC_PIN);
+  ESP_ERROR_CHECK(esp_sleep_enable_ext1_wakeup(mask, ESP_EXT1_WAKEUP_ANY_HIGH));
+}
+
+// Wake GPIO para light-sleep (nivel alto en botones/VBUS)
+static void setupGpioWakeForLightSleep() {
+  gpio_wakeup_enable((gpio_num_t)BUTTON_MENU,     GPIO_INTR_HIGH_LEVEL);
+  gpio_wakeup_enable((gpio_num_t)BUTTON_ALTITUDE, GPIO_INTR_HIGH_LEVEL);
+  gpio_wakeup_enable((gpio_num_t)BUTTON_OLED,     GPIO_INTR_HIGH_LEVEL);
+  gpio_wakeup_enable((gpio_num_t)CHARGE_ADC_PIN,  GPIO_INTR_HIGH_LEVEL);
+  ESP_ERROR_CHECK(esp_sleep_enable_gpio_wakeup());
+}
+
+// Pull-downs RTC: niveles estables durante deep-sleep
+static void armRtcPullsForDeepSleep() {
+  rtc_gpio_init((gpio_num_t)WAKE_BTN_PIN);
+  rtc_gpio_set_direction((gpio_num_t)WAKE_BTN_PIN, RTC_GPIO_MODE_INPUT_ONLY);
+  rtc_gpio_pullup_dis((gpio_num_t)WAKE_BTN_PIN);
+  rtc_gpio_pulldown_en((gpio_num_t)WAKE_BTN_PIN);
+
+  rtc_gpio_init((gpio_num_t)CHARGE_ADC_PIN);
+  rtc_gpio_set_direction((gpio_num_t)CHARGE_ADC_PIN, RTC_GPIO_MODE_INPUT_ONLY);
+  rtc_gpio_pullup_dis((gpio_num_t)CHARGE_ADC_PIN);
+  rtc_gpio_pulldown_en((gpio_num_t)CHARGE_ADC_PIN);
+}
+
+// ------------------------------
+// Deep sleep
+// ------------------------------
+// EXT1 (botón/VBUS) siempre; ULP y timer de mantenimiento salvo
+// con batería baja. Devuelve los µs del timer (0 = sin timer)
+static uint64_t armDeepSleepWakeups() {
+  armRtcPullsForDeepSleep();
+
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+  const uint64_t mask = (1ULL << WAKE_BTN_PIN) | (1ULL << CHARGE_ADC_PIN);
+  ESP_ERROR_CHECK(esp_sleep_enable_ext1_wakeup(mask, ESP_EXT1_WAKEUP_ANY_HIGH));
+
+  if (batteryShouldDeepSleep()) { ulpClimbStop(); return 0; }
+  ulpClimbArm();            // ULP vigila la presión (subida en el avión)
+  return dsHousekeepingArm();
+}
+
+static void enterDeepSleepNow(const char* reason) {
+  if (powerGovInFlight()) {
+    Serial.printf("Deep sleep BLOQUEADO por vuelo/gracia (%s).\n", reason);
+    return;
+  }
+
+  // Evitar dormir si el botón está presionado (EXT1 despertaría al instante)
+  if (digitalRead(WAKE_BTN_PIN) == HIGH) {
+    Serial.println("Deep sleep cancelado: botón en HIGH.");
+    noteUserActivity();
+    return;
+  }
+  if (isUsbPresent()) {
+    Serial.println("Deep sleep cancelado: USB presente.");
+    noteUserActivity();
+    return;
+  }
+
+  Serial.printf("Entrando a deep sleep por %s...\n", reason);
+
+  logbookFinalizeIfOpen();
+  warmBootSave();         // después de cerrar el salto: cabecera definitiva
+
+  // Apagar LCD de forma segura
+  adcDmaPause(20);        // los pines pasan al RTC (pull-downs de wake)
+  displayPowerOff();      // LCD en power-save y backlight retenido apagado
+
+  const uint64_t timerUs = armDeepSleepWakeups();
+  datetimeOnBeforeDeepSleep(timerUs);
+
+  delay(30);
+  Serial.flush();
+  esp_deep_sleep_start();   // ¡a dormir!
+}
+
+void powerGovReenterDeepSleep() {
+  armDeepSleepWakeups();    // sin NVS: la hora sigue en el contador RTC
+  gpio_deep_sleep_hold_en();  // el BL sigue retenido desde el primer sueño
+  Serial.flush();
+  esp_deep_sleep_start();
+}
+
+static void landingTimerTick() {
+#if LANDING_DS_ENABLE
+  const SensorMode cur = getSensorMode();
+  if (s_prevMode != SENSOR_MODE_AHORRO && cur == SENSOR_MODE_AHORRO) {
+    s_landingArmed = true;
+    s_landingT0    = millis();
+  }
+  if (s_prevMode == SENSOR_MODE_AHORRO && cur != SENSOR_MODE_AHORRO) s_landingArmed = false;
+  s_prevMode = cur;
+#endif
+}
+
+static void maybeEnterDeepSleep() {
+  if (powerGovInFlight()) return;
+  if (isUsbPresent()) { noteUserActivity(); return; }
+
+  const unsigned long lastAct = getLastActivityMs();
+
+#if LANDING_DS_ENABLE
+  if (s_landingArmed && !menuActivo && !gameSnakeRunning && !powerLockActive()) {
+    if (getSensorMode() == SENSOR_MODE_AHORRO) {
+      if (millis() - lastAct >= 10000UL && millis() - s_landingT0 >= LANDING_DS_DELAY_MS)
+        enterDeepSleepNow("aterrizaje (5min)");
+    } else {
+      s_landingArmed = false;
+    }
+  }
+#endif
+
+  if (ahorroTimeoutMs == 0) return;            // OFF
+  if (menuActivo) return;                      // no dormir dentro del menú
+  if (gameSnakeRunning) return;                // no dormir durante Snake
+  if (powerLockActive()) return;               // sleep-lock activo
+  if (getSensorMode() != SENSOR_MODE_AHORRO) return;
+
+  if ((millis() - lastAct) >= ahorroTimeoutMs) enterDeepSleepNow("inactividad");
+}
+
+// ------------------------------
+// API
+// ------------------------------
+void powerGovBegin() {
+  setupWakeSourceGPIO();   // EXT1 (se vuelve a armar antes de dormir)
+  s_prevMode     = getSensorMode();
+  s_landingArmed = false;
+  s_curMHz = 0; s_curI2cHz = 0;
+  applyState(pickState());
+  s_lastUs = esp_timer_get_time();
+  s_started = true;
+}
+
+bool powerGovStarted() { return s_started; }
+
+void powerGovTick() {
+  account();                 // el intervalo previo, con el estado que tenía
+  s_blFrac    = displayPowerBacklightFrac();   // también a mitad de un fade
+  s_lcdAsleep = displayPowerLcdAsleep();
+  updateFlightGraceWindow();
+  applyState(pickState());
+}
+
+// Light-sleep explícito hasta la próxima muestra: la FORCED en tierra
+// (GOV_SLEEPY) o el DRDY del BMP en NORMAL en la subida (GOV_CLIMB)
+static void lightSleepUntilSample() {
+  const bool climb = (s_state == GOV_CLIMB);
+  const uint32_t rem_ms = climb ? climbEcoMsUntilNext() : sensor_ms_until_next_forced_read();
+  // Descanso demasiado corto; en tierra, despertar un poco antes de la
+  // lectura. En la subida el dato ya lo tiene el sensor: al DRDY justo
+  const uint32_t MIN_MS    = climb ? 5 : 25;
+  const uint32_t SAFETY_MS = climb ? 0 : 8;
+  if (rem_ms < MIN_MS) return;
+  const uint64_t sleep_us = (uint64_t)(rem_ms - SAFETY_MS) * 1000ULL;
+
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+  setupGpioWakeForLightSleep();
+  if (climb) climbEcoArmLightSleepWake();   // INT del BMP (si está cableado)
+  ESP_ERROR_CHECK(esp_sleep_enable_timer_wakeup(sleep_us));
+
+  Serial.flush();                // evita que el UART despierte/consuma
+  lcdFlushWaitIdle(5);           // no cortar un DMA del LCD a medias
+  adcDmaPause(5);                // ni una ráfaga del ADC
+  const int64_t t0 = esp_timer_get_time();
+  esp_light_sleep_start();       // vuelve aquí al despertar (timer o GPIO)
+  s_sleptUs += esp_timer_get_time() - t0;
+  adcDmaResume();
+  s_lightSleeps++;
+  schedRearmGpio();              // botones otra vez por flanco
+  if (climb) climbEcoAfterLightSleep();
+}
+
+void powerGovIdle() {
+  // Re-evalúa: la UI pudo abrir un menú en esta vuelta
+  if (kProf[s_state].lightSleep && kProf[pickState()].lightSleep) lightSleepUntilSample();
+
+  // Resto de la vuelta: loop bloqueado hasta el próximo plazo o un botón
+  const uint32_t cap = (isUsbPresent() || hilActive()) ? GOV_USB_POLL_MS : SCHED_MAX_WAIT_MS;
+  const int64_t t0 = esp_timer_get_time();
+  schedWait(cap);
+  s_waitUs += esp_timer_get_time() - t0;
+}
+
+void powerGovSleepCheck() {
+  // Corte por batería baja, pero NUNCA durante el vuelo
+  if (!powerGovInFlight() && batteryShouldDeepSleep()) {
+    enterDeepSleepNow("batería baja");
+    return;
+  }
+  landingTimerTick();
+  maybeEnterDeepSleep();
+}
+
+GovState powerGovState() { return s_state; }
+
+// ------------------------------
+// Informe
+// ------------------------------
+static float meanMa(GovState st, SensorMode m) {
+  // Medido si hay al menos 1 min en el estado; si no, modelo
+  return (s_stateS[st] >= 60.0) ? (float)(s_stateMAs[st] / s_stateS[st]) : modelMa(st, m);
+}
+
+// Día de saltos: vuelo con el modelo, tierra con el reparto medido
+static float dayMah(float &sleepyFr) {
+  const float jumps     = GOV_DAY_JUMPS;
+  const float climbH    = jumps * GOV_DAY_CLIMB_MIN / 60.0f;
+  const float canopyH   = jumps * GOV_DAY_CANOPY_MIN / 60.0f;
+  const float ffH       = jumps * GOV_DAY_FF_S / 3600.0f;
+  float groundH         = GOV_DAY_AWAKE_H - climbH - canopyH - ffH;
+  if (groundH < 0) groundH = 0;
+  const double groundS  = s_stateS[GOV_SLEEPY] + s_stateS[GOV_IDLE] + s_stateS[GOV_UI];
+  sleepyFr              = groundS >= 60.0 ? (float)(s_stateS[GOV_SLEEPY] / groundS) : 0.9f;
+  const float groundMa  = sleepyFr * meanMa(GOV_SLEEPY, SENSOR_MODE_AHORRO) +
+                          (1.0f - sleepyFr) * meanMa(GOV_IDLE, SENSOR_MODE_AHORRO);
+  // Subida en GOV_CLIMB si la subida económica está habilitada
+  const GovState climbSt = CLIMB_ECO_ENABLE ? GOV_CLIMB : GOV_FLIGHT;
+  return climbH  * meanMa(climbSt, SENSOR_MODE_ULTRA_PRECISO) +
+         canopyH * meanMa(GOV_FLIGHT, SENSOR_MODE_ULTRA_PRECISO) +
+         ffH    * modelMa(GOV_FLIGHT, SENSOR_MODE_FREEFALL) +
+         groundH * groundMa +
+         (24.0f - GOV_DAY_AWAKE_H) * (GOV_MA_DEEP_SLEEP + dsHousekeepingAvgMa());
+}
+
+float powerGovLoadMa() {
+  const float lcdSave = s_lcdAsleep ? (GOV_MA_LCD_SAVE - GOV_MA_LCD) : 0.0f;
+  return modelMa(s_state, getSensorMode()) + lcdSave + GOV_MA_BACKLIGHT * s_blFrac;
+}
+
+float powerGovAvgMa() {
+  return (s_avgMa >= 0.0f) ? s_avgMa : powerGovLoadMa();
+}
+
+float powerGovMahPerJump() {
+  float sleepyFr;
+  return dayMah(sleepyFr) / (float)GOV_DAY_JUMPS;
+}
+
+void powerGovDump() {
+  const GovProfile& p = kProf[s_state];
+  Serial.printf("[GOV] estado=%s cpu=%uMHz i2c=%lukHz bl=%u%% latencia pedida=%lums light-sleeps=%lu\n",
+                p.name, (unsigned)s_curMHz, (unsigned long)(s_curI2cHz / 1000),
+                (unsigned)(s_blFrac * 100.0f + 0.5f), (unsigned long)requiredLatencyMs(),
+                (unsigned long)s_lightSleeps);
+
+  for (uint8_t i = 0; i < GOV_STATE_COUNT; ++i) {
+    const double pct = s_totalS > 0 ? 100.0 * s_stateS[i] / s_totalS : 0.0;
+    Serial.printf("[GOV] %-8s t=%.0fs (%.1f%%) %.3fmAh media=%.2fmA modelo=%.2fmA\n",
+                  kProf[i].name, s_stateS[i], pct, s_stateMAs[i] / 3600.0,
+                  s_stateS[i] > 0 ? s_stateMAs[i] / s_stateS[i] : 0.0,
+                  modelMa((GovState)i, (i == GOV_FLIGHT || i == GOV_CLIMB)
+                                                ? SENSOR_MODE_ULTRA_PRECISO : SENSOR_MODE_AHORRO));
+  }
+
+  double total = 0;
+  for (uint8_t i = 0; i < SUB_COUNT; ++i) total += s_subMAs[i];
+  for (uint8_t i = 0; i < SUB_COUNT; ++i)
+    Serial.printf("[GOV] %-9s %.3fmAh (%.1f%%)\n", kSubNames[i], s_subMAs[i] / 3600.0,
+                  total > 0 ? 100.0 * s_subMAs[i] / total : 0.0);
+  Serial.printf("[GOV] total %.3fmAh en %.2fh (media %.2fmA)\n",
+                total / 3600.0, s_totalS / 3600.0, s_totalS > 0 ? total / s_totalS : 0.0);
+
+  float sleepyFr;
+  const float mAhDay = dayMah(sleepyFr);
+  Serial.printf("[GOV] dia de saltos (%d saltos, %.0fh encendido, %.0f%% dormido en tierra): %.1fmAh/dia -> %.1f dias con %.0fmAh\n",
+                (int)GOV_DAY_JUMPS, (double)GOV_DAY_AWAKE_H, sleepyFr * 100.0f, mAhDay,
+                mAhDay > 0 ? GOV_BATTERY_MAH / mAhDay : 0.0f, (double)GOV_BATTERY_MAH);
+  Serial.printf("[GOV] bateria %d%% (%.2fV medida, %.2fV OCV) a %.2fmA medios: %.1fh, ~%d saltos (%.1fmAh/salto)\n",
+                batteryGetPercent(), batteryGetVoltage(), batteryGetOcvVoltage(), powerGovAvgMa(),
+                batteryRemainingHours(), batteryRemainingJumps(), powerGovMahPerJump());
+}
+
+void powerGovReset() {
+  for (auto &v : s_stateS)   v = 0;
+  for (auto &v : s_stateMAs) v = 0;
+  for (auto &v : s_subMAs)   v = 0;
+  s_totalS = 0;
+  s_lightSleeps = 0;
+  s_lastUs = esp_timer_get_time();
+  s_sleptUs = 0;
+  s_waitUs  = 0;
+  Serial.println("[GOV] reset");
+}
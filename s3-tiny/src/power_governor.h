@@ -0,0 +1,72 @@
+#ifndef POWER_GOVERNOR_H
+#define POWER_GOVERNOR_H
+
+// =====================================================
+// Gobernador de energía
+// -----------------------------------------------------
+// Único dueño de las decisiones de consumo:
+//  - CPU MHz y reloj I2C por estado (antes powerPolicyTick()
+//    en la UI y setI2cForMode() en el sensor),
+//  - light-sleep entre lecturas FORCED en tierra y entre
+//    DRDY del BMP en la subida económica (climb_eco), espera
+//    del loop entre plazos (DFS/light-sleep automático con
+//    CONFIG_PM_ENABLE),
+//  - deep sleep: inactividad, aterrizaje (5 min) y batería
+//    baja, siempre con blindaje de vuelo + gracia; despierta
+//    por botón/VBUS, ULP y timer de mantenimiento,
+//  - contabilidad de la pantalla: duty real del backlight y
+//    LCD en power-save (lo decide display_power).
+// Cada estado tiene un perfil (MHz, I2C, light-sleep) y la
+// peor latencia de respuesta que garantiza. El contexto pide
+// una latencia (FF, subida/campana, UI, tierra) y se elige el
+// estado más barato que la cumple.
+// Modelo de energía: corriente estimada por subsistema (CPU,
+// sensor según ODR/OSR del modo, LCD, backlight). Se integra
+// tiempo y mAh por estado y subsistema; 'g' por Serial vuelca
+// el informe y la autonomía estimada por día de saltos.
+// Radios: siempre apagadas (boardLowPowerInit en la UI).
+// =====================================================
+
+#include <Arduino.h>
+
+enum GovState : uint8_t {
+  GOV_SLEEPY = 0,   // tierra: 40 MHz + light-sleep hasta la próxima FORCED
+  GOV_IDLE,         // tierra sin dormir (lock, HIL, USB...)
+  GOV_UI,           // menú/pantallas interactivas
+  GOV_FLIGHT,       // Ultra / FF: bus rápido, CPU a tope
+  GOV_CLIMB,        // subida económica: 40 MHz + light-sleep hasta el DRDY del BMP
+  GOV_STATE_COUNT
+};
+
+void powerGovBegin();
+bool powerGovStarted();             // false hasta powerGovBegin(): sin modelo de carga
+
+// Antes de updateUI(): elige estado, aplica CPU/I2C e integra energía
+void powerGovTick();
+
+// Tras la UI: light-sleep si el estado lo permite y después
+// loop bloqueado hasta el próximo plazo (loop_sched)
+void powerGovIdle();
+
+// Final de loop(): temporizador de aterrizaje, batería baja e
+// inactividad -> deep sleep (no retorna si duerme)
+void powerGovSleepCheck();
+
+// Tras el mantenimiento por timer (ds_housekeeping): mismas fuentes
+// de despertar y de vuelta a deep sleep sin el apagado completo
+void powerGovReenterDeepSleep();
+
+bool     powerGovInFlight();        // modo de vuelo o gracia post-aterrizaje
+GovState powerGovState();
+
+// Consumo para la batería: corriente del modelo ahora (caída por
+// resistencia interna), media móvil de GOV_AVG_TAU_S y mAh por
+// salto del día de saltos (incluye tierra y deep sleep nocturno)
+float powerGovLoadMa();
+float powerGovAvgMa();
+float powerGovMahPerJump();
+
+void powerGovDump();
+void powerGovReset();
+
+#endif // POWER_GOVERNOR_H
@@ -0,0 +1,71 @@
+#include "profiler.h"
+
+#if ALT_PROF
+
+#include "log_hist.h"
+
+// ------------------------------
+// Estado (RAM fija: PROF_COUNT histogramas)
+// ------------------------------
+static LogHist  s_hist[PROF_COUNT];
+static bool     s_init        = false;
+
+static int64_t  s_loopT0       = 0;   // inicio de iteración (µs)
+static int64_t  s_loopPausedUs = 0;   // µs excluidos (light-sleep)
+static int64_t  s_pauseT0      = 0;
+
+static const char* const kProfNames[PROF_COUNT] = {
+  "sensor", "logbook", "ui", "uiAlt", "battery", "charge", "sleepdec",
+  "loopAhorr", "loopUltra", "loopFF",
+};
+
+static inline void ensureInit() {
+  if (s_init) return;
+  for (auto &h : s_hist) h.reset();
+  s_init = true;
+}
+
+void profRecordUs(ProfId id, uint32_t us) {
+  if (id >= PROF_COUNT) return;
+  ensureInit();
+  s_hist[id].add(us);
+}
+
+// ------------------------------
+// Iteración de loop()
+// ------------------------------
+void profLoopBegin() {
+  s_loopT0       = esp_timer_get_time();
+  s_loopPausedUs = 0;
+}
+
+void profLoopPause()  { s_pauseT0 = esp_timer_get_time(); }
+void profLoopResume() { s_loopPausedUs += esp_timer_get_time() - s_pauseT0; }
+
+void profLoopEnd(uint8_t sensorMode) {
+  if (sensorMode > 2) sensorMode = 2;
+  const int64_t total = esp_timer_get_time() - s_loopT0;
+  const int64_t busy  = (total > s_loopPausedUs) ? (total - s_loopPausedUs) : 0;
+  profRecordUs((ProfId)(PROF_LOOP_AHORRO + sensorMode), (uint32_t)busy);
+}
+
+// ------------------------------
+// Volcado / reset
+// ------------------------------
+void profDump() {
+  ensureInit();
+  Serial.printf("[PROF] cpu=%luMHz\n", (unsigned long)getCpuFrequencyMhz());
+  for (uint8_t i = 0; i < PROF_COUNT; ++i) s_hist[i].print("[PROF]", kProfNames[i]);
+  Serial.printf("[PROF] peor loop (us): ahorro=%lu ultra=%lu ff=%lu\n",
+                (unsigned long)s_hist[PROF_LOOP_AHORRO].maxv,
+                (unsigned long)s_hist[PROF_LOOP_ULTRA].maxv,
+                (unsigned long)s_hist[PROF_LOOP_FREEFALL].maxv);
+}
+
+void profReset() {
+  for (auto &h : s_hist) h.reset();
+  s_init = true;
+  Serial.println("[PROF] reset");
+}
+
+#endif // ALT_PROF
@@ -0,0 +1,80 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// =====================================================
+// Profiler de ruta caliente (esp_timer, µs)
+// -----------------------------------------------------
+// - PROF_SCOPE(id): mide el bloque actual y lo acumula en
+//   un histograma log2 de memoria fija (log_hist.h).
+// - PROF_LOOP_*: tiempo de iteración de loop() por SensorMode,
+//   excluyendo el tramo de light-sleep.
+// - Volcado bajo demanda por Serial ('p' volcar, 'P' reset).
+// - Tiempo en µs de esp_timer, no ciclos: el gobernador
+//   cambia la frecuencia de CPU a mitad de un scope y los
+//   ciclos ya no se podrían convertir.
+// Con ALT_PROF=0 (defecto) todas las macros desaparecen.
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef ALT_PROF
+  #define ALT_PROF 0
+#endif
+
+enum ProfId : uint8_t {
+  PROF_SENSOR = 0,     // updateSensorData()
+  PROF_LOGBOOK_TICK,   // logbookTick()
+  PROF_UI,             // updateUI()
+  PROF_UI_ALT,         // bloque de altitud grande del HUD
+  PROF_BATTERY,        // batteryUpdate()
+  PROF_CHARGE,         // chargeDetectUpdate()
+  PROF_SLEEP_DECIDE,   // corte por batería + maybeEnterDeepSleep()
+  PROF_LOOP_AHORRO,    // loop() completo en cada modo
+  PROF_LOOP_ULTRA,
+  PROF_LOOP_FREEFALL,
+  PROF_COUNT
+};
+
+#if ALT_PROF
+
+#include <esp_timer.h>
+
+void profRecordUs(ProfId id, uint32_t us);
+void profLoopBegin();
+void profLoopPause();
+void profLoopResume();
+void profLoopEnd(uint8_t sensorMode);
+void profDump();
+void profReset();
+
+class ProfScope {
+public:
+  explicit ProfScope(ProfId id) : id_(id), t0_(esp_timer_get_time()) {}
+  ~ProfScope() { profRecordUs(id_, (uint32_t)(esp_timer_get_time() - t0_)); }
+private:
+  ProfId  id_;
+  int64_t t0_;
+};
+
+#define PROF_CAT_(a, b) a##b
+#define PROF_CAT(a, b)  PROF_CAT_(a, b)
+#define PROF_SCOPE(id)      ProfScope PROF_CAT(_prof_, __LINE__)(id)
+#define PROF_LOOP_BEGIN()   profLoopBegin()
+#define PROF_LOOP_PAUSE()   profLoopPause()
+#define PROF_LOOP_RESUME()  profLoopResume()
+#define PROF_LOOP_END(mode) profLoopEnd((uint8_t)(mode))
+
+#else
+
+#define PROF_SCOPE(id)      do {} while (0)
+#define PROF_LOOP_BEGIN()   do {} while (0)
+#define PROF_LOOP_PAUSE()   do {} while (0)
+#define PROF_LOOP_RESUME()  do {} while (0)
+#define PROF_LOOP_END(mode) do {} while (0)
+
+static inline void profDump()  { Serial.println("[PROF] deshabilitado (compilar con -D ALT_PROF=1)"); }
+static inline void profReset() {}
+
+#endif // ALT_PROF
+
+#endif // PROFILER_H
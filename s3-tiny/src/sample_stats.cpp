@@ -0,0 +1,167 @@
+#include "sample_stats.h"
+#include "log_hist.h"
+#include "logbook.h"
+#include <esp_timer.h>
+
+#ifndef SAMPLE_MISS_FACTOR
+  #define SAMPLE_MISS_FACTOR 1.5f   // intervalo > 1.5×objetivo => hubo pérdidas
+#endif
+
+// ------------------------------
+// Contadores por modo (0=Ahorro, 1=Ultra, 2=Freefall)
+// ------------------------------
+struct ModeStats {
+  uint32_t conv;     // performReading() intentadas
+  uint32_t failed;   // performReading() == false
+  uint32_t dup;      // presión idéntica a la anterior (dato rancio)
+  uint32_t missed;   // conversiones que debieron ocurrir y no ocurrieron
+  LogHist  iv;       // intervalo entre conversiones OK (us)
+
+  void reset() { conv = failed = dup = missed = 0; iv.reset(); }
+};
+
+static const char* const kModeNames[3] = { "ahorro", "ultra", "ff" };
+
+static ModeStats s_total[3];           // desde boot / último reset
+static ModeStats s_jump[3];            // salto en curso
+static uint32_t  s_target_ms[3]  = { 0, 0, 0 };
+static bool      s_init          = false;
+
+static int64_t   s_lastOkUs      = 0;
+static uint8_t   s_lastMode      = 0xFF;
+static float     s_lastPressure  = NAN;
+
+static bool      s_jumpOpen      = false;
+static uint32_t  s_jumpT0Ms      = 0;
+static uint32_t  s_jumpId        = 0;
+
+// Foto del segundo anterior para la línea [HZ]
+static uint32_t  s_prevConv[3]   = { 0, 0, 0 };
+static uint32_t  s_prevFail[3]   = { 0, 0, 0 };
+static uint32_t  s_prevDup[3]    = { 0, 0, 0 };
+static uint32_t  s_prevMiss[3]   = { 0, 0, 0 };
+
+static inline void ensureInit() {
+  if (s_init) return;
+  for (uint8_t m = 0; m < 3; ++m) { s_total[m].reset(); s_jump[m].reset(); }
+  s_init = true;
+}
+
+void sampleStatsSetTarget(uint8_t mode, uint32_t target_ms) {
+  if (mode > 2) return;
+  s_target_ms[mode] = target_ms;
+}
+
+void sampleStatsOnConversion(uint8_t mode, bool ok, float pressure_pa) {
+  if (mode > 2) return;
+  ensureInit();
+  const int64_t nowUs = esp_timer_get_time();
+
+  ModeStats* sets[2] = { &s_total[mode], s_jumpOpen ? &s_jump[mode] : nullptr };
+  for (ModeStats* st : sets) if (st) st->conv++;
+
+  if (!ok) {
+    for (ModeStats* st : sets) if (st) st->failed++;
+    return;
+  }
+
+  // Dato rancio: el BMP devuelve exactamente la misma presión
+  const bool dup = (pressure_pa == s_lastPressure);
+  s_lastPressure = pressure_pa;
+  if (dup) for (ModeStats* st : sets) if (st) st->dup++;
+
+  // Intervalos sólo dentro del mismo modo (el cambio de modo reconfigura OSR/ODR)
+  if (s_lastMode == mode && s_lastOkUs != 0) {
+    const uint32_t dtUs = (uint32_t)(nowUs - s_lastOkUs);
+    const uint32_t tgtUs = s_target_ms[mode] * 1000UL;
+    uint32_t miss = 0;
+    if (tgtUs > 0 && dtUs > (uint32_t)(SAMPLE_MISS_FACTOR * tgtUs)) {
+      miss = (dtUs + tgtUs / 2) / tgtUs - 1;   // redondeo al múltiplo más cercano
+    }
+    for (ModeStats* st : sets) {
+      if (!st) continue;
+      st->iv.add(dtUs);
+      st->missed += miss;
+    }
+  }
+  s_lastMode = mode;
+  s_lastOkUs = nowUs;
+}
+
+// ------------------------------
+// Salto
+// ------------------------------
+void sampleStatsJumpBegin() {
+  ensureInit();
+  for (auto &st : s_jump) st.reset();
+  s_jumpOpen = true;
+  s_jumpT0Ms = millis();
+  s_jumpId   = logbookGetActiveJumpId();
+}
+
+static void printModeLine(const char* tag, uint8_t m, const ModeStats& st) {
+  const uint32_t avgUs = st.iv.avg();
+  Serial.printf("%s %-6s obj=%lums real=%lu.%03lums conv=%lu fail=%lu dup=%lu miss=%lu\n",
+                tag, kModeNames[m], (unsigned long)s_target_ms[m],
+                (unsigned long)(avgUs / 1000), (unsigned long)(avgUs % 1000),
+                (unsigned long)st.conv, (unsigned long)st.failed,
+                (unsigned long)st.dup, (unsigned long)st.missed);
+}
+
+static void printJumpSummary() {
+  Serial.printf("[SAMP] salto #%lu (%lus)\n",
+                (unsigned long)s_jumpId,
+                (unsigned long)((millis() - s_jumpT0Ms) / 1000UL));
+  for (uint8_t m = 1; m < 3; ++m) {
+    printModeLine("[SAMP]", m, s_jump[m]);
+    s_jump[m].iv.print("[SAMP]", kModeNames[m]);
+  }
+}
+
+void sampleStatsJumpTick() {
+  if (!s_jumpOpen || logbookIsActive()) return;
+  printJumpSummary();                  // la bitácora se cerró
+  s_jumpOpen = false;
+}
+
+// ------------------------------
+// Reporte en vivo (1 Hz)
+// ------------------------------
+void sampleStatsReportTick(uint8_t mode, uint32_t acceptedLastSecond) {
+  ensureInit();
+  if (mode > 2) mode = 0;
+
+  const ModeStats& st = s_total[mode];
+  const uint32_t tgt  = s_target_ms[mode];
+  const uint32_t objMilliHz = tgt ? (1000000UL / tgt) : 0;
+  Serial.printf("[HZ] modo=%d  Hz=%lu obj=%lu.%lu conv=%lu fail=%lu dup=%lu miss=%lu\n",
+                (int)mode, (unsigned long)acceptedLastSecond,
+                (unsigned long)(objMilliHz / 1000), (unsigned long)((objMilliHz % 1000) / 100),
+                (unsigned long)(st.conv   - s_prevConv[mode]),
+                (unsigned long)(st.failed - s_prevFail[mode]),
+                (unsigned long)(st.dup    - s_prevDup[mode]),
+                (unsigned long)(st.missed - s_prevMiss[mode]));
+  for (uint8_t m = 0; m < 3; ++m) {
+    s_prevConv[m] = s_total[m].conv;
+    s_prevFail[m] = s_total[m].failed;
+    s_prevDup[m]  = s_total[m].dup;
+    s_prevMiss[m] = s_total[m].missed;
+  }
+}
+
+void sampleStatsDump() {
+  ensureInit();
+  for (uint8_t m = 0; m < 3; ++m) {
+    printModeLine("[SAMP]", m, s_total[m]);
+    s_total[m].iv.print("[SAMP]", kModeNames[m]);
+  }
+}
+
+void sampleStatsReset() {
+  for (uint8_t m = 0; m < 3; ++m) {
+    s_total[m].reset();
+    s_prevConv[m] = s_prevFail[m] = s_prevDup[m] = s_prevMiss[m] = 0;
+  }
+  s_init = true;
+  Serial.println("[SAMP] reset");
+}
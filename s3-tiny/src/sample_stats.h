@@ -0,0 +1,36 @@
+#ifndef SAMPLE_STATS_H
+#define SAMPLE_STATS_H
+
+// =====================================================
+// Calidad de muestreo del BMP390 (objetivo vs real)
+// -----------------------------------------------------
+// - Conversiones reales por modo frente al objetivo del
+//   estrangulador de main.cpp (SENSOR_TICK_*_MS).
+// - Histograma log2 de intervalos entre conversiones (us).
+// - Lecturas perdidas, duplicadas (presión idéntica) y fallidas.
+// En vivo: línea [HZ] cada 1 s; 's' histogramas, 'S' reset.
+// Por salto: resumen [SAMP] al cerrar la bitácora (también
+// en release: no depende de DEBUG_HZ).
+// =====================================================
+
+#include <Arduino.h>
+
+// Intervalo objetivo (ms) del modo; lo fija tickSensor()
+void sampleStatsSetTarget(uint8_t mode, uint32_t target_ms);
+
+// Tras cada bmp.performReading() real (ok=false si falló)
+void sampleStatsOnConversion(uint8_t mode, bool ok, float pressure_pa);
+
+// Apertura de salto (confirmación de FF)
+void sampleStatsJumpBegin();
+
+// Cada loop: fin de salto (bitácora cerrada) => resumen [SAMP]
+void sampleStatsJumpTick();
+
+// 1 Hz (DEBUG_HZ): línea [HZ] con muestras aceptadas
+void sampleStatsReportTick(uint8_t mode, uint32_t acceptedLastSecond);
+
+void sampleStatsDump();
+void sampleStatsReset();
+
+#endif // SAMPLE_STATS_H
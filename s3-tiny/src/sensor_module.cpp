@@ -8,6 +8,14 @@
 #include "logbook.h"             // Integración de bitácora
 #include "nvs.h"
 #include "nvs_flash.h"
+#include "profiler.h"
+#include "sample_stats.h"
+#include "loop_watchdog.h"
+#include "hil_link.h"
+#include <esp_timer.h>
+#include "alt_history.h"
+#include "climb_eco.h"
+#include "bmp390_regs.h"
 
 
 // ------------------------------
@@ -29,6 +37,11 @@
   #define ALT_SIM_PERIOD_MS 40000UL
 #endif
 
+// ALT_SIM 4: subida real de avión para medir consumo ('g'/'c')
+#ifndef ALT_SIM_CLIMB_FPM
+  #define ALT_SIM_CLIMB_FPM 1000.0f
+#endif
+
 // ------------------------------
 // Histéresis de modos (para evitar flapping)
 // ------------------------------
@@ -85,6 +98,25 @@ extern bool calibracionRealizada;
 extern float alturaOffset;
 extern void onSampleAccepted();   // definida en main.cpp
 
+// ------------------------------
+// Publicación de muestra (HUD por evento)
+// ------------------------------
+static volatile uint32_t s_sampleSeq = 0;
+static int64_t           s_sampleUs  = 0;
+static int64_t           s_convT0Us  = 0;   // inicio de la conversión en curso
+static float             s_vz        = 0.0f;
+
+// t_us = punto medio de la conversión (HIL/simulación: ahora)
+static inline void publishSample(int64_t tMeasUs = 0) {
+  s_sampleUs = tMeasUs ? tMeasUs : esp_timer_get_time();
+  s_sampleSeq++;
+  altHistoryAdd(altCalculada, millis());
+}
+
+uint32_t sensorSampleSeq()    { return s_sampleSeq; }
+int64_t  sensorSampleTimeUs() { return s_sampleUs; }
+float    sensorGetVz()        { return s_vz; }
+
 // ------------------------------
 // Objeto para el sensor BMP390 y variables de altitud
 // ------------------------------
@@ -118,11 +150,29 @@ static inline float alphaFor(SensorMode m) {
   }
 }
 
-// Velocidad de I2C según modo (ahorro=100 kHz, vuelo=400 kHz)
-static inline void setI2cForMode(SensorMode m) {
-  Wire.setClock(m == SENSOR_MODE_AHORRO ? 100000 : 400000);
+// Conversión FORCED prevista con el OSR de cada modo (ver cambios de modo)
+static inline uint32_t forcedConvUs(SensorMode m) {
+  switch (m) {
+    case SENSOR_MODE_FREEFALL:      return BMP390_CONV_US(1, 0);   // P x2 / T x1: ~6.8 ms
+    case SENSOR_MODE_ULTRA_PRECISO: return BMP390_CONV_US(4, 4);   // P x16 / T x16: ~65 ms
+    case SENSOR_MODE_AHORRO:
+    default:                        return BMP390_CONV_US(5, 3);   // P x32 / T x8: ~82 ms
+  }
+}
+
+bool sensorForcedReading() {
+  const int64_t t0 = esp_timer_get_time();
+  const bool ok = bmp.performReading();
+  lwdExcuse((uint32_t)min(esp_timer_get_time() - t0, (int64_t)forcedConvUs(currentMode)));
+  return ok;
+}
+
+float sensorPressureToAltitude(double pressure_pa) {
+  const double atm_hpa = pressure_pa / 100.0;
+  return (float)(44330.0 * (1.0 - pow(atm_hpa / 1013.25, 0.1903)));
 }
 
+// Reloj I2C por modo: lo aplica el gobernador (power_governor.cpp)
 
 // ====================================================
 // Helpers: Vario y Freefall por VZ
@@ -135,12 +185,14 @@ static void updateVarioAndFreefall(float altRel_m, float dt_s) {
     s_altFiltInit = true;
   } else {
     s_prevAltFilt = s_altFilt;
-    s_altFilt += alphaFor(currentMode) * (altRel_m - s_altFilt);
+    const float a = climbEcoActive() ? CLIMB_ECO_ALPHA : alphaFor(currentMode);
+    s_altFilt += a * (altRel_m - s_altFilt);
   }
 
   // 2) Velocidad vertical (m/s)
   float vz = 0.0f;
   if (dt_s > MIN_DT_S) vz = (s_altFilt - s_prevAltFilt) / dt_s;
+  s_vz = vz;
 
   // 3) Altura mínima opcional para habilitar FF por VZ
   const float agl_ft = altRel_m * 3.281f;
@@ -185,17 +237,17 @@ void initSensor() {
     Serial.println("¡Sensor BMP390L no encontrado!");
     while (1) { delay(10); }
   }
+  climbEcoBegin();
 
   // Configuración inicial por defecto (arranque en Ahorro)
   bmp.setTemperatureOversampling(BMP3_OVERSAMPLING_8X);
   bmp.setPressureOversampling(BMP3_OVERSAMPLING_32X);
   bmp.setIIRFilterCoeff(BMP3_IIR_FILTER_COEFF_15);
   bmp.setOutputDataRate(BMP3_ODR_25_HZ);
-  setI2cForMode(SENSOR_MODE_AHORRO);
 
   // Lectura inicial para fijar la altitud de referencia
   if (bmp.performReading()) {
-    altitudReferencia = bmp.readAltitude(1013.25);
+    altitudReferencia = sensorPressureToAltitude(bmp.pressure);
   }
 
   // (Opcional) Log informativo: total de saltos (lifetime) desde logbook
@@ -240,15 +292,42 @@ void updateSensorData() {
   bool sampleCounted = false;
 
   if (debeLeer) {
-    const bool sensorOk = bmp.performReading();
+    int64_t tMeasUs = 0;
+    bool sensorOk;
+    if (hilActive()) {
+      // HIL: la muestra del host sustituye a la conversión I2C
+      float refPa;
+      if (hilTakeReference(refPa)) {
+        altitudReferencia = sensorPressureToAltitude(refPa);
+        agzBias = 0.0f;
+      }
+      sensorOk = hilTakeSample(bmp.pressure, bmp.temperature);
+      if (!sensorOk) return;        // sin muestra nueva: nada que procesar
+    } else if (climbEcoActive()) {
+      // Subida económica: el BMP convierte solo (NORMAL), se lee sin esperar
+      const int8_t r = climbEcoRead(bmp.pressure, bmp.temperature, tMeasUs);
+      if (r == 0) return;           // aún sin DRDY
+      sensorOk = (r > 0);
+    } else {
+      s_convT0Us = esp_timer_get_time();
+      sensorOk = bmp.performReading();
+      const int64_t convUs = esp_timer_get_time() - s_convT0Us;
+      // Instante de la medida: mitad de la conversión FORCED
+      tMeasUs = s_convT0Us + convUs / 2;
+      s_convT0Us = 0;
+      // La espera de la conversión es la prevista: el watchdog sólo ve el exceso
+      lwdExcuse((uint32_t)min(convUs, (int64_t)forcedConvUs(currentMode)));
+    }
+    sampleStatsOnConversion((uint8_t)currentMode, sensorOk, (float)bmp.pressure);
     if (sensorOk) {
       readFails = 0;
-      const float altActual = bmp.readAltitude(1013.25);
+      const float altActual = sensorPressureToAltitude(bmp.pressure);
       altitud       = altActual;                                       // absoluto (m)
       // ===== Integración AGZ: sumar sesgo al cálculo relativo =====
       altCalculada  = altActual - altitudReferencia + alturaOffset + agzBias;    // relativa (m)
 
       onSampleAccepted();
+      publishSample(tMeasUs);
       sampleCounted = true;
       s_lastVarioMs = nowMs;
     } else {
@@ -268,7 +347,7 @@ void updateSensorData() {
     const float simAltM = ALT_SIM_FT / 3.281f;
     altitud      = simAltM;
     altCalculada = simAltM;
-    if (!sampleCounted) { onSampleAccepted(); sampleCounted = true; }
+    if (!sampleCounted) { onSampleAccepted(); publishSample(); sampleCounted = true; }
     s_lastVarioMs = nowMs;
   }
 #elif (ALT_SIM == 2)
@@ -294,7 +373,7 @@ void updateSensorData() {
     const float simAltM = kDemo[stage].feet / 3.281f;
     altitud      = simAltM;
     altCalculada = simAltM;
-    if (!sampleCounted) { onSampleAccepted(); sampleCounted = true; }
+    if (!sampleCounted) { onSampleAccepted(); publishSample(); sampleCounted = true; }
     s_lastVarioMs = nowMs;
   }
 #elif (ALT_SIM == 3)
@@ -393,16 +472,50 @@ void updateSensorData() {
   altCalculada = simAltM;   // relativo (m)
 
   onSampleAccepted();
+  publishSample();
   sampleCounted = true;
   s_lastVarioMs = nowMs;
 }
+#elif (ALT_SIM == 4)
+{
+  // Tierra 30 s, subida a ALT_SIM_CLIMB_FPM hasta ALT_SIM_MAX_FT, 30 s
+  // nivelado, caída a ~54 m/s hasta 4000 ft, campana a ~5 m/s y tierra.
+  // Sobre muestras reales: en la subida económica sigue el ritmo del BMP
+  static uint32_t t0 = 0;
+  if (t0 == 0) t0 = nowMs;
+
+  const float    GROUND_S  = 30.0f, LEVEL_S = 30.0f;
+  const float    FF_FTPS   = 176.0f, CANOPY_FTPS = 16.0f, OPEN_FT = 4000.0f;
+  const float    climbS    = ALT_SIM_MAX_FT / (ALT_SIM_CLIMB_FPM / 60.0f);
+  const float    ffS       = (ALT_SIM_MAX_FT - OPEN_FT) / FF_FTPS;
+  const float    canopyS   = OPEN_FT / CANOPY_FTPS;
+  const float    cycleS    = 2.0f * GROUND_S + climbS + LEVEL_S + ffS + canopyS;
+
+  float t = fmodf((nowMs - t0) / 1000.0f, cycleS);
+  float ft;
+  if ((t -= GROUND_S) < 0.0f)     ft = 0.0f;
+  else if ((t -= climbS) < 0.0f)  ft = ALT_SIM_MAX_FT + t * (ALT_SIM_CLIMB_FPM / 60.0f);
+  else if ((t -= LEVEL_S) < 0.0f) ft = ALT_SIM_MAX_FT;
+  else if ((t -= ffS) < 0.0f)     ft = OPEN_FT - t * FF_FTPS;
+  else if ((t -= canopyS) < 0.0f) ft = -t * CANOPY_FTPS;
+  else                            ft = 0.0f;
+
+  const float simAltM = ft / 3.281f;
+  altitud      = simAltM;
+  altCalculada = simAltM;
+  if (!sampleCounted) { onSampleAccepted(); publishSample(); sampleCounted = true; }
+  s_lastVarioMs = nowMs;
+}
 #endif
 
   // 2) Vario + estado FF por VZ
   updateVarioAndFreefall(altCalculada, dt_s);
 
   // Tick de bitácora (mide tiempos y estados internos del salto)
-  logbookTick(altCalculada, currentMode);
+  {
+    PROF_SCOPE(PROF_LOGBOOK_TICK);
+    logbookTick(altCalculada, currentMode);
+  }
 
   // Convertir altitud relativa a pies (para cambio Ahorro/Ultra)
   const float altEnPies = altCalculada * 3.281f;
@@ -419,7 +532,6 @@ void updateSensorData() {
       bmp.setPressureOversampling(BMP3_OVERSAMPLING_16X); // (ajusta si tu lib usa otro literal)
       bmp.setIIRFilterCoeff(BMP3_IIR_FILTER_COEFF_7);
       bmp.setOutputDataRate(BMP3_ODR_50_HZ);
-      setI2cForMode(SENSOR_MODE_ULTRA_PRECISO);
       Serial.println("Modo Ultra Preciso activado (↑ desde Ahorro)");
 
       powerLockClear();   // libera lock al cruzar 60 ft
@@ -439,7 +551,6 @@ void updateSensorData() {
       bmp.setTemperatureOversampling(BMP3_NO_OVERSAMPLING);
       bmp.setPressureOversampling(BMP3_OVERSAMPLING_2X);
       bmp.setIIRFilterCoeff(BMP3_IIR_FILTER_DISABLE);
-      setI2cForMode(SENSOR_MODE_FREEFALL);
       // ODR se mantiene en 50 Hz (Adafruit). Si migras a Bosch API: 200 Hz en FF.
       Serial.println("Modo Freefall activado (por velocidad vertical)");
       jumpArmed = true;
@@ -452,7 +563,6 @@ void updateSensorData() {
       bmp.setPressureOversampling(BMP3_OVERSAMPLING_32X);
       bmp.setIIRFilterCoeff(BMP3_IIR_FILTER_COEFF_15);
       bmp.setOutputDataRate(BMP3_ODR_25_HZ);
-      setI2cForMode(SENSOR_MODE_AHORRO);
       Serial.println("Modo Ahorro activado (↓ desde Ultra)");
       lastForcedReadingTime = millis();
 
@@ -476,7 +586,6 @@ void updateSensorData() {
       bmp.setPressureOversampling(BMP3_OVERSAMPLING_16X);
       bmp.setIIRFilterCoeff(BMP3_IIR_FILTER_COEFF_7);
       bmp.setOutputDataRate(BMP3_ODR_50_HZ);
-      setI2cForMode(SENSOR_MODE_ULTRA_PRECISO);
       Serial.println("Modo Ultra Preciso activado (salida de Freefall por VZ)");
 
       jumpArmed = true;
@@ -488,6 +597,9 @@ void updateSensorData() {
     }
   }
 
+  // 3.b) Subida económica (sólo en Ultra, sin salto abierto ni HIL)
+  climbEcoUpdate(currentMode, altEnPies, s_vz, logbookIsActive() || hilActive());
+
   // 4) Señales para UI + transición de salto (flanco + confirmación)
   const bool nowFreefall = (currentMode == SENSOR_MODE_FREEFALL);
 
@@ -506,15 +618,18 @@ void updateSensorData() {
 
     // Failsafe: si quedó algo abierto, ciérralo antes de iniciar uno nuevo
     if (logbookIsActive()) {
+      LWD_SECTION("lb_final");
       logbookFinalizeIfOpen();
     }
 
     // Iniciar log al confirmar FF (no en el primer toque)
+    LWD_SECTION("ff_open");   // apertura + instrumentación NVS + printf
     // --- INSTRUMENTACIÓN NVS (OPEN) ---
     nvs_stats_t st_open_before;
     nvs_get_stats(NULL, &st_open_before);
 
     logbookBeginFreefall(altCalculada);  // << se abre el registro de salto
+    sampleStatsJumpBegin();
 
     nvs_stats_t st_open_after;
     nvs_get_stats(NULL, &st_open_after);
@@ -546,6 +661,7 @@ void updateSensorData() {
     if (groundSinceMs == 0) groundSinceMs = millis();
     if (logbookIsActive()) {
       if (millis() - groundSinceMs >= 100UL) {   // antes: 1000UL
+        LWD_SECTION("lb_final");
         logbookFinalizeIfOpen();
         groundSinceMs = 0;
       }
@@ -567,6 +683,7 @@ void updateSensorData() {
     if (logbookIsActive() && groundLike) {
       if (s_groundStableMs == 0) s_groundStableMs = millis();
       if (millis() - s_groundStableMs >= GROUND_STABLE_MS) {
+        LWD_SECTION("lb_final");
         logbookFinalizeIfOpen();          // cierre robusto adicional
         s_groundStableMs = 0;
       }
@@ -585,6 +702,7 @@ void updateSensorData() {
       if (!s_freefallByVZ) {
         if (s_postDeployMs == 0) s_postDeployMs = millis();
         if (lowAltFt && (millis() - s_postDeployMs >= POSTDEPLOY_WATCHDOG_MS)) {
+          LWD_SECTION("lb_final");
           logbookFinalizeIfOpen();
           s_postDeployMs = 0;
         }
@@ -640,7 +758,7 @@ void updateSensorData() {
         // Guardado poco frecuente (delta grande o periodo)
         if (fabsf(agzBias - s_lastSavedBias) >= AGZ_SAVE_DELTA_M ||
             (millis() - s_agzLastSaveMs) >= AGZ_SAVE_PERIOD_MS) {
-          saveAgzBias();
+          { LWD_SECTION("agz_save"); saveAgzBias(); }
           s_lastSavedBias = agzBias;
           s_agzLastSaveMs = millis();
           // (Opcional) Serial.printf("[AGZ] saved bias=%.2f m\n", agzBias);
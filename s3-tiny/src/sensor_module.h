@@ -38,4 +38,20 @@ extern bool     inJump;          // freefall confirmado (relleno)
 void initSensor();
 void updateSensorData();
 
+// bmp.performReading() fuera de updateSensorData() (calibración, lock):
+// la espera prevista de la conversión no cuenta para el watchdog del loop
+bool sensorForcedReading();
+
+// Publicación de muestras para la UI: seq crece con cada muestra
+// aceptada; t_us = esp_timer en el punto medio de la conversión
+uint32_t sensorSampleSeq();
+int64_t  sensorSampleTimeUs();
+
+// Velocidad vertical filtrada (m/s, negativa bajando)
+float    sensorGetVz();
+
+// Presión (Pa) -> altitud (m) con la misma fórmula que Adafruit (QNH 1013.25),
+// pero sin disparar otra conversión como hace bmp.readAltitude()
+float sensorPressureToAltitude(double pressure_pa);
+
 #endif // SENSOR_MODULE_H
\ No newline at end of file
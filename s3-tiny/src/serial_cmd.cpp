@@ -0,0 +1,60 @@
+#include "serial_cmd.h"
+#include <Arduino.h>
+#include "profiler.h"
+#include "sample_stats.h"
+#include "loop_watchdog.h"
+#include "hil_link.h"
+#include "lcd_flush.h"
+#include "heap_probe.h"
+#include "power_governor.h"
+#include "loop_sched.h"
+#include "ulp_climb.h"
+#include "wake_stub.h"
+#include "warm_boot.h"
+#include "adc_dma.h"
+#include "climb_eco.h"
+#include "display_power.h"
+#include "ds_housekeeping.h"
+
+static void printHelp() {
+  Serial.println("[CMD] p=perfil  P=reset perfil  s=muestreo  S=reset muestreo  w=watchdog  W=borrar watchdog  l=lcd  L=reset lcd  h=heap  H=reset heap  g=energia  G=reset energia  d=plazos  D=reset plazos  u=ulp  k=stub  K=reset stub  r=arranque  R=reset arranque  a=adc  c=subida  C=reset subida  v=pantalla  x=mantenimiento  X=reset mantenimiento  ?=ayuda");
+}
+
+void serialCmdTick() {
+  // Sólo lo ya recibido: nunca esperamos al host
+  int avail = Serial.available();
+  while (avail-- > 0) {
+    const int c = Serial.read();
+    if (c < 0) break;
+    if (hilFeedByte((uint8_t)c)) continue;   // byte de trama HIL binaria
+    switch (c) {
+      case 'p': profDump();  break;
+      case 'P': profReset(); break;
+      case 's': sampleStatsDump();  break;
+      case 'S': sampleStatsReset(); break;
+      case 'w': lwdDump();  break;
+      case 'W': lwdClear(); break;
+      case 'l': lcdFlushDump();  break;
+      case 'L': lcdFlushReset(); break;
+      case 'h': heapProbeDump();  break;
+      case 'H': heapProbeReset(); break;
+      case 'g': powerGovDump();  break;
+      case 'G': powerGovReset(); break;
+      case 'd': schedDump();  break;
+      case 'D': schedReset(); break;
+      case 'u': ulpClimbDump(); break;
+      case 'k': wakeStubDump();  break;
+      case 'K': wakeStubReset(); break;
+      case 'r': warmBootDump();  break;
+      case 'R': warmBootResetStats(); break;
+      case 'a': adcDmaDump(); break;
+      case 'c': climbEcoDump();  break;
+      case 'C': climbEcoReset(); break;
+      case 'v': displayPowerDump(); break;
+      case 'x': dsHousekeepingDump();  break;
+      case 'X': dsHousekeepingReset(); break;
+      case '?': printHelp(); break;
+      default: break;      // ignora \r, \n y basura
+    }
+  }
+}
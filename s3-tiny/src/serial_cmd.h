@@ -0,0 +1,11 @@
+#ifndef SERIAL_CMD_H
+#define SERIAL_CMD_H
+
+// =====================================================
+// Comandos de depuración por Serial (USB-CDC)
+// Un carácter por comando; '?' lista los disponibles.
+// =====================================================
+
+void serialCmdTick();   // llamar en loop(); no bloquea
+
+#endif // SERIAL_CMD_H
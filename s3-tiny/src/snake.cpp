@@ -7,12 +7,12 @@
 #include "config.h"
 #include "ui_module.h"
 #include "snake.h"          // Direction, Point, GRID_*, CELL_SIZE, MAX_SNAKE_LENGTH
+#include "lcd_flush.h"
 
 // Flag global para saber si el juego está activo
 extern bool gameSnakeRunning;
 
-// u8g2 viene del módulo de UI
-extern U8G2_ST7567_JLX12864_F_4W_SW_SPI u8g2;
+// u8g2 viene del módulo de UI (ui_module.h)
 
 static Point     snake[MAX_SNAKE_LENGTH];
 static int       snakeLength;
@@ -85,7 +85,7 @@ static void drawSnakeGame() {
   u8g2.print("Score: ");
   u8g2.print(score);
 
-  u8g2.sendBuffer();
+  lcdFlush();
 }
 
 void playSnakeGame() {
@@ -149,7 +149,7 @@ void playSnakeGame() {
   // ===== Salida con tap en OK (no bloqueante) =====
   if (okRise && !s_showingGameOver) {
   u8g2.clearBuffer();           // blanquea frame del juego
-  u8g2.sendBuffer();
+  lcdFlush();
   uiRequestRefresh();           // <<< fuerza repintado de la UI
   initialized = false;
   gameSnakeRunning = false;
@@ -171,11 +171,11 @@ void playSnakeGame() {
     u8g2.setCursor(0, 60);
     u8g2.print("Score: ");
     u8g2.print(score);
-    u8g2.sendBuffer();
+    lcdFlush();
 
     if (now >= s_gameOverUntilMs || okRise) {
       u8g2.clearBuffer();
-      u8g2.sendBuffer();
+      lcdFlush();
       uiRequestRefresh();           // <<< idem
       initialized = false;
       gameSnakeRunning = false;
@@ -0,0 +1,50 @@
+#include "ui_layer_cache.h"
+#include <string.h>
+
+// ------------------------------
+// Estado (RAM fija: UI_LAYER_SLOTS x 1 KB)
+// ------------------------------
+static constexpr uint16_t UI_LAYER_LEN = 128 * 64 / 8;
+
+struct UiLayerSlot {
+  uint32_t key;
+  bool     valid;
+  uint8_t  buf[UI_LAYER_LEN];
+};
+
+static UiLayerSlot s_slot[UI_LAYER_SLOTS];
+static uint8_t     s_next = 0;           // reemplazo round-robin
+
+static inline uint16_t bufLen(U8G2 &u8g2) {
+  const uint16_t n = (uint16_t)u8g2.getBufferTileWidth() * u8g2.getBufferTileHeight() * 8;
+  return (n <= UI_LAYER_LEN) ? n : 0;
+}
+
+bool uiLayerBegin(U8G2 &u8g2, uint32_t key) {
+  const uint16_t n = bufLen(u8g2);
+  if (n) {
+    for (auto &s : s_slot) {
+      if (s.valid && s.key == key) {
+        memcpy(u8g2.getBufferPtr(), s.buf, n);
+        return true;
+      }
+    }
+  }
+  u8g2.clearBuffer();
+  return false;
+}
+
+void uiLayerSave(U8G2 &u8g2, uint32_t key) {
+  const uint16_t n = bufLen(u8g2);
+  if (!n) return;
+  UiLayerSlot* dst = nullptr;
+  for (auto &s : s_slot) if (s.valid && s.key == key) { dst = &s; break; }
+  if (!dst) { dst = &s_slot[s_next]; s_next = (uint8_t)((s_next + 1) % UI_LAYER_SLOTS); }
+  memcpy(dst->buf, u8g2.getBufferPtr(), n);
+  dst->key   = key;
+  dst->valid = true;
+}
+
+void uiLayerInvalidate() {
+  for (auto &s : s_slot) s.valid = false;
+}
@@ -0,0 +1,37 @@
+#ifndef UI_LAYER_CACHE_H
+#define UI_LAYER_CACHE_H
+
+// =====================================================
+// Capa estática de pantallas (menú, bitácora)
+// -----------------------------------------------------
+// Guarda un frame de u8g2 (1 KB) con lo que no cambia entre
+// frames: marco, cabeceras, etiquetas. Cada frame:
+//   if (!uiLayerBegin(u8g2, key)) { ...estático...; uiLayerSave(u8g2, key); }
+//   ...campos dinámicos...
+// uiLayerBegin() con la clave en caché copia la capa al buffer
+// (memcpy de 1 KB en vez de clearBuffer + render de texto); si
+// no está, limpia el buffer y devuelve false.
+// La clave debe incluir todo lo que cambia la capa (pantalla,
+// idioma, página...): al cambiar, la capa se regenera sola.
+// =====================================================
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+#ifndef UI_LAYER_SLOTS
+  #define UI_LAYER_SLOTS 2
+#endif
+
+enum UiLayerId : uint8_t {
+  UI_LAYER_MENU = 1,
+  UI_LAYER_LOGBOOK,
+};
+
+#define UI_LAYER_KEY(id, a, b) \
+  (((uint32_t)(id) << 24) | ((uint32_t)((a) & 0xFF) << 16) | (uint32_t)((b) & 0xFFFF))
+
+bool uiLayerBegin(U8G2 &u8g2, uint32_t key);
+void uiLayerSave(U8G2 &u8g2, uint32_t key);
+void uiLayerInvalidate();
+
+#endif // UI_LAYER_CACHE_H
@@ -1,7 +1,7 @@
 #include "ui_module.h"
 #include "config.h"
 #include <Arduino.h>
-#include <driver/ledc.h>
+#include <esp_timer.h>
 #include <U8g2lib.h>
 #include "sensor_module.h"
 #include <math.h>
@@ -10,9 +10,21 @@
 #include "battery.h"
 #include "datetime_module.h"
 #include "logbookUi.h"
+#include "altHistoryUi.h"
+#include "ui_layer_cache.h"
 #include "logbook.h"
 #include "charge_detect.h"
 #include "alarm.h"
+#include "hil_link.h"
+#include "warm_boot.h"
+#include "lcd_flush.h"
+#include "ui_strings.h"
+#include "heap_probe.h"
+#include "alt_glyph_cache.h"
+#include "profiler.h"
+#include "power_governor.h"
+#include "display_power.h"
+#include "loop_sched.h"
 
 // ===== Radios/BT (Arduino-ESP32) =====
 #if defined(ARDUINO_ARCH_ESP32)
@@ -66,15 +78,42 @@
 #define UI_SLOW_BLINK_MS      2000UL      // Blink lento en Ahorro
 #endif
 
-// ===== Escalado de CPU =====
-#ifndef CPU_FREQ_AHORRO_MHZ
-#define CPU_FREQ_AHORRO_MHZ   40
+// ===== HUD por evento (ULTRA/FF) =====
+// Intervalo mínimo entre frames (tope de FPS) y sondeo de lo que no
+// depende de la muestra (reloj, batería, parpadeos)
+#ifndef UI_HUD_MIN_FRAME_AHORRO_MS
+#define UI_HUD_MIN_FRAME_AHORRO_MS 140UL
 #endif
-#ifndef CPU_FREQ_ACTIVO_MHZ
-#define CPU_FREQ_ACTIVO_MHZ   160
+#ifndef UI_HUD_MIN_FRAME_ULTRA_MS
+#define UI_HUD_MIN_FRAME_ULTRA_MS  100UL   // 10 fps
 #endif
-#ifndef CPU_FREQ_RAPIDO_MHZ
-#define CPU_FREQ_RAPIDO_MHZ   160
+#ifndef UI_HUD_MIN_FRAME_FF_MS
+#define UI_HUD_MIN_FRAME_FF_MS      50UL   // 20 fps
+#endif
+#ifndef UI_INTERACTIVE_POLL_MS
+#define UI_INTERACTIVE_POLL_MS      20UL   // menús/juego/cuenta atrás (loop_sched)
+#endif
+#ifndef UI_HUD_POLL_MS
+#define UI_HUD_POLL_MS             250UL
+#endif
+
+// ===== Compensación de latencia (lead) de la altitud mostrada =====
+// alt + vz * (medida -> LCD), con la latencia medida en cada frame.
+// Ganancia 0 en Ahorro y por debajo de VZ_LO (campana), 1 desde VZ_HI.
+#ifndef UI_LEAD_COMP
+#define UI_LEAD_COMP               1
+#endif
+#ifndef UI_LEAD_MAX_M
+#define UI_LEAD_MAX_M              40.0f   // tope de la proyección
+#endif
+#ifndef UI_LEAD_MAX_LAT_MS
+#define UI_LEAD_MAX_LAT_MS         600UL   // dato más viejo: no proyectar
+#endif
+#ifndef UI_LEAD_VZ_LO_MPS
+#define UI_LEAD_VZ_LO_MPS          12.0f
+#endif
+#ifndef UI_LEAD_VZ_HI_MPS
+#define UI_LEAD_VZ_HI_MPS          25.0f
 #endif
 
 // ===== Placa: WS2812 DIN (pinout) =====
@@ -83,10 +122,8 @@
 #endif
 
 // ===== Idioma =====
+// Textos en ui_strings.h: tr(STR_x), sin heap
 extern int idioma; // LANG_ES / LANG_EN
-static String T(const char* es, const char* en) {
-  return (idioma == LANG_ES) ? String(es) : String(en);
-}
 
 // --- Helper: normalizar altFormat para que solo existan 0 (normal) o 4 (AUTO)
 static inline int normalizeAltFormat(int v) { return (v == 4) ? 4 : 0; }
@@ -107,10 +144,13 @@ static Btn BTN_OK  (BUTTON_OLED);
 static Btn BTN_MENU(BUTTON_MENU);
 
 // --- Contador de repintados ---
+// R:<n> <bytes>B <us>u del frame anterior (lcd_flush)
 static uint32_t g_uiRepaintCounter = 0;
 static inline void uiStampRepaintCounter() {
-  char cbuf[16];
-  snprintf(cbuf, sizeof(cbuf), "R:%lu", (unsigned long)g_uiRepaintCounter);
+  char cbuf[28];
+  const LcdFlushStats fs = lcdFlushStats();
+  snprintf(cbuf, sizeof(cbuf), "R:%lu %uB %luu", (unsigned long)g_uiRepaintCounter,
+           (unsigned)fs.lastBytes, (unsigned long)fs.lastUs);
   u8g2.setFont(u8g2_font_micro_tr);
   u8g2.setCursor(1, 8);
   u8g2.print(cbuf);
@@ -134,6 +174,7 @@ static inline void btnTick(Btn& b) {
     b.tDown    = millis();
     b.tNextRpt = 0;
     uiForceRefresh = true; // fast-path
+    lcdFlushMarkInput();   // latencia botón -> frame ('l')
   }
 }
 static inline bool btnRise(const Btn& b) { return b.down && !b.prev; }
@@ -150,50 +191,13 @@ static inline bool btnLong(const Btn& b, uint32_t longMs=600) {
 }
 
 // ==== Display ====
-U8G2_ST7567_JLX12864_F_4W_SW_SPI u8g2(
+#if LCD_USE_HW_SPI_DMA
+LcdU8g2 u8g2(U8G2_R2);   // pines en lcd_spi_dma.cpp (config.h)
+#else
+LcdU8g2 u8g2(
   U8G2_R2, LCD_SCK, LCD_MOSI, LCD_CS, LCD_DC, LCD_RST
 );
-static inline void backlightDuty(uint8_t duty) {
-  ledc_set_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)LCD_LEDC_CH, duty);
-  ledc_update_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)LCD_LEDC_CH);
-}
-
-// Backlight activo-bajo:
-//  - duty = 255  -> pin alto todo el periodo  -> BL APAGADO
-//  - duty pequeño -> más tiempo en bajo      -> BL más brillante
-static bool s_backlightEnabled = false;
-static inline uint8_t blDutyFromUser() {
-  int b = brilloPantalla; if (b < 0) b = 0; if (b > 255) b = 255;
-  return (uint8_t)(255 - b);   // invertir por activo-bajo
-}
-static inline void backlightOff() { backlightDuty(0); s_backlightEnabled = false; }
-static inline void backlightOnUser() { backlightDuty(blDutyFromUser()); s_backlightEnabled = true; }
-
-
-static void backlightInit() {
-   pinMode(LCD_LED, OUTPUT);
-   digitalWrite(LCD_LED, HIGH);
-
-  ledc_timer_config_t t = {
-    .speed_mode      = LEDC_LOW_SPEED_MODE,
-    .duty_resolution = (ledc_timer_bit_t)LCD_LEDC_RES_BITS,
-    .timer_num       = LEDC_TIMER_0,
-    .freq_hz         = LCD_LEDC_FREQ,
-    .clk_cfg         = LEDC_AUTO_CLK
-  };
-  ledc_timer_config(&t);
-  ledc_channel_config_t ch = {
-    .gpio_num   = (int)LCD_LED,
-    .speed_mode = LEDC_LOW_SPEED_MODE,
-    .channel    = (ledc_channel_t)LCD_LEDC_CH,
-    .intr_type  = LEDC_INTR_DISABLE,
-    .timer_sel  = LEDC_TIMER_0,
-    .duty       = 0,
-    .hpoint     = 0
-  };
-  ledc_channel_config(&ch);
-  backlightOff(); // asegurar BL apagado al iniciar (por activo-bajo)
-}
+#endif
 
 
 bool startupDone = false;
@@ -347,53 +351,24 @@ static void boardLowPowerInit() {
   pinMode(PIN_RGB_DIN, INPUT);
 }
 
-// ===== Escalado de CPU según modo + interacción =====
-static SensorMode s_lastCpuPolicy = (SensorMode)255;
-static void powerPolicyTick() {
-  SensorMode m = getSensorMode();
-  // “Interacción”: menú, edición, datetime, logbook o juego
-  bool interactive = menuActivo || editingOffset || logbookUiIsActive() || datetimeMenuActive() || gameSnakeRunning;
-
-  uint32_t targetMHz;
-  if (m == SENSOR_MODE_FREEFALL) {
-    targetMHz = CPU_FREQ_RAPIDO_MHZ;           // prioridad a FF
-  } else if (interactive) {
-    targetMHz = CPU_FREQ_ACTIVO_MHZ;           // UI fluida en tierra
-  } else if (m == SENSOR_MODE_AHORRO) {
-    targetMHz = CPU_FREQ_AHORRO_MHZ;
-  } else {
-    targetMHz = CPU_FREQ_ACTIVO_MHZ;
-  }
-
-  // Cambia solo si varía el modo (usamos m como “política” vigente)
-  static uint32_t s_curMHz = 0;
-  if (s_curMHz != targetMHz || m != s_lastCpuPolicy) {
-    setCpuFrequencyMhz(targetMHz);
-    s_curMHz = targetMHz;
-    s_lastCpuPolicy = m;
-  }
-}
-
 // ---------------------------------------------------------------------------
 void initUI() {
   altFormat = normalizeAltFormat(altFormat);
   u8g2.begin();
-  u8g2.setPowerSave(false);
-  u8g2.setContrast(150);
-  backlightInit();
-  backlightOff();
+  displayPowerBegin();    // contraste, LEDC con fades y BL apagado
+  lcdFlushInvalidate();   // RAM del LCD desconocida tras begin()
+  altGlyphCacheBuild(u8g2, u8g2_font_fub30_tr, 50);   // línea base del HUD
 
-  boardLowPowerInit();
-  powerPolicyTick();
+  boardLowPowerInit();   // CPU/I2C: powerGovBegin() en setup
 
-  Serial.println(T("Display iniciado.", "Display started."));
+  Serial.println(tr(STR_DISPLAY_STARTED));
 }
 
 // API pública para backlight
-void lcdBacklightOnUser() { backlightOnUser(); }
-void lcdBacklightOff()    { backlightOff(); }
-void lcdBacklightToggle() { if (s_backlightEnabled) backlightOff(); else backlightOnUser(); }
-bool lcdBacklightIsOn()   { return s_backlightEnabled; }
+void lcdBacklightOnUser() { displayPowerSetBacklight(true); }
+void lcdBacklightOff()    { displayPowerSetBacklight(false); }
+void lcdBacklightToggle() { displayPowerToggleBacklight(); }
+bool lcdBacklightIsOn()   { return displayPowerBacklightOn(); }
 
 
 // ---------------------------------------------------------------------------
@@ -411,29 +386,76 @@ void mostrarCuentaRegresiva() {
 
   u8g2.clearBuffer();
   u8g2.setFont(u8g2_font_fub30_tr);
-  String cuenta = String(secondsLeft);
-  int xPos = (128 - u8g2.getStrWidth(cuenta.c_str())) / 2; if (xPos < 0) xPos = 0;
+  char cuenta[4]; snprintf(cuenta, sizeof(cuenta), "%d", secondsLeft);
+  int xPos = (128 - u8g2.getStrWidth(cuenta)) / 2; if (xPos < 0) xPos = 0;
   u8g2.setCursor(xPos, 40); u8g2.print(cuenta);
 
   u8g2.setFont(u8g2_font_ncenB08_tr);
-  String ini = T("Iniciando...", "Starting...");
-  int w = u8g2.getStrWidth(ini.c_str()); int x = (128 - w) / 2; if (x < 0) x = 0;
+  const char* ini = tr(STR_STARTING);
+  int w = u8g2.getStrWidth(ini); int x = (128 - w) / 2; if (x < 0) x = 0;
   u8g2.setCursor(x, 60); u8g2.print(ini);
 
-  g_uiRepaintCounter++; uiStampRepaintCounter(); u8g2.sendBuffer();
+  g_uiRepaintCounter++; uiStampRepaintCounter(); lcdFlush();
   if (elapsed >= 3000) startupDone = true;
 }
 
 // ---------------------------------------------------------------------------
+// Menú en dos capas: etiquetas/cabecera/página en ui_layer_cache (por
+// página e idioma) y, por frame, sólo cursor, valores, fecha y voltaje.
+static const int MENU_LABEL_X = 10;   // ancho de "> " en ncenB08
+
+static const char* menuLabel(int i) {
+  switch (i) {
+    case 0:  return tr(STR_UNITS);
+    case 1:  return tr(STR_BRIGHTNESS);
+    case 2:  return tr(STR_ALT_FMT);
+    case 3:  return tr(STR_LOGBOOK);
+    case 4:  return tr(STR_DATETIME);
+    case 5:  return tr(STR_HISTORY);
+    case 6:  return tr(STR_POWER_SAVE);
+    case 7:  return "Offset: ";
+    case 8:  return "Snake";
+    case 9:  return tr(STR_LANGUAGE);
+    case 10: return tr(STR_EXIT_MENU);
+  }
+  return "";
+}
+
+static void menuPrintValue(int i) {
+  switch (i) {
+    case 0: u8g2.print(tr(unidadMetros ? STR_METERS : STR_FEET)); break;
+    case 1: u8g2.print(brilloPantalla); break;
+    case 2: u8g2.print(normalizeAltFormat(altFormat) == 4 ? "AUTO" : tr(STR_NORMAL)); break;
+    case 6: if (ahorroTimeoutMs == 0) u8g2.print("OFF"); else { u8g2.print(ahorroTimeoutMs / 60000); u8g2.print(tr(STR_MIN)); } break;
+    case 7:
+      if (unidadMetros) { u8g2.print(alturaOffset, 2); u8g2.print(" m"); }
+      else              { u8g2.print(alturaOffset * 3.281f, 0); u8g2.print(" ft"); }
+      break;
+    case 9: u8g2.print((idioma == LANG_ES) ? "ES" : "EN"); break;
+    default: break;
+  }
+}
+
 void dibujarMenu() {
   int paginaActual = menuOpcion / OPCIONES_POR_PAGINA;
   int totalPaginas = (TOTAL_OPCIONES + OPCIONES_POR_PAGINA - 1) / OPCIONES_POR_PAGINA;
   int inicio = paginaActual * OPCIONES_POR_PAGINA;
   int fin = inicio + OPCIONES_POR_PAGINA; if (fin > TOTAL_OPCIONES) fin = TOTAL_OPCIONES;
 
-  u8g2.clearBuffer();
   u8g2.setFont(u8g2_font_ncenB08_tr);
-  u8g2.setCursor(0, 12); u8g2.print(T("MENU:", "MENU:"));
+
+  // Capa estática
+  const uint32_t key = UI_LAYER_KEY(UI_LAYER_MENU, idioma, paginaActual);
+  if (!uiLayerBegin(u8g2, key)) {
+    u8g2.setCursor(0, 12); u8g2.print(tr(STR_MENU));
+    for (int i = inicio; i < fin; i++) {
+      const int y = 24 + (i - inicio) * 12;
+      u8g2.setCursor(MENU_LABEL_X, y); u8g2.print(menuLabel(i));
+    }
+    u8g2.setCursor(100, 63);
+    { char pg[8]; snprintf(pg, sizeof(pg), "%d/%d", paginaActual + 1, totalPaginas); u8g2.print(pg); }
+    uiLayerSave(u8g2, key);
+  }
 
   // Fecha (DD/MM/YY) — ya se actualiza 1s en bloque
   {
@@ -459,39 +481,22 @@ void dibujarMenu() {
     u8g2.setCursor(95, 24); u8g2.print(vbat, 2); u8g2.print("V");
   }
 
+  // Cursor y valores
   for (int i = inicio; i < fin; i++) {
-    int y = 24 + (i - inicio) * 12;
-    u8g2.setCursor(0, y);
-    u8g2.print(i == menuOpcion ? "> " : "  ");
-    switch(i) {
-      case 0: u8g2.print(T("Unidad: ", "Units: ")); u8g2.print(unidadMetros ? T("metros", "meters") : T("pies", "feet")); break;
-      case 1: u8g2.print(T("Brillo: ", "Brightness: ")); u8g2.print(brilloPantalla); break;
-      case 2: u8g2.print(T("Altura: ", "Altitude fmt: ")); u8g2.print(normalizeAltFormat(altFormat) == 4 ? "AUTO" : T("normal", "normal")); break;
-      case 3: u8g2.print(T("Bitacora", "Logbook")); break;
-      case 4: u8g2.print(T("Fecha/Hora", "Date/Time")); break;
-      case 5: u8g2.print(T("Empty: ", "Empty: ")); break;
-      case 6: u8g2.print(T("Ahorro: ", "Power save: ")); if (ahorroTimeoutMs == 0) u8g2.print("OFF"); else u8g2.print(String(ahorroTimeoutMs / 60000) + T(" min", " min")); break;
-      case 7:
-        u8g2.print("Offset: ");
-        if (unidadMetros) { u8g2.print(alturaOffset, 2); u8g2.print(" m"); }
-        else              { u8g2.print(alturaOffset * 3.281f, 0); u8g2.print(" ft"); }
-        break;
-      case 8: u8g2.print("Snake"); break;
-      case 9: u8g2.print(T("Idioma: ", "Language: ")); u8g2.print((idioma == LANG_ES) ? "ES" : "EN"); break;
-      case 10: u8g2.print(T("Salir del menú", "Exit menu")); break;
-    }
+    const int y = 24 + (i - inicio) * 12;
+    if (i == menuOpcion) { u8g2.setCursor(0, y); u8g2.print(">"); }
+    u8g2.setCursor(MENU_LABEL_X + u8g2.getStrWidth(menuLabel(i)), y);
+    menuPrintValue(i);
   }
 
-  u8g2.setCursor(100, 63);
-  u8g2.print(String(paginaActual + 1) + "/" + String(totalPaginas));
-  g_uiRepaintCounter++; uiStampRepaintCounter(); u8g2.sendBuffer();
+  g_uiRepaintCounter++; uiStampRepaintCounter(); lcdFlush();
 }
 
 // ---------------------------------------------------------------------------
 static void dibujarOffsetEdit() {
   u8g2.clearBuffer();
   u8g2.setFont(u8g2_font_ncenB08_tr);
-  u8g2.setCursor(5, 18); u8g2.print(T("Offset de altitud", "Altitude offset"));
+  u8g2.setCursor(5, 18); u8g2.print(tr(STR_OFFSET_TITLE));
 
   u8g2.setFont(u8g2_font_ncenB18_tr);
   u8g2.setCursor(5, 50);
@@ -500,10 +505,9 @@ static void dibujarOffsetEdit() {
 
   u8g2.setFont(u8g2_font_5x7_tf);
   u8g2.setCursor(5, 63);
-  u8g2.print(T("OK + / ALT - | MENU Guarda | ALT+MENU Cancela | OK+ALT = 0",
-               "OK + / ALT - | MENU Save   | ALT+MENU Cancel  | OK+ALT = 0"));
+  u8g2.print(tr(STR_OFFSET_HELP));
 
-  g_uiRepaintCounter++; uiStampRepaintCounter(); u8g2.sendBuffer();
+  g_uiRepaintCounter++; uiStampRepaintCounter(); lcdFlush();
 }
 
 // ====== Gating de dibujo del MENÚ ======
@@ -532,7 +536,7 @@ static void ejecutarOpcionMenu(int opcion) {
     case 2: { altFormat = normalizeAltFormat(altFormat); altFormat = (altFormat == 0) ? 4 : 0; } break;
     case 3: logbookUiOpen(); break;
     case 4: datetimeMenuOpen(); break;
-    case 5: break;
+    case 5: altHistoryUiOpen(); break;
     case 6:
       ahorroTimeoutOption = (ahorroTimeoutOption + 1) % NUM_TIMEOUT_OPTIONS;
       ahorroTimeoutMs     = TIMEOUT_OPTIONS[ahorroTimeoutOption];
@@ -565,7 +569,7 @@ static void ejecutarOpcionMenu(int opcion) {
 
 // ---------------------------------------------------------------------------
 void processMenu() {
-  // CPU en modo interactivo (lo refuerza powerPolicyTick en updateUI)
+  // CPU en modo interactivo (lo aplica powerGovTick antes de la UI)
   btnTick(BTN_ALT); btnTick(BTN_OK); btnTick(BTN_MENU);
 
   if (s_firstFrameMenu) {
@@ -576,8 +580,9 @@ void processMenu() {
   }
 
   // Submenús que toman control completo
-  if (logbookUiIsActive())  { lastMenuInteraction = millis(); return; }
-  if (datetimeMenuActive()) { lastMenuInteraction = millis(); return; }
+  if (logbookUiIsActive())    { lastMenuInteraction = millis(); return; }
+  if (datetimeMenuActive())   { lastMenuInteraction = millis(); return; }
+  if (altHistoryUiIsActive()) { lastMenuInteraction = millis(); return; }
 
   // Ignorar entradas los primeros ms al entrar al menú pero sigue dibujando suave
   if (millis() < uiBlockMenuOpenUntilMs) { maybeDrawMenu(); return; }
@@ -640,138 +645,305 @@ void processMenu() {
   maybeDrawMenu();
 }
 
-// --- Atenuación automática en modo Ahorro ---
-static bool        ahorroDimmed        = false;
-static const uint8_t  AHORRO_DIM_CONTRAST = 5;
-static const uint32_t INACTIVITY_DIM_MS   = 120000UL;
+// ====== HUD por evento de muestra ======
+// Todo lo que el HUD pinta, ya formateado/redondeado a la resolución de
+// pantalla: si no cambia nada de esto, el frame sería idéntico.
+struct HudState {
+  uint32_t seq;          // muestra de la que sale 'alt'
+  char     alt[12];
+  char     hhmm[6];
+  char     temp[8];
+  uint32_t lifetime;
+  uint32_t userHash;
+  int16_t  pct;
+  bool     metros, moon, batOn, usb, armed, inJump, lock;
+  bool     flight;       // Ultra/FF: fila inferior con vz y tiempo de FF
+  char     vz[10];
+  char     ff[10];
+};
+
+// Campos que cambian a ritmo de muestra: se repintan solos sobre el
+// frame anterior (u8g2 conserva el buffer). Cualquier otro cambio
+// repinta todo.
+enum : uint8_t { HUD_F_ALT = 1, HUD_F_VZ = 2, HUD_F_FF = 4, HUD_F_ALL = 0x80 };
+
+// Cajas de los campos (interior del marco)
+static const uint8_t HUD_ALT_Y0 = 16, HUD_ALT_H = 36;    // entre las líneas 15 y 52
+static const uint8_t HUD_ROW_Y0 = 53, HUD_ROW_H = 10;    // fila inferior
+static const uint8_t HUD_ROW_BASE = 62;
+static const uint8_t HUD_VZ_X0 = 36, HUD_VZ_X1 = 84;
+static const uint8_t HUD_FF_X0 = 85, HUD_FF_X1 = 125;
+
+static HudState s_hud;                 // último HUD mostrado
+static bool     s_hudValid       = false;
+static bool     s_hudPending     = false;   // cambio retenido por tope de FPS
+static uint32_t s_hudSeqSeen     = 0;
+static uint32_t s_hudPollMs      = 0;
+static uint32_t s_hudLastFrameMs = 0;
+
+static inline uint32_t hudMinFrameMs(SensorMode m) {
+  if (m == SENSOR_MODE_FREEFALL)      return UI_HUD_MIN_FRAME_FF_MS;
+  if (m == SENSOR_MODE_ULTRA_PRECISO) return UI_HUD_MIN_FRAME_ULTRA_MS;
+  return UI_HUD_MIN_FRAME_AHORRO_MS;
+}
+
+static uint32_t hudHashStr(const char* s) {   // FNV-1a
+  uint32_t h = 2166136261u;
+  while (*s) { h ^= (uint8_t)*s++; h *= 16777619u; }
+  return h;
+}
+
+// Proyección (m) de la última muestra al instante en que el frame llega
+// al LCD: (ahora - medida) + envío medio del frame (lcd_flush)
+static float s_leadGain = 0.0f;
+static float hudLeadMeters() {
+#if UI_LEAD_COMP
+  const float vz = sensorGetVz();
+  float target = 0.0f;
+  if (getSensorMode() != SENSOR_MODE_AHORRO) {
+    target = (fabsf(vz) - UI_LEAD_VZ_LO_MPS) / (UI_LEAD_VZ_HI_MPS - UI_LEAD_VZ_LO_MPS);
+    if (target < 0.0f) target = 0.0f;
+    if (target > 1.0f) target = 1.0f;
+  }
+  s_leadGain += 0.25f * (target - s_leadGain);   // entrada/salida suave
+  if (s_leadGain < 0.01f) { s_leadGain = target; return 0.0f; }
+
+  const int64_t sampleUs = sensorSampleTimeUs();
+  if (sampleUs <= 0) return 0.0f;
+  const int64_t latUs = esp_timer_get_time() - sampleUs + (int64_t)lcdFlushEstimateUs();
+  if (latUs <= 0 || latUs > (int64_t)UI_LEAD_MAX_LAT_MS * 1000) return 0.0f;
+
+  float lead = vz * (float)latUs * 1e-6f * s_leadGain;
+  if (lead >  UI_LEAD_MAX_M) lead =  UI_LEAD_MAX_M;
+  if (lead < -UI_LEAD_MAX_M) lead = -UI_LEAD_MAX_M;
+  return lead;
+#else
+  return 0.0f;
+#endif
+}
+
+static void hudFormatAlt(char* out, size_t n) {
+  float altRel_m = altCalculada + hudLeadMeters();
+  float rel_from_offset_m = altRel_m - alturaOffset;
+  float altToShow;
+  if (unidadMetros) {
+    altToShow = (fabsf(rel_from_offset_m) < UI_DEADBAND_M) ? alturaOffset : altRel_m;
+  } else {
+    float rel_from_offset_ft = rel_from_offset_m * 3.281f;
+    altToShow = (fabsf(rel_from_offset_ft) < UI_DEADBAND_FT) ? (alturaOffset*3.281f) : (altRel_m*3.281f);
+  }
+
+  int fmt = normalizeAltFormat(altFormat);
+  if (fmt == 4) {
+    float absAlt = fabsf(altToShow);
+    if      (absAlt <  999.0f) { long v = lroundf(altToShow); snprintf(out, n, "%ld", v); }
+    else if (absAlt < 9999.0f) { float vDisp = roundf((altToShow/1000.0f)*100.0f)/100.0f; snprintf(out, n, "%.2f", vDisp); }
+    else                       { float vDisp = roundf((altToShow/1000.0f)*10.0f)/10.0f;  snprintf(out, n, "%.1f", vDisp); }
+  } else snprintf(out, n, "%ld", (long)altToShow);
+}
+
+static void hudBuildState(HudState& st) {
+  st.seq    = sensorSampleSeq();
+  st.metros = unidadMetros;
+  datetimeFormatHHMM(st.hhmm, sizeof(st.hhmm));
+
+  st.moon = (ahorroTimeoutMs > 0 && !powerLockActive() && getSensorMode() == SENSOR_MODE_AHORRO &&
+             !isUsbPresent() && moon_blink_now(false));
+  snprintf(st.temp, sizeof(st.temp), "%.0f°C", (float)bmp.temperature);
+
+  st.pct   = (int16_t)batteryGetPercent();
+  st.batOn = bat_blink_now();
+  st.usb   = isUsbPresent();
+
+  hudFormatAlt(st.alt, sizeof(st.alt));
+
+  st.lifetime = 0; logbookGetTotal(st.lifetime);
+  st.userHash = hudHashStr(usuarioActual.c_str());
+  st.armed    = jumpArmed;
+  st.inJump   = inJump;
+  st.lock     = powerLockActive();
+
+  // Modo vuelo: vz entera (m/s o mph) y segundos de FF del salto activo
+  st.flight = (getSensorMode() != SENSOR_MODE_AHORRO);
+  st.vz[0] = st.ff[0] = '\0';
+  if (st.flight) {
+    const float vz = sensorGetVz();
+    long v = lroundf(unidadMetros ? vz : vz * 2.237f);
+    snprintf(st.vz, sizeof(st.vz), "%ld%s", v, unidadMetros ? "m/s" : "mph");
+    if (logbookIsActive())
+      snprintf(st.ff, sizeof(st.ff), "FF %lus", (unsigned long)logbookGetActiveFFTime());
+  }
+}
+
+// Campos que difieren de lo mostrado (0 = frame idéntico; seq no cuenta)
+static uint8_t hudDirtyFields(const HudState& st) {
+  const HudState& a = s_hud;
+  const bool rest =
+      a.metros == st.metros && a.moon == st.moon && a.batOn == st.batOn && a.usb == st.usb &&
+      a.armed == st.armed && a.inJump == st.inJump && a.lock == st.lock && a.flight == st.flight &&
+      a.pct == st.pct && a.lifetime == st.lifetime && a.userHash == st.userHash &&
+      strcmp(a.hhmm, st.hhmm) == 0 && (st.moon || strcmp(a.temp, st.temp) == 0);
+  if (!rest) return HUD_F_ALL;
+  uint8_t m = 0;
+  if (strcmp(a.alt, st.alt) != 0) m |= HUD_F_ALT;
+  if (strcmp(a.vz,  st.vz)  != 0) m |= HUD_F_VZ;
+  if (strcmp(a.ff,  st.ff)  != 0) m |= HUD_F_FF;
+  return m;
+}
+
+static inline void hudEraseBox(int x, int y, int w, int h) {
+  u8g2.setDrawColor(0); u8g2.drawBox(x, y, w, h); u8g2.setDrawColor(1);
+}
+
+static void hudDrawAlt(const HudState& st, bool erase) {
+  PROF_SCOPE(PROF_UI_ALT);
+  if (erase) hudEraseBox(1, HUD_ALT_Y0, 126, HUD_ALT_H);
+  // Glifos cacheados (alt_glyph_cache); u8g2 si falta alguno
+  int wAlt = altGlyphStrWidth(st.alt);
+  if (wAlt < 0) { u8g2.setFont(u8g2_font_fub30_tr); wAlt = u8g2.getStrWidth(st.alt); }
+  int xPosAlt = (128 - wAlt) / 2; if (xPosAlt < 0) xPosAlt = 0;
+  if (!altGlyphDrawStr(u8g2, xPosAlt, 50, st.alt)) {
+    u8g2.setFont(u8g2_font_fub30_tr);
+    u8g2.setCursor(xPosAlt, 50); u8g2.print(st.alt);
+  }
+}
+
+static void hudDrawVz(const HudState& st, bool erase) {
+  if (erase) hudEraseBox(HUD_VZ_X0, HUD_ROW_Y0, HUD_VZ_X1 - HUD_VZ_X0 + 1, HUD_ROW_H);
+  u8g2.setFont(u8g2_font_ncenB08_tr);
+  u8g2.drawStr(HUD_VZ_X0, HUD_ROW_BASE, st.vz);
+}
+
+static void hudDrawFF(const HudState& st, bool erase) {
+  if (erase) hudEraseBox(HUD_FF_X0, HUD_ROW_Y0, HUD_FF_X1 - HUD_FF_X0 + 1, HUD_ROW_H);
+  if (!st.ff[0]) return;
+  u8g2.setFont(u8g2_font_ncenB08_tr);
+  u8g2.drawStr(HUD_FF_X1 - u8g2.getStrWidth(st.ff), HUD_ROW_BASE, st.ff);
+}
+
+static void hudDrawFull(const HudState& st) {
+  u8g2.clearBuffer();
 
-static inline void handleAhorroAutoDim() {
-  const unsigned long now     = millis();
-  const unsigned long lastAct = getLastActivityMs();
-  const SensorMode m          = getSensorMode();
-  const bool mustRestore = (m != SENSOR_MODE_AHORRO) || powerLockActive() || inJump;
+  u8g2.setFont(u8g2_font_ncenB08_tr);
+  u8g2.setCursor(2, 12); u8g2.print(st.metros ? "M" : "FT");
+
+  { int w = u8g2.getStrWidth(st.hhmm); int x = (128 - w)/2; if (x < 0) x = 0;
+    u8g2.setCursor(x, 12); u8g2.print(st.hhmm); }
+
+  if (st.moon) {
+    u8g2.setFont(u8g2_font_open_iconic_weather_1x_t);
+    u8g2.drawGlyph(18, 12, 66);
+    u8g2.setFont(u8g2_font_5x8_mf);
+    u8g2.drawStr(27, 10, "zzz");
+  } else {
+    u8g2.setFont(u8g2_font_6x10_tf); u8g2.drawUTF8(23, 12, st.temp);
+  }
+
+  if (st.batOn) {
+    u8g2.setFont(u8g2_font_ncenB08_tr);
+    char batStr[6]; snprintf(batStr, sizeof(batStr), "%d%%", st.pct);
+    int batWidth = u8g2.getStrWidth(batStr);
+    u8g2.setCursor(128 - batWidth - 2, 12); u8g2.print(batStr);
+  }
+
+  if (st.usb) { u8g2.setFont(u8g2_font_open_iconic_other_1x_t); u8g2.drawGlyph(90, 12, 64); }
+
+  hudDrawAlt(st, false);
+
+  u8g2.drawHLine(0, 15, 128); u8g2.drawHLine(0, 52, 128);
+  u8g2.drawHLine(0,  0, 128); u8g2.drawHLine(0, 63, 128);
+  u8g2.drawVLine(0,  0, 64);  u8g2.drawVLine(127,0, 64);
+
+  if (st.flight) {
+    // En vuelo: vz y tiempo de FF en lugar de usuario y total de saltos
+    hudDrawVz(st, false);
+    hudDrawFF(st, false);
+  } else {
+    u8g2.setFont(u8g2_font_ncenB08_tr);
+    const char* user = usuarioActual.c_str();   // sin copia
+    int xPosUser = (128 - u8g2.getStrWidth(user)) / 2; if (xPosUser < 0) xPosUser = 0;
+    u8g2.setCursor(xPosUser, 62); u8g2.print(user);
+
+    char jumpStr[11]; snprintf(jumpStr, sizeof(jumpStr), "%lu", (unsigned long)st.lifetime);
+    u8g2.setCursor(128 - u8g2.getStrWidth(jumpStr) - 14, 62); u8g2.print(jumpStr);
+  }
 
-  if (mustRestore) { if (ahorroDimmed) { u8g2.setContrast(150); } ahorroDimmed = false; return; }
-  if (!ahorroDimmed && (now - lastAct >= INACTIVITY_DIM_MS)) { u8g2.setContrast(150); ahorroDimmed = true; return; }
-  if (ahorroDimmed && (now - lastAct) <= 1000UL) { u8g2.setContrast(150); ahorroDimmed = false; }
+  if (st.armed || st.inJump) { if (st.inJump) u8g2.drawDisc(14, 58, 3); else u8g2.drawCircle(14, 58, 3); }
+  if (st.lock) { u8g2.setFont(u8g2_font_open_iconic_thing_1x_t); u8g2.drawGlyph(26, 63, 79); }
 }
 
 // ---------------------------------------------------------------------------
 void updateUI() {
-  if (!startupDone) { mostrarCuentaRegresiva(); return; }
-
-  // Re-aplica política de CPU (sube a ACTIVO si hay interacción)
-  powerPolicyTick();
+  if (!startupDone) { s_hudValid = false; mostrarCuentaRegresiva(); return; }
 
   // Redibujo inmediato al cambiar lock (candado)
   static bool s_prevLock = false;
   bool lockNow = powerLockActive();
   if (lockNow != s_prevLock) { uiForceRefresh = true; s_prevLock = lockNow; }
 
-  if (gameSnakeRunning) { playSnakeGame(); return; }
+  if (gameSnakeRunning) { s_hudValid = false; playSnakeGame(); return; }
   if (!pantallaEncendida) return;
 
-  handleAhorroAutoDim();
+  displayPowerTick();                        // contraste, power-save del LCD y backlight
+  if (displayPowerLcdAsleep()) return;        // nada visible que repintar
 
   if (!menuActivo) {
-    // Throttling HUD por modo
-    static uint32_t t_last_ui = 0;
-    uint16_t ui_interval = 140;
     SensorMode m = getSensorMode();
-    if (m == SENSOR_MODE_ULTRA_PRECISO) ui_interval = 100;
-    if (m == SENSOR_MODE_FREEFALL)     ui_interval = 80;
-
     uint32_t now_ui = millis();
-    if (now_ui - t_last_ui < ui_interval) return;
-    t_last_ui = now_ui;
 
-    // Tick lento + gating solo en Ahorro
     if (m == SENSOR_MODE_AHORRO) {
+      // Tick lento + gating propio de Ahorro
       if (!uiForceRefresh && (int32_t)(now_ui - s_ui_next_allowed_ms) < 0) return;
       s_ui_next_allowed_ms = now_ui + UI_AHORRO_TICK_MS;
       if (!uiForceRefresh && !ui_should_repaint_ahorro()) return;
-      uiForceRefresh = false;
+    } else {
+      // Por evento: muestra nueva publicada, frame pendiente o sondeo del
+      // resto del HUD (reloj, batería, parpadeos) cada UI_HUD_POLL_MS
+      const uint32_t seq = sensorSampleSeq();
+      if (!uiForceRefresh && !s_hudPending && seq == s_hudSeqSeen &&
+          (now_ui - s_hudPollMs) < UI_HUD_POLL_MS) return;
+      s_hudSeqSeen = seq;
+      s_hudPollMs  = now_ui;
     }
 
-    // -------- HUD --------
-    u8g2.clearBuffer();
-
-    u8g2.setFont(u8g2_font_ncenB08_tr);
-    u8g2.setCursor(2, 12); u8g2.print(unidadMetros ? "M" : "FT");
-
-    { char hhmm[6]; datetimeFormatHHMM(hhmm, sizeof(hhmm));
-      int w = u8g2.getStrWidth(hhmm); int x = (128 - w)/2; if (x < 0) x = 0;
-      u8g2.setCursor(x, 12); u8g2.print(hhmm); }
-
-    bool mostreSuspIcono = false;
-    if (ahorroTimeoutMs > 0 && !powerLockActive() && getSensorMode() == SENSOR_MODE_AHORRO && !isUsbPresent()) {
-      bool blinkOn = moon_blink_now(false);
-      if (blinkOn) {
-        u8g2.setFont(u8g2_font_open_iconic_weather_1x_t);
-        u8g2.drawGlyph(18, 12, 66);
-        u8g2.setFont(u8g2_font_5x8_mf);
-        u8g2.drawStr(27, 10, "zzz");
-        mostreSuspIcono = true;
-      }
-    }
-    if (!mostreSuspIcono) {
-      char tbuf[8]; float tC = bmp.temperature;
-      snprintf(tbuf, sizeof(tbuf), "%.0f°C", tC);
-      u8g2.setFont(u8g2_font_6x10_tf); u8g2.drawUTF8(23, 12, tbuf);
-    }
+    // Sólo si cambia algo visible (valores ya redondeados a pantalla)
+    HudState st;
+    hudBuildState(st);
+    const uint8_t dirty = (uiForceRefresh || !s_hudValid) ? HUD_F_ALL : hudDirtyFields(st);
+    if (!dirty) { s_hudPending = false; return; }
 
-    { int pct = batteryGetPercent(); if (bat_blink_now()) {
-        u8g2.setFont(u8g2_font_ncenB08_tr);
-        String batStr = String(pct) + "%";
-        int batWidth = u8g2.getStrWidth(batStr.c_str());
-        u8g2.setCursor(128 - batWidth - 2, 12); u8g2.print(batStr);
-      }
+    // Tope de FPS por modo: el cambio queda pendiente para la próxima vuelta
+    if (!uiForceRefresh && s_hudValid && (now_ui - s_hudLastFrameMs) < hudMinFrameMs(m)) {
+      s_hudPending = true;
+      return;
     }
+    uiForceRefresh = false;
+    s_hudPending   = false;
+    s_hudLastFrameMs = now_ui;
 
-    if (isUsbPresent()) { u8g2.setFont(u8g2_font_open_iconic_other_1x_t); u8g2.drawGlyph(90, 12, 64); }
+    // Latencia muestra->LCD sólo la primera vez que se muestra esa muestra
+    const int64_t sampleUs = (st.seq != s_hud.seq) ? sensorSampleTimeUs() : 0;
+    s_hud = st; s_hudValid = true;
 
-    float altRel_m = altCalculada;
-    float rel_from_offset_m = altRel_m - alturaOffset;
-    float altToShow;
-    if (unidadMetros) {
-      altToShow = (fabsf(rel_from_offset_m) < UI_DEADBAND_M) ? alturaOffset : altRel_m;
-    } else {
-      float rel_from_offset_ft = rel_from_offset_m * 3.281f;
-      altToShow = (fabsf(rel_from_offset_ft) < UI_DEADBAND_FT) ? (alturaOffset*3.281f) : (altRel_m*3.281f);
+    // -------- HUD --------
+    HEAP_PROBE_FRAME_BEGIN();
+    if (dirty & HUD_F_ALL) hudDrawFull(st);
+    else {
+      if (dirty & HUD_F_ALT) hudDrawAlt(st, true);
+      if (dirty & HUD_F_VZ)  hudDrawVz(st, true);
+      if (dirty & HUD_F_FF)  hudDrawFF(st, true);
     }
+    if (st.lock) alarmOnLockAltitude();
 
-    String altDisplay;
-    int fmt = normalizeAltFormat(altFormat);
-    if (fmt == 4) {
-      float absAlt = fabsf(altToShow);
-      if      (absAlt <  999.0f) { long v = lroundf(altToShow); altDisplay = String(v); }
-      else if (absAlt < 9999.0f) { float vDisp = roundf((altToShow/1000.0f)*100.0f)/100.0f; altDisplay = String(vDisp, 2); }
-      else                       { float vDisp = roundf((altToShow/1000.0f)*10.0f)/10.0f;  altDisplay = String(vDisp, 1); }
-    } else altDisplay = String((long)altToShow);
-
-    u8g2.setFont(u8g2_font_fub30_tr);
-    int xPosAlt = (128 - u8g2.getStrWidth(altDisplay.c_str())) / 2; if (xPosAlt < 0) xPosAlt = 0;
-    u8g2.setCursor(xPosAlt, 50); u8g2.print(altDisplay);
-
-    u8g2.drawHLine(0, 15, 128); u8g2.drawHLine(0, 52, 128);
-    u8g2.drawHLine(0,  0, 128); u8g2.drawHLine(0, 63, 128);
-    u8g2.drawVLine(0,  0, 64);  u8g2.drawVLine(127,0, 64);
-
-    u8g2.setFont(u8g2_font_ncenB08_tr);
-    String user = usuarioActual;
-    int xPosUser = (128 - u8g2.getStrWidth(user.c_str())) / 2; if (xPosUser < 0) xPosUser = 0;
-    u8g2.setCursor(xPosUser, 62); u8g2.print(user);
-
-    uint32_t lifetime = 0; logbookGetTotal(lifetime);
-    String jumpStr = String(lifetime);
-    u8g2.setCursor(128 - u8g2.getStrWidth(jumpStr.c_str()) - 14, 62); u8g2.print(jumpStr);
-
-    if (jumpArmed || inJump) { if (inJump) u8g2.drawDisc(14, 58, 3); else u8g2.drawCircle(14, 58, 3); }
-    if (powerLockActive()) { u8g2.setFont(u8g2_font_open_iconic_thing_1x_t); u8g2.drawGlyph(26, 63, 79); alarmOnLockAltitude(); }
-
-    g_uiRepaintCounter++; uiStampRepaintCounter(); u8g2.sendBuffer();
+    // El sello R: va sobre la cabecera: sólo en frames completos
+    g_uiRepaintCounter++;
+    if (dirty & HUD_F_ALL) uiStampRepaintCounter();
+    lcdFlush(sampleUs, hilOnFrameSent);   // HIL: cierra muestra->pantalla en el panel
+    warmBootOnHudFrame();
+    HEAP_PROBE_FRAME_END();
 
   } else {
+    s_hudValid = false;   // otra pantalla en el buffer: el próximo HUD es completo
     if (datetimeMenuActive()) { datetimeMenuDrawAndHandle(); return; }
     if (editingOffset)       { dibujarOffsetEdit(); return; }
 
@@ -780,10 +952,18 @@ void updateUI() {
         float vbat = batteryGetVoltage(); int pct  = batteryGetPercent();
         u8g2.clearBuffer();
         u8g2.setFont(u8g2_font_ncenB08_tr);
-        u8g2.setCursor(0,12); u8g2.print(T("BATERIA:", "BATTERY:"));
-        u8g2.setCursor(0,28); u8g2.print("V_Bat: "); u8g2.setCursor(50,28); u8g2.print(vbat, 2); u8g2.print("V");
-        u8g2.setCursor(0,44); u8g2.print(T("Carga: ", "Charge: ")); u8g2.setCursor(50,44); u8g2.print(pct); u8g2.print("%");
-        g_uiRepaintCounter++; uiStampRepaintCounter(); u8g2.sendBuffer();
+        const float hours = batteryRemainingHours();
+        const int   jumps = batteryRemainingJumps();
+        u8g2.setCursor(0,12); u8g2.print(tr(STR_BATTERY));
+        u8g2.setCursor(0,25); u8g2.print("V_Bat: "); u8g2.setCursor(60,25); u8g2.print(vbat, 2); u8g2.print("V");
+        u8g2.setCursor(0,38); u8g2.print(tr(STR_CHARGE)); u8g2.setCursor(60,38); u8g2.print(pct); u8g2.print("%");
+        u8g2.setCursor(0,51); u8g2.print(tr(STR_RUNTIME)); u8g2.setCursor(60,51);
+        if (isUsbPresent() || hours < 0) u8g2.print("--");
+        else { u8g2.print(hours, hours < 10.0f ? 1 : 0); u8g2.print(" h"); }
+        u8g2.setCursor(0,64); u8g2.print(tr(STR_JUMPS_LEFT)); u8g2.setCursor(60,64);
+        if (isUsbPresent() || jumps < 0) u8g2.print("--");
+        else { u8g2.print("~"); u8g2.print(jumps); }
+        g_uiRepaintCounter++; uiStampRepaintCounter(); lcdFlush();
 
         btnTick(BTN_OK);
         if (btnRise(BTN_OK)) { batteryMenuActive = false; lastMenuInteraction = millis(); uiForceRefresh = true; }
@@ -792,8 +972,31 @@ void updateUI() {
     }
 
     if (logbookUiIsActive()) { logbookUiDrawAndHandle(u8g2); return; }
+    if (altHistoryUiIsActive()) { altHistoryUiDrawAndHandle(u8g2); return; }
 
     // Dibujo del menú con gating
     maybeDrawMenu();
   }
 }
+
+// Próximo instante en que updateUI() tiene trabajo (planificador del loop).
+// Las pantallas interactivas sondean botones/parpadeos: paso corto.
+uint32_t uiNextDueMs() {
+  const uint32_t now = millis();
+  if (!startupDone || menuActivo || gameSnakeRunning || uiForceRefresh) {
+    return now + (uiForceRefresh ? 0 : UI_INTERACTIVE_POLL_MS);
+  }
+  if (!pantallaEncendida) return now + UI_HUD_POLL_MS;
+  // LCD en power-save: sólo vigilar la salida de Ahorro (los botones despiertan por ISR)
+  if (displayPowerLcdAsleep()) return now + SCHED_MAX_WAIT_MS;
+  // Botón mantenido (pulsación larga en main/HUD)
+  if (digitalRead(BUTTON_MENU) == HIGH || digitalRead(BUTTON_ALTITUDE) == HIGH ||
+      digitalRead(BUTTON_OLED) == HIGH) return now + UI_INTERACTIVE_POLL_MS;
+
+  const SensorMode m = getSensorMode();
+  if (m == SENSOR_MODE_AHORRO) return s_ui_next_allowed_ms;
+  // Vuelo: las muestras nuevas llegan en la misma vuelta que el sensor;
+  // aquí sólo el frame retenido por el tope de FPS y el sondeo del HUD
+  if (s_hudPending) return s_hudLastFrameMs + hudMinFrameMs(m);
+  return s_hudPollMs + UI_HUD_POLL_MS;
+}
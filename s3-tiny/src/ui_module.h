@@ -2,10 +2,16 @@
 #define UI_MODULE_H
 
 #include <U8g2lib.h>
+#include "lcd_spi_dma.h"
 
 // ---- Objetos/estado UI expuestos ----
-// LCD transflectivo (ST7567)
-extern U8G2_ST7567_JLX12864_F_4W_SW_SPI u8g2;
+// LCD transflectivo (ST7567): SPI2 + DMA o SPI software
+#if LCD_USE_HW_SPI_DMA
+typedef U8G2_ST7567_JLX12864_F_SPI_DMA   LcdU8g2;
+#else
+typedef U8G2_ST7567_JLX12864_F_4W_SW_SPI LcdU8g2;
+#endif
+extern LcdU8g2 u8g2;
 
 extern bool startupDone;
 extern int  menuOpcion;
@@ -21,6 +27,7 @@ void dibujarMenu();             // Render del menú principal
 void mostrarCuentaRegresiva();  // Splash de arranque (no bloqueante)
 void processMenu();             // Lógica de navegación del menú (no bloqueante)
 void uiRequestRefresh();
+uint32_t uiNextDueMs();         // millis() del próximo trabajo de la UI (loop_sched)
 // (Opcional) Si algún módulo externo quisiera invocar la pantalla de edición:
 // void dibujarOffsetEdit();
 
@@ -28,12 +35,12 @@ void uiRequestRefresh();
 bool     isUsbPresent();   // true si hay VBUS presente (con histéresis)
 uint16_t readVBUSmV();     // VBUS estimado en mV (del divisor 330k/510k)
 
-// ---- Backlight (PWM, activo-bajo) ----
+// ---- Backlight (PWM, activo-bajo; nivel y fades en display_power) ----
 // Enciende el backlight usando el brillo configurado en 'brilloPantalla'
 void lcdBacklightOnUser();
-// Apaga el backlight (duty=250 por requerimiento)
+// Apaga el backlight (fade hasta duty máximo: pin siempre alto)
 void lcdBacklightOff();
-// Alterna entre encendido (nivel usuario) y apagado (250)
+// Alterna entre encendido (nivel usuario) y apagado
 void lcdBacklightToggle();
 // Retorna true si el backlight está encendido actualmente
 bool lcdBacklightIsOn();
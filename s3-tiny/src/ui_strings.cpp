@@ -0,0 +1,14 @@
+#include "ui_strings.h"
+#include "config.h"
+
+// [id][idioma]: const => .rodata (flash)
+static const char* const kUiStrings[STR_COUNT][2] = {
+#define UI_STR_ROW(id, es, en) { es, en },
+  UI_STRINGS(UI_STR_ROW)
+#undef UI_STR_ROW
+};
+
+const char* tr(StrId id) {
+  if (id >= STR_COUNT) return "";
+  return kUiStrings[id][(idioma == LANG_ES) ? 0 : 1];
+}
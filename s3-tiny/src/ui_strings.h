@@ -0,0 +1,60 @@
+#ifndef UI_STRINGS_H
+#define UI_STRINGS_H
+
+// =====================================================
+// Textos de UI localizados (tabla en flash)
+// -----------------------------------------------------
+// tr(STR_x) devuelve un const char* de .rodata según
+// 'idioma'; no reserva heap (a diferencia del antiguo
+// T() que construía un String por llamada).
+// Para añadir un texto: una línea en UI_STRINGS; el enum
+// y la tabla salen de la misma lista y no se desalinean.
+// =====================================================
+
+#include <Arduino.h>
+
+#define UI_STRINGS(X)                                                           \
+  X(STR_DISPLAY_STARTED, "Display iniciado.",   "Display started.")             \
+  X(STR_STARTING,        "Iniciando...",        "Starting...")                  \
+  X(STR_MENU,            "MENU:",               "MENU:")                        \
+  X(STR_UNITS,           "Unidad: ",            "Units: ")                      \
+  X(STR_METERS,          "metros",              "meters")                       \
+  X(STR_FEET,            "pies",                "feet")                         \
+  X(STR_BRIGHTNESS,      "Brillo: ",            "Brightness: ")                 \
+  X(STR_ALT_FMT,         "Altura: ",            "Altitude fmt: ")               \
+  X(STR_NORMAL,          "normal",              "normal")                       \
+  X(STR_LOGBOOK,         "Bitacora",            "Logbook")                      \
+  X(STR_DATETIME,        "Fecha/Hora",          "Date/Time")                    \
+  X(STR_HISTORY,         "Historial",           "History")                      \
+  X(STR_POWER_SAVE,      "Ahorro: ",            "Power save: ")                 \
+  X(STR_MIN,             " min",                " min")                         \
+  X(STR_LANGUAGE,        "Idioma: ",            "Language: ")                   \
+  X(STR_EXIT_MENU,       "Salir del menú",      "Exit menu")                    \
+  X(STR_OFFSET_TITLE,    "Offset de altitud",   "Altitude offset")              \
+  X(STR_OFFSET_HELP,     "OK + / ALT - | MENU Guarda | ALT+MENU Cancela | OK+ALT = 0", \
+                         "OK + / ALT - | MENU Save   | ALT+MENU Cancel  | OK+ALT = 0") \
+  X(STR_BATTERY,         "BATERIA:",            "BATTERY:")                     \
+  X(STR_CHARGE,          "Carga: ",             "Charge: ")                     \
+  X(STR_RUNTIME,         "Autonomia: ",         "Runtime: ")                    \
+  X(STR_JUMPS_LEFT,      "Saltos: ",            "Jumps: ")                      \
+  X(STR_LB_EXIT,         "Exit:",               "Exit:")                        \
+  X(STR_LB_OPEN,         "Open:",               "Open:")                        \
+  X(STR_LB_NO_ENTRIES,   "Sin registros",       "No entries")                   \
+  X(STR_LB_MENU_EXIT,    "MENU para salir",     "MENU to exit")                 \
+  X(STR_LB_ERASE,        "Borrar Bitacora",     "Erase Logbook")                \
+  X(STR_LB_HOLD,         "Mantener ALT+OLED",   "Hold ALT+OLED")                \
+  X(STR_LB_CONFIRM,      "2s para CONFIRMAR",   "2s to CONFIRM")                \
+  X(STR_LB_CANCEL,       "MENU para cancelar",  "MENU to cancel")               \
+  X(STR_LB_ERASED,       "Bitacora borrada",    "Logbook erased")               \
+  X(STR_HIST_NO_DATA,    "Sin datos",           "No data")
+
+enum StrId : uint8_t {
+#define UI_STR_ENUM(id, es, en) id,
+  UI_STRINGS(UI_STR_ENUM)
+#undef UI_STR_ENUM
+  STR_COUNT
+};
+
+const char* tr(StrId id);
+
+#endif // UI_STRINGS_H
@@ -0,0 +1,133 @@
+#include "ulp_climb.h"
+#include <Wire.h>
+#include <esp_sleep.h>
+#include "config.h"
+
+#if ULP_CLIMB_ENABLE
+#include <math.h>
+#include <esp_attr.h>
+#include "driver/rtc_io.h"
+#include "ulp_riscv.h"
+#include "ulp_riscv_i2c.h"
+#include "ulp_main.h"                 // generado por ulp_embed_binary
+#include "bmp390_raw.h"
+#include "../ulp/ulp_climb_logic.h"
+
+extern const uint8_t ulp_main_bin_start[] asm("_binary_ulp_main_bin_start");
+extern const uint8_t ulp_main_bin_end[]   asm("_binary_ulp_main_bin_end");
+
+static inline ClimbState* climbState() { return (ClimbState*)&ulp_climb; }
+
+static bool  s_woke     = false;
+static float s_groundPa = 0.0f;
+RTC_DATA_ATTR static bool s_running = false;   // armado y sin ulpClimbBoot() desde entonces
+
+void ulpClimbBoot() {
+  ulp_riscv_timer_stop();             // despiertos no hace falta el ULP
+  s_running = false;
+  rtc_gpio_deinit((gpio_num_t)SDA_PIN);
+  rtc_gpio_deinit((gpio_num_t)SCL_PIN);
+
+  if (esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_ULP) return;
+  const ClimbState* s = climbState();
+  s_woke     = true;
+  s_groundPa = (float)climb_base_pa(s);
+  Serial.printf("[ULP] subida: base=%ld Pa ahora=%ld Pa (%lu muestras, %lu errores)\n",
+                (long)climb_base_pa(s), (long)s->last_pa,
+                (unsigned long)s->samples, (unsigned long)s->errors);
+}
+
+bool ulpClimbWoke(float &groundPa) {
+  if (!s_woke) return false;
+  groundPa = s_groundPa;
+  return true;
+}
+
+bool ulpClimbRunning() { return s_running; }
+
+bool ulpClimbLastPa(float &lastPa) {
+  const ClimbState* s = climbState();
+  if (!s_running || s->samples == 0) return false;
+  lastPa = (float)s->last_pa;
+  return true;
+}
+
+void ulpClimbStop() {
+  if (!s_running) return;
+  ulp_riscv_timer_stop();
+  s_running = false;
+}
+
+bool ulpClimbArm() {
+  // Vuelta del mantenimiento: el ULP nunca paró, su línea base sigue
+  if (s_running) {
+    ESP_ERROR_CHECK(esp_sleep_enable_ulp_wakeup());
+    return true;
+  }
+
+  // Conversión del ULP: P x8, T x1, sin IIR (~20 ms por FORCED)
+  bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_OSR, BMP390_OSR(3, 0));
+  bmp390WriteReg(Wire, BMP_ADDR, BMP390_REG_CONFIG, 0);
+
+  Bmp390Calib cal;
+  uint32_t up, ut;
+  if (!bmp390ReadCalib(Wire, BMP_ADDR, cal) || !bmp390ForcedRaw(Wire, BMP_ADDR, up, ut)) {
+    Serial.println("[ULP] BMP sin respuesta: no se arma");
+    return false;
+  }
+  const Bmp390Linear lin = bmp390Linearize(cal, up, ut);
+
+  // La carga limpia la memoria reservada: el estado va después
+  if (ulp_riscv_load_binary(ulp_main_bin_start, ulp_main_bin_end - ulp_main_bin_start) != ESP_OK) {
+    Serial.println("[ULP] no se pudo cargar el binario");
+    return false;
+  }
+  ClimbState* s = climbState();
+  s->p0_pa      = (int32_t)lround(lin.p0);
+  s->up0        = (int32_t)up;
+  s->ut0        = (int32_t)ut;
+  s->kp_q16     = (int32_t)lround(lin.kP * 65536.0);
+  s->kt_q16     = (int32_t)lround(lin.kT * 65536.0);
+  s->drop_pa    = ULP_CLIMB_DROP_PA;
+  s->confirm_n  = ULP_CLIMB_CONFIRM;
+  s->base_shift = ULP_CLIMB_BASE_SHIFT;
+  climb_reset(s);
+
+  // SDA/SCL pasan al I2C del RTC (mismos pines en esta placa)
+  Wire.end();
+  ulp_riscv_i2c_cfg_t cfg = ULP_RISCV_I2C_DEFAULT_CONFIG();
+  cfg.i2c_pin_cfg.sda_io_num = (gpio_num_t)SDA_PIN;
+  cfg.i2c_pin_cfg.scl_io_num = (gpio_num_t)SCL_PIN;
+  if (ulp_riscv_i2c_master_init(&cfg) != ESP_OK) {
+    Serial.println("[ULP] I2C del RTC no disponible");
+    return false;
+  }
+
+  ulp_set_wakeup_period(0, ULP_CLIMB_PERIOD_MS * 1000UL);
+  if (ulp_riscv_run() != ESP_OK) return false;
+  ESP_ERROR_CHECK(esp_sleep_enable_ulp_wakeup());
+  s_running = true;
+
+  Serial.printf("[ULP] armado: p0=%ld Pa kP=%.5f kT=%.5f Pa/cuenta, caida=%d Pa\n",
+                (long)s->p0_pa, lin.kP, lin.kT, (int)ULP_CLIMB_DROP_PA);
+  return true;
+}
+
+void ulpClimbDump() {
+  const ClimbState* s = climbState();
+  Serial.printf("[ULP] ultima noche: muestras=%lu errores=%lu base=%ld Pa ultima=%ld Pa desperto=%lu\n",
+                (unsigned long)s->samples, (unsigned long)s->errors,
+                (long)climb_base_pa(s), (long)s->last_pa, (unsigned long)s->woke);
+}
+
+#else  // !ULP_CLIMB_ENABLE
+
+void ulpClimbBoot() {}
+bool ulpClimbWoke(float &) { return false; }
+bool ulpClimbRunning() { return false; }
+bool ulpClimbLastPa(float &) { return false; }
+bool ulpClimbArm() { return false; }
+void ulpClimbStop() {}
+void ulpClimbDump() { Serial.println("[ULP] deshabilitado (ULP_CLIMB_ENABLE=0)"); }
+
+#endif
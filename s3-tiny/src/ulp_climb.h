@@ -0,0 +1,65 @@
+#ifndef ULP_CLIMB_H
+#define ULP_CLIMB_H
+
+// =====================================================
+// Despertar por subida con el ULP RISC-V (deep sleep)
+// -----------------------------------------------------
+// Antes de dormir (salvo por batería baja) se carga en el
+// ULP el programa de s3-tiny/ulp: cada ULP_CLIMB_PERIOD_MS
+// hace una FORCED del BMP390 por el I2C del RTC y despierta
+// al CPU principal si la presión cae ULP_CLIMB_DROP_PA bajo
+// su línea base (avión subiendo con el altímetro dormido).
+// Al despertar así, la referencia de altitud es la línea
+// base del ULP (suelo), no la presión del momento.
+//
+// Requiere build IDF (framework = arduino, espidf) con
+// CONFIG_ULP_COPROC_TYPE_RISCV, CONFIG_ULP_COPROC_RESERVE_MEM
+// >= 4096 y ulp_embed_binary(ulp_main "ulp/main.c" ...).
+// Con ULP_CLIMB_ENABLE=0 (por defecto) la API no hace nada.
+// El despertar por timer (ds_housekeeping) no lo toca:
+// programa, línea base y pines siguen en el RTC y la
+// presión de la pasada es la última del ULP.
+// 'u' por Serial: estado de la última noche del ULP.
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef ULP_CLIMB_ENABLE
+  #define ULP_CLIMB_ENABLE      0
+#endif
+#ifndef ULP_CLIMB_PERIOD_MS
+  #define ULP_CLIMB_PERIOD_MS   4000UL
+#endif
+#ifndef ULP_CLIMB_DROP_PA
+  #define ULP_CLIMB_DROP_PA     1200    // ~100 m sobre el suelo
+#endif
+#ifndef ULP_CLIMB_CONFIRM
+  #define ULP_CLIMB_CONFIRM     2       // muestras seguidas
+#endif
+#ifndef ULP_CLIMB_BASE_SHIFT
+  #define ULP_CLIMB_BASE_SHIFT  8       // EMA de la línea base: ~17 min a 4 s
+#endif
+
+// Al principio de setup(), antes de Wire.begin(): para el ULP,
+// devuelve SDA/SCL al I2C principal y anota si despertó él
+void ulpClimbBoot();
+
+// ¿Despertó el ULP por subida? groundPa = su línea base
+bool ulpClimbWoke(float &groundPa);
+
+// Mantenimiento por timer, sin ulpClimbBoot(): ¿sigue corriendo
+// desde el último sueño? lastPa = su última muestra
+bool ulpClimbRunning();
+bool ulpClimbLastPa(float &lastPa);
+
+// Justo antes de esp_deep_sleep_start(): true si quedó armado.
+// Si sigue corriendo sólo vuelve a habilitar su despertar
+// (sin recargar ni reiniciar la línea base)
+bool ulpClimbArm();
+
+// Batería baja: para el ULP sin pasar por ulpClimbBoot()
+void ulpClimbStop();
+
+void ulpClimbDump();
+
+#endif // ULP_CLIMB_H
@@ -0,0 +1,100 @@
+#include "wake_stub.h"
+#include <esp_sleep.h>
+#include <esp_attr.h>
+#include <esp_idf_version.h>
+#include "soc/rtc_cntl_reg.h"
+#include "soc/rtc_io_reg.h"
+#include "config.h"
+#include "charge_detect.h"
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+  #include "esp_wake_stub.h"
+  #include "esp_rom_sys.h"
+  #define STUB_DELAY_US(us)  esp_rom_delay_us(us)
+#else
+  #include "esp32s3/rom/rtc.h"
+  #include "esp32s3/rom/ets_sys.h"
+  #define STUB_DELAY_US(us)  ets_delay_us(us)
+#endif
+
+// En el S3 el número RTC de GPIO0..21 coincide con el GPIO
+#define STUB_BTN_BIT   (1UL << WAKE_BTN_PIN)
+#define STUB_VBUS_BIT  (1UL << CHARGE_ADC_PIN)
+
+static RTC_DATA_ATTR WakeStubCounters s_wc;
+
+// ------------------------------
+// Stub (RTC fast mem: sólo registros y ROM)
+// ------------------------------
+#if WAKE_STUB_ENABLE
+
+static inline RTC_IRAM_ATTR bool stubPinHigh(uint32_t bit) {
+  return (REG_GET_FIELD(RTC_GPIO_IN_REG, RTC_GPIO_IN_NEXT) & bit) != 0;
+}
+
+// HIGH durante todo holdMs; sale en la primera muestra LOW
+static RTC_IRAM_ATTR bool stubPinHeld(uint32_t bit, uint32_t holdMs) {
+  for (uint32_t ms = 0; ms < holdMs; ++ms) {
+    if (!stubPinHigh(bit)) return false;
+    STUB_DELAY_US(1000);
+  }
+  return stubPinHigh(bit);
+}
+
+static RTC_IRAM_ATTR void stubSleepAgain() {
+  REG_SET_BIT(RTC_CNTL_EXT_WAKEUP1_REG, RTC_CNTL_EXT_WAKEUP1_STATUS_CLR);
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+  esp_wake_stub_sleep(&esp_wake_deep_sleep);
+#else
+  REG_WRITE(RTC_ENTRY_ADDR_REG, (uint32_t)&esp_wake_deep_sleep);
+  set_rtc_memory_crc();
+  CLEAR_PERI_REG_MASK(RTC_CNTL_STATE0_REG, RTC_CNTL_SLEEP_EN);
+  SET_PERI_REG_MASK(RTC_CNTL_STATE0_REG, RTC_CNTL_SLEEP_EN);
+  while (true) {}                     // unos ciclos hasta que corta
+#endif
+}
+
+void RTC_IRAM_ATTR esp_wake_deep_sleep(void) {
+  esp_default_wake_deep_sleep();
+
+  const uint32_t ext1 = REG_GET_FIELD(RTC_CNTL_EXT_WAKEUP1_STATUS_REG, RTC_CNTL_EXT_WAKEUP1_STATUS);
+  if (ext1 == 0) { s_wc.other++; return; }
+
+  if ((ext1 & STUB_BTN_BIT) && stubPinHeld(STUB_BTN_BIT, WAKE_STUB_BTN_HOLD_MS)) {
+    s_wc.btnOk++;
+    return;
+  }
+  if ((ext1 & STUB_VBUS_BIT) && stubPinHeld(STUB_VBUS_BIT, WAKE_STUB_VBUS_HOLD_MS)) {
+    s_wc.vbusOk++;
+    return;
+  }
+
+  if (ext1 & STUB_BTN_BIT) s_wc.btnRejected++;
+  else                     s_wc.vbusRejected++;
+
+  // Con un pin aún en HIGH, EXT1 despertaría al instante: mejor arrancar
+  if (stubPinHigh(STUB_BTN_BIT | STUB_VBUS_BIT)) return;
+  stubSleepAgain();
+}
+
+#endif // WAKE_STUB_ENABLE
+
+// ------------------------------
+// API (CPU ya arrancado)
+// ------------------------------
+WakeStubCounters wakeStubCounters() {
+  return s_wc;
+}
+
+void wakeStubDump() {
+  const WakeStubCounters c = s_wc;
+  Serial.printf("[STUB] boton ok=%lu rech=%lu  vbus ok=%lu rech=%lu  otros=%lu%s\n",
+                (unsigned long)c.btnOk, (unsigned long)c.btnRejected,
+                (unsigned long)c.vbusOk, (unsigned long)c.vbusRejected,
+                (unsigned long)c.other, WAKE_STUB_ENABLE ? "" : " (stub deshabilitado)");
+}
+
+void wakeStubReset() {
+  memset(&s_wc, 0, sizeof(s_wc));
+  Serial.println("[STUB] contadores a cero");
+}
@@ -0,0 +1,46 @@
+#ifndef WAKE_STUB_H
+#define WAKE_STUB_H
+
+// =====================================================
+// Wake stub de deep sleep: filtro de despertares falsos
+// -----------------------------------------------------
+// esp_wake_deep_sleep() corre desde RTC fast mem antes del
+// arranque (sin flash, sin setup()). Si el despertar fue
+// por EXT1 mira el nivel de los pines:
+//  - botón: debe seguir en HIGH WAKE_STUB_BTN_HOLD_MS
+//    (roces en el bolso no llegan),
+//  - VBUS: debe seguir en HIGH WAKE_STUB_VBUS_HOLD_MS
+//    (glitches del cargador).
+// Si no, vuelve a dormir ahí mismo (~ms a 40 MHz en vez
+// de un arranque completo). Timer/ULP/reset pasan sin más.
+// Contadores por causa en RTC slow mem: se pierden sólo
+// al cortar la alimentación. 'k' por Serial: contadores.
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef WAKE_STUB_ENABLE
+  #define WAKE_STUB_ENABLE        1
+#endif
+#ifndef WAKE_STUB_BTN_HOLD_MS
+  #define WAKE_STUB_BTN_HOLD_MS   60    // pulsación mínima para arrancar
+#endif
+#ifndef WAKE_STUB_VBUS_HOLD_MS
+  #define WAKE_STUB_VBUS_HOLD_MS  20    // VBUS estable para arrancar
+#endif
+
+struct WakeStubCounters {
+  uint32_t btnOk;
+  uint32_t btnRejected;
+  uint32_t vbusOk;
+  uint32_t vbusRejected;
+  uint32_t other;         // timer, ULP, reset...
+};
+
+// Copia de los contadores (escritos por el stub)
+WakeStubCounters wakeStubCounters();
+
+void wakeStubDump();
+void wakeStubReset();
+
+#endif // WAKE_STUB_H
@@ -0,0 +1,226 @@
+#include "warm_boot.h"
+#include <esp_sleep.h>
+#include <esp_attr.h>
+#include "esp_rom_crc.h"
+#include "config.h"
+#include "sensor_module.h"
+#include "logbook.h"
+#include "battery.h"
+
+// ---- forward decl. portátil del contador RTC en µs
+extern "C" uint64_t esp_rtc_get_time_us(void);
+
+// ------------------------------
+// Snapshot (RTC slow mem)
+// ------------------------------
+static constexpr uint32_t WB_MAGIC   = 0x57524D42UL;   // "WRMB"
+static constexpr uint16_t WB_VERSION = 1;
+
+struct WarmSnapshot {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;             // sizeof(WarmSnapshot): cambia con el layout
+  uint64_t savedRtcUs;       // esp_rtc_get_time_us() al guardar
+  // --- Altitud ---
+  float    refAltM;          // altitudReferencia
+  float    agzBias;
+  float    alturaOffset;
+  // --- Config ---
+  int32_t  brillo;
+  int16_t  altFormat;
+  int8_t   ahorroOption;
+  int8_t   idioma;
+  uint8_t  unidadMetros;
+  uint8_t  lbValid;
+  int8_t   batPct;           // % mostrado (-1: sin dato)
+  uint8_t  _pad;
+  char     usuario[24];
+  // --- Bitácora ---
+  LogbookHead lb;
+  uint32_t crc;              // CRC32 de todo lo anterior
+};
+
+RTC_DATA_ATTR static WarmSnapshot s_rtcSnap;
+
+static WarmSnapshot s_snap;            // copia en RAM del arranque actual
+static bool         s_warm = false;
+
+static uint32_t snapCrc(const WarmSnapshot &s) {
+  return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&s), offsetof(WarmSnapshot, crc));
+}
+
+// ------------------------------
+// Tiempo hasta el primer HUD por causa
+// ------------------------------
+enum WarmCause : uint8_t { WB_COLD = 0, WB_BUTTON, WB_VBUS, WB_TIMER, WB_ULP, WB_OTHER, WB_NCAUSES };
+static const char* const kCauseName[WB_NCAUSES] = { "frio", "boton", "vbus", "timer", "ulp", "otro" };
+
+struct WarmCauseStats {
+  uint32_t boots;
+  uint32_t warm;             // de ellos, con snapshot
+  uint32_t huds;             // arranques que llegaron al HUD
+  uint32_t lastMs;
+  uint32_t sumMs;
+  uint32_t maxMs;
+};
+RTC_DATA_ATTR static WarmCauseStats s_stats[WB_NCAUSES];
+
+static WarmCause s_cause  = WB_COLD;
+static bool      s_hudSeen = false;
+
+static WarmCause readCause() {
+  switch (esp_sleep_get_wakeup_cause()) {
+    case ESP_SLEEP_WAKEUP_UNDEFINED: return WB_COLD;
+    case ESP_SLEEP_WAKEUP_EXT1:
+      return (esp_sleep_get_ext1_wakeup_status() & (1ULL << WAKE_BTN_PIN)) ? WB_BUTTON : WB_VBUS;
+    case ESP_SLEEP_WAKEUP_TIMER:     return WB_TIMER;
+    case ESP_SLEEP_WAKEUP_ULP:       return WB_ULP;
+    default:                         return WB_OTHER;
+  }
+}
+
+// ------------------------------
+// Arranque
+// ------------------------------
+bool warmBootBegin() {
+  s_cause = readCause();
+  s_warm  = false;
+
+#if WARM_BOOT_ENABLE
+  const bool deepSleepWake = (s_cause == WB_BUTTON || s_cause == WB_VBUS ||
+                              s_cause == WB_TIMER  || s_cause == WB_ULP);
+  if (deepSleepWake &&
+      s_rtcSnap.magic == WB_MAGIC && s_rtcSnap.version == WB_VERSION &&
+      s_rtcSnap.size == sizeof(WarmSnapshot) && s_rtcSnap.crc == snapCrc(s_rtcSnap)) {
+    s_snap = s_rtcSnap;
+    s_warm = true;
+  }
+#endif
+  s_rtcSnap.magic = 0;                 // un solo uso: el próximo sueño lo reescribe
+
+  WarmCauseStats &st = s_stats[s_cause];
+  st.boots++;
+  if (s_warm) st.warm++;
+  return s_warm;
+}
+
+bool warmBootActive() { return s_warm; }
+
+void warmBootRestoreConfig() {
+  unidadMetros        = s_snap.unidadMetros != 0;
+  brilloPantalla      = s_snap.brillo;
+  altFormat           = s_snap.altFormat;
+  ahorroTimeoutOption = (s_snap.ahorroOption >= 0 && s_snap.ahorroOption < NUM_TIMEOUT_OPTIONS)
+                          ? s_snap.ahorroOption : 0;
+  ahorroTimeoutMs     = TIMEOUT_OPTIONS[ahorroTimeoutOption];
+  alturaOffset        = s_snap.alturaOffset;
+  idioma              = s_snap.idioma;
+  agzBias             = s_snap.agzBias;
+  s_snap.usuario[sizeof(s_snap.usuario) - 1] = '\0';
+  usuarioActual       = s_snap.usuario;
+}
+
+void warmBootRestoreLogbook() {
+  if (s_snap.lbValid) logbookInitWarm(s_snap.lb);
+  else                logbookInit();
+}
+
+void warmBootRestoreBattery() {
+  if (s_snap.batPct >= 0) batteryRestore(s_snap.batPct);
+}
+
+bool warmBootRestoreReference() {
+  const uint64_t now = esp_rtc_get_time_us();
+  const uint64_t ageS = (now > s_snap.savedRtcUs) ? (now - s_snap.savedRtcUs) / 1000000ULL : 0;
+  if (ageS > WARM_REF_MAX_AGE_S) {
+    Serial.printf("[WARM] referencia de hace %lus: se recalibra\n", (unsigned long)ageS);
+    return false;
+  }
+  altitudReferencia = s_snap.refAltM;
+  agzBias           = s_snap.agzBias;
+  Serial.printf("[WARM] referencia restaurada: %.1f m (AGZ=%.2f m, hace %lus)\n",
+                altitudReferencia, agzBias, (unsigned long)ageS);
+  return true;
+}
+
+// ------------------------------
+// Antes de dormir
+// ------------------------------
+void warmBootSave() {
+#if WARM_BOOT_ENABLE
+  WarmSnapshot s;
+  memset(&s, 0, sizeof(s));
+  s.magic        = WB_MAGIC;
+  s.version      = WB_VERSION;
+  s.size         = sizeof(WarmSnapshot);
+  s.savedRtcUs   = esp_rtc_get_time_us();
+  s.refAltM      = altitudReferencia;
+  s.agzBias      = agzBias;
+  s.alturaOffset = alturaOffset;
+  s.brillo       = brilloPantalla;
+  s.altFormat    = (int16_t)altFormat;
+  s.ahorroOption = (int8_t)ahorroTimeoutOption;
+  s.idioma       = (int8_t)idioma;
+  s.unidadMetros = unidadMetros ? 1 : 0;
+  s.lbValid      = logbookGetHead(s.lb) ? 1 : 0;
+  s.batPct       = (int8_t)batteryGetPercent();
+  strlcpy(s.usuario, usuarioActual.c_str(), sizeof(s.usuario));
+  s.crc          = snapCrc(s);
+  s_rtcSnap = s;
+#endif
+}
+
+bool warmBootSaved() {
+#if WARM_BOOT_ENABLE
+  return s_rtcSnap.magic == WB_MAGIC && s_rtcSnap.version == WB_VERSION &&
+         s_rtcSnap.size == sizeof(WarmSnapshot) && s_rtcSnap.crc == snapCrc(s_rtcSnap);
+#else
+  return false;
+#endif
+}
+
+void warmBootResave(bool refFresh) {
+#if WARM_BOOT_ENABLE
+  if (!s_warm) return;
+  s_snap.agzBias = agzBias;
+  s_snap.batPct  = (int8_t)batteryGetPercent();
+  if (refFresh) s_snap.savedRtcUs = esp_rtc_get_time_us();
+  s_snap.crc     = snapCrc(s_snap);
+  s_rtcSnap = s_snap;
+#endif
+}
+
+// ------------------------------
+// Medida: primer frame del HUD
+// ------------------------------
+void warmBootOnHudFrame() {
+  if (s_hudSeen) return;
+  s_hudSeen = true;
+
+  const uint32_t ms = millis();
+  WarmCauseStats &st = s_stats[s_cause];
+  st.huds++;
+  st.lastMs = ms;
+  st.sumMs += ms;
+  if (ms > st.maxMs) st.maxMs = ms;
+  Serial.printf("[WARM] primer HUD a %lu ms (%s, %s)\n", (unsigned long)ms,
+                kCauseName[s_cause], s_warm ? "caliente" : "completo");
+}
+
+void warmBootDump() {
+  Serial.printf("[WARM] arranque actual: %s, %s\n", kCauseName[s_cause],
+                s_warm ? "caliente" : "completo");
+  for (uint8_t i = 0; i < WB_NCAUSES; ++i) {
+    const WarmCauseStats &st = s_stats[i];
+    if (st.boots == 0) continue;
+    Serial.printf("[WARM] %-5s n=%lu caliente=%lu  HUD ultimo=%lu medio=%lu max=%lu ms\n",
+                  kCauseName[i], (unsigned long)st.boots, (unsigned long)st.warm,
+                  (unsigned long)st.lastMs, (unsigned long)(st.huds ? st.sumMs / st.huds : 0),
+                  (unsigned long)st.maxMs);
+  }
+}
+
+void warmBootResetStats() {
+  memset(s_stats, 0, sizeof(s_stats));
+  Serial.println("[WARM] tiempos a cero");
+}
@@ -0,0 +1,60 @@
+#ifndef WARM_BOOT_H
+#define WARM_BOOT_H
+
+// =====================================================
+// Arranque en caliente tras deep sleep (snapshot en RTC)
+// -----------------------------------------------------
+// Justo antes de dormir se guarda en RTC slow mem (versión
+// + CRC32) la referencia de altitud, el sesgo AGZ, la
+// config, la cabecera de la bitácora y el % de batería.
+// Al despertar por botón/VBUS, timer o ULP se restaura
+// todo sin NVS ni LittleFS y sin cuenta regresiva; en el
+// avión no se vuelve a poner a cero. Tras reset o corte de
+// alimentación, arranque normal.
+// La referencia sólo se restaura si el snapshot tiene
+// menos de WARM_REF_MAX_AGE_S (la presión en tierra deriva);
+// el mantenimiento por timer (ds_housekeeping) la renueva
+// mientras siga el cero en tierra.
+// Se mide el tiempo hasta el primer frame del HUD por causa
+// de despertar (desde el arranque de la app; el bootloader
+// no cuenta). 'r' por Serial: tiempos; 'R': reset.
+// =====================================================
+
+#include <Arduino.h>
+
+#ifndef WARM_BOOT_ENABLE
+  #define WARM_BOOT_ENABLE     1
+#endif
+#ifndef WARM_REF_MAX_AGE_S
+  #define WARM_REF_MAX_AGE_S   (6UL * 3600UL)
+#endif
+
+// Al principio de setup(): true si hay snapshot válido de este despertar
+bool warmBootBegin();
+bool warmBootActive();
+
+// Sustitutos de loadConfig()+loadUserConfig(), logbookInit() y
+// complemento de batteryInit(); sólo con warmBootActive()
+void warmBootRestoreConfig();
+void warmBootRestoreLogbook();
+void warmBootRestoreBattery();
+// false si la referencia es demasiado vieja (hay que recalibrar)
+bool warmBootRestoreReference();
+
+// Justo antes de esp_deep_sleep_start()
+void warmBootSave();
+// ¿Hay snapshot válido guardado para el próximo despertar?
+bool warmBootSaved();
+
+// Mantenimiento por timer: vuelve a guardar el snapshot de este
+// despertar con el agzBias y el % actuales; refFresh = referencia
+// seguida por el AGZ (cuenta como recién tomada)
+void warmBootResave(bool refFresh);
+
+// Desde el HUD en cada frame (sólo mide el primero)
+void warmBootOnHudFrame();
+
+void warmBootDump();
+void warmBootResetStats();
+
+#endif // WARM_BOOT_H
@@ -0,0 +1,184 @@
+// =====================================================
+// Detector de subida del ULP en el host (pio test -e native)
+// -----------------------------------------------------
+// climb_tick() contra un BMP390 simulado: banco de 256
+// registros; una FORCED en PWR_CTRL pone DRDY y los crudos
+// tras MOCK_CONV_MS. Modelo lineal de 1 cuenta = 1 Pa.
+// Muestras cada ULP_CLIMB_PERIOD_MS = 4 s (ulp_climb.h).
+// =====================================================
+
+#include <unity.h>
+#include <string.h>
+#include "../../ulp/ulp_climb_bus.h"
+
+// Umbrales por defecto de ulp_climb.h
+#define DROP_PA      1200
+#define CONFIRM_N    2
+#define BASE_SHIFT   8
+#define SAMPLES_H    900          // muestras por hora a 4 s
+
+#define GROUND_PA    101325
+#define UP0          8000000
+#define UT0          8400000
+#define MOCK_CONV_MS 20
+
+// ------------------------------
+// BMP390 simulado
+// ------------------------------
+static uint8_t  s_regs[256];
+static int32_t  s_convLeftMs = -1;        // -1: sin conversión en curso
+static int      s_dead       = 0;         // no llega DRDY nunca
+static int32_t  s_pa         = GROUND_PA; // presión de la próxima conversión
+static uint32_t s_reads      = 0;         // conversiones pedidas
+
+static void mockPut24(uint8_t reg, uint32_t v) {
+  s_regs[reg]     = (uint8_t)(v & 0xFF);
+  s_regs[reg + 1] = (uint8_t)((v >> 8) & 0xFF);
+  s_regs[reg + 2] = (uint8_t)((v >> 16) & 0xFF);
+}
+
+void climb_bus_write(uint8_t reg, uint8_t val) {
+  s_regs[reg] = val;
+  if (reg == BMP390_REG_PWR_CTRL && (val & BMP390_PWR_MODE_NORMAL) == BMP390_PWR_MODE_FORCED) {
+    s_regs[BMP390_REG_STATUS] = 0;
+    s_convLeftMs = s_dead ? -1 : MOCK_CONV_MS;
+    s_reads++;
+  }
+}
+
+void climb_bus_read(uint8_t reg, uint8_t *buf, uint32_t n) {
+  memcpy(buf, &s_regs[reg], n);
+}
+
+void climb_bus_delay_ms(uint32_t ms) {
+  if (s_convLeftMs < 0) return;
+  s_convLeftMs -= (int32_t)ms;
+  if (s_convLeftMs > 0) return;
+  s_convLeftMs = -1;
+  mockPut24(BMP390_REG_DATA,     (uint32_t)(UP0 + (s_pa - GROUND_PA)));
+  mockPut24(BMP390_REG_DATA + 3, (uint32_t)UT0);
+  s_regs[BMP390_REG_STATUS] = BMP390_STATUS_DRDY_P | BMP390_STATUS_DRDY_T;
+  s_regs[BMP390_REG_PWR_CTRL] &= (uint8_t)~BMP390_PWR_MODE_NORMAL;   // vuelve a SLEEP
+}
+
+// ------------------------------
+// Estado armado como lo deja ulpClimbArm()
+// ------------------------------
+static ClimbState s_st;
+
+static int tickAt(int32_t pa) {
+  s_pa = pa;
+  return climb_tick(&s_st);
+}
+
+void setUp(void) {
+  memset(s_regs, 0, sizeof(s_regs));
+  s_convLeftMs = -1;
+  s_dead       = 0;
+  s_pa         = GROUND_PA;
+  s_reads      = 0;
+
+  memset(&s_st, 0, sizeof(s_st));
+  s_st.p0_pa      = GROUND_PA;
+  s_st.up0        = UP0;
+  s_st.ut0        = UT0;
+  s_st.kp_q16     = 1 << 16;
+  s_st.kt_q16     = 0;
+  s_st.drop_pa    = DROP_PA;
+  s_st.confirm_n  = CONFIRM_N;
+  s_st.base_shift = BASE_SHIFT;
+  climb_reset(&s_st);
+}
+
+void tearDown(void) {}
+
+// ------------------------------
+// Casos
+// ------------------------------
+// El banco simulado devuelve la presión pedida
+static void test_read_raw_through_mock(void) {
+  TEST_ASSERT_EQUAL_INT(0, tickAt(GROUND_PA - 37));
+  TEST_ASSERT_EQUAL_INT32(GROUND_PA - 37, s_st.last_pa);
+  TEST_ASSERT_EQUAL_UINT32(1, s_st.samples);
+  TEST_ASSERT_EQUAL_UINT32(0, s_st.errors);
+}
+
+// Escalón sobre el umbral: despierta justo en la muestra CONFIRM_N
+static void test_step_drop_wakes_after_confirm(void) {
+  for (int i = 0; i < 20; ++i) TEST_ASSERT_EQUAL_INT(0, tickAt(GROUND_PA));
+  for (int i = 1; i < CONFIRM_N; ++i) {
+    TEST_ASSERT_EQUAL_INT(0, tickAt(GROUND_PA - DROP_PA - 100));
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)i, s_st.above);
+  }
+  TEST_ASSERT_EQUAL_INT(1, tickAt(GROUND_PA - DROP_PA - 100));
+  TEST_ASSERT_EQUAL_UINT32(1, s_st.woke);
+}
+
+// Avión a ~1000 ft/min (~60 Pa/s cerca del suelo): despierta tras
+// cruzar el umbral y confirmar, a unos 100 m sobre el suelo
+static void test_climb_rate_wakes(void) {
+  for (int i = 0; i < 20; ++i) tickAt(GROUND_PA);
+
+  const int32_t paPerSample = 60 * 4;
+  int firstOver = -1, wokeAt = -1;
+  for (int i = 1; i <= 60 && wokeAt < 0; ++i) {
+    const int32_t pa = GROUND_PA - i * paPerSample;
+    if (firstOver < 0 && climb_base_pa(&s_st) - pa >= DROP_PA) firstOver = i;
+    if (tickAt(pa)) wokeAt = i;
+  }
+  TEST_ASSERT_TRUE(firstOver > 0);
+  TEST_ASSERT_EQUAL_INT(firstOver + CONFIRM_N - 1, wokeAt);
+  TEST_ASSERT_INT32_WITHIN(DROP_PA / 2, GROUND_PA, climb_base_pa(&s_st));
+}
+
+// Frente rápido: -3 hPa/h durante 12 h. La línea base lo sigue
+static void test_weather_drift_does_not_wake(void) {
+  for (int32_t i = 0; i < 12 * SAMPLES_H; ++i) {
+    const int32_t pa = GROUND_PA - (i * 300) / SAMPLES_H;
+    TEST_ASSERT_EQUAL_INT(0, tickAt(pa));
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, s_st.woke);
+  TEST_ASSERT_TRUE(climb_base_pa(&s_st) - s_st.last_pa < DROP_PA / 4);
+}
+
+// Picos aislados (portazo, ráfaga, glitch de bus) con ruido de ±8 Pa
+static void test_single_sample_noise_does_not_wake(void) {
+  for (int i = 0; i < 2000; ++i) {
+    int32_t pa = GROUND_PA + ((i * 7) % 17) - 8;
+    if (i % 50 == 25) pa = GROUND_PA - 3 * DROP_PA;
+    TEST_ASSERT_EQUAL_INT(0, tickAt(pa));
+    if (i % 50 == 26) TEST_ASSERT_EQUAL_UINT32(0, s_st.above);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, s_st.woke);
+}
+
+// Sin DRDY: cuenta el error y no toca la línea base
+static void test_bus_timeout_counts_error(void) {
+  s_dead = 1;
+  TEST_ASSERT_EQUAL_INT(0, tickAt(GROUND_PA - 5000));
+  TEST_ASSERT_EQUAL_UINT32(1, s_st.errors);
+  TEST_ASSERT_EQUAL_UINT32(0, s_st.samples);
+  TEST_ASSERT_EQUAL_INT32(GROUND_PA, climb_base_pa(&s_st));
+}
+
+// Tras despertar no vuelve a medir (el CPU principal para el timer)
+static void test_woke_latches(void) {
+  tickAt(GROUND_PA);
+  for (int i = 0; i < CONFIRM_N; ++i) tickAt(GROUND_PA - 2 * DROP_PA);
+  TEST_ASSERT_EQUAL_UINT32(1, s_st.woke);
+  const uint32_t reads = s_reads;
+  TEST_ASSERT_EQUAL_INT(0, tickAt(GROUND_PA - 2 * DROP_PA));
+  TEST_ASSERT_EQUAL_UINT32(reads, s_reads);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_read_raw_through_mock);
+  RUN_TEST(test_step_drop_wakes_after_confirm);
+  RUN_TEST(test_climb_rate_wakes);
+  RUN_TEST(test_weather_drift_does_not_wake);
+  RUN_TEST(test_single_sample_noise_does_not_wake);
+  RUN_TEST(test_bus_timeout_counts_error);
+  RUN_TEST(test_woke_latches);
+  return UNITY_END();
+}
@@ -0,0 +1,313 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+HIL: envía muestras de presión/temperatura al altímetro por USB-CDC y
+lee las respuestas LAT (latencia muestra -> uso -> pantalla).
+
+Protocolo: src/hil_link.h (mismo en s3-tiny y c3-stable-final)
+  A5 5A | tipo u8 | len u8 | payload[len] | crc16-ccitt(tipo..payload)
+  little-endian; CRC16-CCITT 0x1021, init 0xFFFF, CRC en LE.
+
+Uso (requiere pyserial: pip install pyserial):
+  # Salto sintético: subida, caída libre, campana y tierra
+  python tools/hil_stream.py /dev/ttyACM0 --profile jump
+
+  # Perfil propio: CSV "t_s,pres_pa[,temp_c]" (cabecera opcional)
+  python tools/hil_stream.py COM5 --csv salto.csv
+
+  # Sólo medir el enlace (PING/PONG) sin entrar en HIL
+  python tools/hil_stream.py /dev/ttyACM0 --ping 20
+
+La primera muestra se manda como referencia en ENTER (0 m en el
+equipo) salvo --no-ref. Al terminar (o Ctrl-C) se envía EXIT y se
+imprime un resumen de las LAT recibidas. El firmware sale de HIL
+solo si no recibe nada en HIL_TIMEOUT_MS (3 s).
+"""
+
+import argparse
+import csv
+import struct
+import sys
+import threading
+import time
+
+try:
+    import serial  # pyserial
+except ImportError:
+    sys.exit("hil_stream: falta pyserial (pip install pyserial)")
+
+# ------------------------------
+# Protocolo
+# ------------------------------
+SYNC = b"\xA5\x5A"
+MAX_PAYLOAD = 32
+
+T_ENTER, T_EXIT, T_SAMPLE, T_PING = 0x01, 0x02, 0x03, 0x04
+T_ACK, T_LAT, T_PONG = 0x81, 0x83, 0x84
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC16-CCITT (0x1021, init 0xFFFF), igual que hil_link.cpp."""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def frame(ftype, payload=b""):
+    body = bytes((ftype, len(payload))) + payload
+    return SYNC + body + struct.pack("<H", crc16(body))
+
+
+def host_us():
+    return int(time.monotonic() * 1e6) & 0xFFFFFFFF
+
+
+class Parser:
+    """Separa tramas binarias del texto de Serial (logs del firmware)."""
+
+    def __init__(self, on_frame, on_text):
+        self.buf = bytearray()
+        self.text = bytearray()
+        self.on_frame = on_frame
+        self.on_text = on_text
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            i = self.buf.find(SYNC)
+            if i < 0:
+                # Guarda el último byte por si es el primer SYNC
+                keep = 1 if self.buf[-1:] == SYNC[:1] else 0
+                self._text(self.buf[:len(self.buf) - keep])
+                del self.buf[:len(self.buf) - keep]
+                return
+            self._text(self.buf[:i])
+            del self.buf[:i]
+            if len(self.buf) < 4:
+                return
+            ftype, n = self.buf[2], self.buf[3]
+            if n > MAX_PAYLOAD:
+                del self.buf[:2]
+                continue
+            if len(self.buf) < 6 + n:
+                return
+            body = bytes(self.buf[2:4 + n])
+            (crc_rx,) = struct.unpack_from("<H", self.buf, 4 + n)
+            if crc16(body) == crc_rx:
+                self.on_frame(ftype, body[2:])
+                del self.buf[:6 + n]
+            else:
+                del self.buf[:2]   # no era trama: resincroniza
+
+    def _text(self, data):
+        self.text += data
+        while b"\n" in self.text:
+            line, _, rest = self.text.partition(b"\n")
+            self.on_text(line.decode("utf-8", "replace").rstrip("\r"))
+            self.text = bytearray(rest)
+
+
+# ------------------------------
+# Perfiles
+# ------------------------------
+def alt_to_pa(alt_m, qnh_pa=101325.0):
+    """Inversa de sensorPressureToAltitude() (44330 / 0.1903)."""
+    return qnh_pa * (1.0 - alt_m / 44330.0) ** (1.0 / 0.1903)
+
+
+def profile_jump(hz, ground_m, exit_m, ff_mps, open_m, canopy_mps, climb_mps):
+    """Salto sintético: (t_s, pres_pa, temp_c) a hz muestras/s."""
+    dt = 1.0 / hz
+    t, alt = 0.0, ground_m
+    phases = [
+        ("tierra", 10.0, 0.0),
+        ("subida", None, climb_mps),
+        ("puerta", 5.0, 0.0),
+        ("caida", None, -ff_mps),
+        ("campana", None, -canopy_mps),
+        ("tierra", 15.0, 0.0),
+    ]
+    for name, dur, vz in phases:
+        t_end = t + dur if dur is not None else None
+        while True:
+            if t_end is not None and t >= t_end:
+                break
+            if name == "subida" and alt >= exit_m:
+                break
+            if name == "caida" and alt <= open_m:
+                break
+            if name == "campana" and alt <= ground_m:
+                alt = ground_m
+                break
+            temp_c = 15.0 - 0.0065 * alt
+            yield t, alt_to_pa(alt), temp_c
+            alt += vz * dt
+            t += dt
+
+
+def profile_csv(path):
+    with open(path, newline="") as f:
+        for row in csv.reader(f):
+            try:
+                t_s, pa = float(row[0]), float(row[1])
+            except (ValueError, IndexError):
+                continue   # cabecera o línea vacía
+            temp_c = float(row[2]) if len(row) > 2 and row[2] else 20.0
+            yield t_s, pa, temp_c
+
+
+# ------------------------------
+# Sesión
+# ------------------------------
+class Session:
+    def __init__(self, port, echo):
+        self.ser = serial.Serial(port, 115200, timeout=0.05)
+        self.echo = echo
+        self.lat = []          # (seq, rx_to_use_us, rx_to_frame_us)
+        self.last_sup = 0
+        self.last_und = 0
+        self.acks = {}
+        self.rtt = []
+        self.stop = False
+        self.parser = Parser(self._on_frame, self._on_text)
+        self.rx = threading.Thread(target=self._rx_loop, daemon=True)
+        self.rx.start()
+
+    def _rx_loop(self):
+        while not self.stop:
+            data = self.ser.read(256)
+            if data:
+                self.parser.feed(data)
+
+    def _on_text(self, line):
+        if self.echo and line:
+            print("  | " + line, file=sys.stderr)
+
+    def _on_frame(self, ftype, p):
+        if ftype == T_LAT and len(p) >= 14:
+            seq, use_us, frame_us, sup, und = struct.unpack_from("<HIIHH", p)
+            self.lat.append((seq, use_us, frame_us))
+            self.last_sup, self.last_und = sup, und
+        elif ftype == T_ACK and len(p) >= 2:
+            self.acks[p[0]] = p[1]
+        elif ftype == T_PONG and len(p) >= 8:
+            sent, _dev = struct.unpack_from("<II", p)
+            self.rtt.append((host_us() - sent) & 0xFFFFFFFF)
+
+    def send(self, ftype, payload=b""):
+        self.ser.write(frame(ftype, payload))
+
+    def wait_ack(self, ftype, timeout_s=1.0):
+        t0 = time.monotonic()
+        while time.monotonic() - t0 < timeout_s:
+            if ftype in self.acks:
+                return self.acks.pop(ftype)
+            time.sleep(0.01)
+        return None
+
+    def close(self):
+        self.stop = True
+        self.rx.join(timeout=0.5)
+        self.ser.close()
+
+
+def pct(vals, q):
+    s = sorted(vals)
+    return s[min(len(s) - 1, int(q * len(s)))] if s else 0
+
+
+def summary(sess, sent):
+    print("[HIL] enviadas=%d LAT=%d pisadas=%d sin muestra=%d"
+          % (sent, len(sess.lat), sess.last_sup, sess.last_und))
+    if sess.lat:
+        use = [u for _, u, _ in sess.lat]
+        frm = [f for _, _, f in sess.lat]
+        for name, v in (("rx->uso", use), ("rx->pantalla", frm)):
+            print("[HIL] %-13s p50=%6.2f ms p95=%6.2f ms max=%6.2f ms"
+                  % (name, pct(v, 0.5) / 1e3, pct(v, 0.95) / 1e3, max(v) / 1e3))
+    if sess.rtt:
+        print("[HIL] ping rtt    p50=%6.2f ms max=%6.2f ms"
+              % (pct(sess.rtt, 0.5) / 1e3, max(sess.rtt) / 1e3))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Streaming HIL de presión al altímetro")
+    ap.add_argument("port", help="puerto serie (p.ej. /dev/ttyACM0, COM5)")
+    src = ap.add_mutually_exclusive_group()
+    src.add_argument("--csv", help="perfil t_s,pres_pa[,temp_c]")
+    src.add_argument("--profile", choices=["jump"], default="jump")
+    ap.add_argument("--hz", type=float, default=50.0, help="muestras/s del perfil sintético")
+    ap.add_argument("--ground", type=float, default=0.0, help="m sobre QNH del suelo")
+    ap.add_argument("--exit-alt", type=float, default=4000.0, help="m de salida")
+    ap.add_argument("--open-alt", type=float, default=1000.0, help="m de apertura")
+    ap.add_argument("--ff", type=float, default=55.0, help="m/s en caída libre")
+    ap.add_argument("--canopy", type=float, default=5.0, help="m/s bajo campana")
+    ap.add_argument("--climb", type=float, default=20.0, help="m/s de subida (acelerada)")
+    ap.add_argument("--speed", type=float, default=1.0, help="factor de tiempo real")
+    ap.add_argument("--no-ref", action="store_true", help="ENTER sin referencia")
+    ap.add_argument("--ping", type=int, default=0, help="sólo N PINGs y salir")
+    ap.add_argument("--echo", action="store_true", help="muestra el texto de Serial")
+    args = ap.parse_args()
+
+    sess = Session(args.port, args.echo)
+    sent = 0
+    try:
+        if args.ping:
+            for _ in range(args.ping):
+                sess.send(T_PING, struct.pack("<I", host_us()))
+                time.sleep(0.05)
+            time.sleep(0.2)
+            summary(sess, 0)
+            return
+
+        if args.csv:
+            samples = profile_csv(args.csv)
+        else:
+            samples = profile_jump(args.hz, args.ground, args.exit_alt, args.ff,
+                                   args.open_alt, args.canopy, args.climb)
+
+        first = next(samples, None)
+        if first is None:
+            sys.exit("hil_stream: perfil vacío")
+
+        sess.send(T_ENTER, b"" if args.no_ref else struct.pack("<f", first[1]))
+        if sess.wait_ack(T_ENTER) is None:
+            sys.exit("hil_stream: sin ACK de ENTER (¿puerto/firmware correctos?)")
+
+        t0_host = time.monotonic()
+        t0_prof = first[0]
+        last_print = t0_host
+        for t_s, pa, temp_c in _chain(first, samples):
+            due = t0_host + (t_s - t0_prof) / args.speed
+            delay = due - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+            sess.send(T_SAMPLE, struct.pack("<HIff", sent & 0xFFFF, host_us(), pa, temp_c))
+            sent += 1
+            now = time.monotonic()
+            if now - last_print >= 1.0:
+                last_print = now
+                if sess.lat:
+                    _, use_us, frame_us = sess.lat[-1]
+                    print("[HIL] t=%6.1fs %8.0f Pa  uso=%5.2f ms pantalla=%5.2f ms"
+                          % (t_s - t0_prof, pa, use_us / 1e3, frame_us / 1e3))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if not args.ping:
+            sess.send(T_EXIT)
+            sess.wait_ack(T_EXIT, 0.5)
+            summary(sess, sent)
+        sess.close()
+
+
+def _chain(first, rest):
+    yield first
+    yield from rest
+
+
+if __name__ == "__main__":
+    main()
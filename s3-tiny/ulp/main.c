@@ -0,0 +1,47 @@
+// =====================================================
+// ULP RISC-V: detector de subida en deep sleep
+// -----------------------------------------------------
+// Lo arranca el temporizador del ULP cada ULP_CLIMB_PERIOD_MS
+// (ulp_climb.cpp) con los cores principales dormidos:
+//  1) FORCED P+T en el BMP390 por el I2C del RTC
+//     (SDA=GPIO3, SCL=GPIO2: los pines RTC I2C del S3),
+//  2) espera DRDY y lee los 6 bytes crudos,
+//  3) climb_step(): línea base + umbral de caída
+//     (1-3 en climb_tick(), ulp_climb_bus.h),
+//  4) si hay subida, despierta al CPU principal.
+// Todo el estado vive en 'climb' (RTC slow mem): el CPU
+// principal lo ve como ulp_climb.
+// =====================================================
+
+#include <stdint.h>
+#include "ulp_riscv.h"
+#include "ulp_riscv_utils.h"
+#include "ulp_riscv_i2c_ulp_core.h"
+#include "ulp_climb_bus.h"
+
+#define BMP_I2C_ADDR      0x77
+
+ClimbState climb;
+
+// ------------------------------
+// Bus (I2C del RTC)
+// ------------------------------
+void climb_bus_write(uint8_t reg, uint8_t val) {
+  ulp_riscv_i2c_master_set_slave_reg_addr(reg);
+  ulp_riscv_i2c_master_write_to_device(&val, 1);
+}
+
+void climb_bus_read(uint8_t reg, uint8_t *buf, uint32_t n) {
+  ulp_riscv_i2c_master_set_slave_reg_addr(reg);
+  ulp_riscv_i2c_master_read_from_device(buf, n);
+}
+
+void climb_bus_delay_ms(uint32_t ms) {
+  ulp_riscv_delay_cycles(ms * ULP_RISCV_CYCLES_PER_MS);
+}
+
+int main(void) {
+  ulp_riscv_i2c_master_set_slave_addr(BMP_I2C_ADDR);
+  if (climb_tick(&climb)) ulp_riscv_wakeup_main_processor();
+  return 0;                            // halt hasta el próximo disparo del timer
+}
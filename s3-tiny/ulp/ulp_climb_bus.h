@@ -0,0 +1,56 @@
+#ifndef ULP_CLIMB_BUS_H
+#define ULP_CLIMB_BUS_H
+
+// =====================================================
+// Muestra del ULP sobre un bus abstracto (C99)
+// -----------------------------------------------------
+// climb_read_raw() y climb_tick() sólo hablan con el BMP390
+// a través de climb_bus_*: en el ULP las implementa main.c
+// (I2C del RTC); en el host, el banco de registros simulado
+// de test/test_ulp_climb. Así los umbrales de despertar se
+// prueban sin placa (pio test -e native).
+// =====================================================
+
+#include <stdint.h>
+#include "../src/bmp390_regs.h"
+#include "ulp_climb_logic.h"
+
+#define CLIMB_DRDY_TIMEOUT_MS  60     // OSR x8 P / x1 T: ~20 ms
+
+void climb_bus_write(uint8_t reg, uint8_t val);
+void climb_bus_read(uint8_t reg, uint8_t *buf, uint32_t n);
+void climb_bus_delay_ms(uint32_t ms);
+
+// Crudos de una conversión FORCED; 0 si no llegó DRDY
+static inline int climb_read_raw(int32_t *up, int32_t *ut) {
+  climb_bus_write(BMP390_REG_PWR_CTRL, BMP390_PWR_FORCED_PT);
+
+  uint8_t st = 0;
+  for (int ms = 0; ms < CLIMB_DRDY_TIMEOUT_MS; ++ms) {
+    climb_bus_delay_ms(1);
+    climb_bus_read(BMP390_REG_STATUS, &st, 1);
+    if ((st & (BMP390_STATUS_DRDY_P | BMP390_STATUS_DRDY_T)) ==
+        (BMP390_STATUS_DRDY_P | BMP390_STATUS_DRDY_T)) {
+      uint8_t d[BMP390_DATA_LEN];
+      climb_bus_read(BMP390_REG_DATA, d, BMP390_DATA_LEN);
+      *up = (int32_t)BMP390_RAW24(&d[0]);
+      *ut = (int32_t)BMP390_RAW24(&d[3]);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Un disparo del temporizador del ULP: 1 = despertar al CPU principal
+static inline int climb_tick(ClimbState *s) {
+  if (s->woke) return 0;               // ya avisamos: el CPU principal detiene el timer
+
+  int32_t up, ut;
+  if (!climb_read_raw(&up, &ut)) {
+    s->errors++;
+    return 0;
+  }
+  return climb_step(s, up, ut);
+}
+
+#endif // ULP_CLIMB_BUS_H
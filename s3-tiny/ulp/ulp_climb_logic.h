@@ -0,0 +1,80 @@
+#ifndef ULP_CLIMB_LOGIC_H
+#define ULP_CLIMB_LOGIC_H
+
+// =====================================================
+// Detector de subida del ULP (lógica pura, C99)
+// -----------------------------------------------------
+// Sin hardware ni floats: compila igual en el ULP RISC-V,
+// en el CPU principal y en el host (con un banco de
+// registros simulado detrás de climb_bus_*, ver
+// ulp_climb_bus.h).
+//
+// Presión: modelo lineal que carga el CPU principal antes
+// de dormir (bmp390Linearize):
+//   P = p0 + (kP*(up-up0) + kT*(ut-ut0)) >> 16
+// Línea base: sube al instante (bajada / tiempo) y baja con
+// una EMA lenta (2^base_shift muestras): deriva de tiempo
+// sí, subida del avión no.
+// Despierta cuando la caída sobre la línea base supera
+// drop_pa durante confirm_n muestras seguidas.
+// =====================================================
+
+#include <stdint.h>
+
+typedef struct {
+  // --- Modelo (CPU principal) ---
+  int32_t  p0_pa;
+  int32_t  up0, ut0;
+  int32_t  kp_q16;       // Pa por cuenta cruda de presión (Q16)
+  int32_t  kt_q16;       // Pa por cuenta cruda de temperatura (Q16)
+  // --- Umbrales (CPU principal) ---
+  int32_t  drop_pa;
+  uint32_t confirm_n;
+  uint32_t base_shift;
+  // --- Estado (ULP) ---
+  int32_t  base_q4;      // línea base en Pa * 16
+  int32_t  last_pa;
+  uint32_t above;        // muestras seguidas sobre el umbral
+  uint32_t samples;
+  uint32_t errors;       // lecturas I2C fallidas
+  uint32_t woke;         // 1: ya despertó al CPU principal
+} ClimbState;
+
+static inline int32_t climb_pressure_pa(const ClimbState *s, int32_t up, int32_t ut) {
+  const int64_t d = (int64_t)s->kp_q16 * (up - s->up0) +
+                    (int64_t)s->kt_q16 * (ut - s->ut0);
+  return s->p0_pa + (int32_t)(d >> 16);
+}
+
+// Arranque del estado (CPU principal, al armar)
+static inline void climb_reset(ClimbState *s) {
+  s->base_q4 = s->p0_pa * 16;
+  s->last_pa = s->p0_pa;
+  s->above   = 0;
+  s->samples = 0;
+  s->errors  = 0;
+  s->woke    = 0;
+}
+
+// Una muestra; devuelve 1 si hay que despertar al CPU principal
+static inline int climb_step(ClimbState *s, int32_t up, int32_t ut) {
+  const int32_t p    = climb_pressure_pa(s, up, ut);
+  const int32_t p_q4 = p * 16;
+  s->last_pa = p;
+  s->samples++;
+
+  if (p_q4 >= s->base_q4) s->base_q4 = p_q4;
+  else                    s->base_q4 -= (s->base_q4 - p_q4) >> s->base_shift;
+
+  const int32_t drop = (s->base_q4 >> 4) - p;
+  if (drop >= s->drop_pa) {
+    if (++s->above >= s->confirm_n) { s->woke = 1; return 1; }
+  } else {
+    s->above = 0;
+  }
+  return 0;
+}
+
+static inline int32_t climb_base_pa(const ClimbState *s) { return s->base_q4 >> 4; }
+
+#endif // ULP_CLIMB_LOGIC_H